@@ -0,0 +1,322 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "dead_call.hpp"
+
+DeadCallTable *DeadCallTable::m_pTable = NULL;
+
+DeadCallTable *DeadCallTable::getInstance()
+{
+    try
+    {
+        if (NULL == m_pTable)
+        {
+            m_pTable = new DeadCallTable;
+        }
+    }
+    catch (std::exception &e)
+    {
+        LOG_FATAL("Memory allocation failure, DeadCallTable");
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    return m_pTable;
+}
+
+/**
+ * @brief
+ *    Constructor, the number of buckets is enough to hold the dead-calls
+ *    for the complete dead-call wait time plus the bucket being filled
+ */
+DeadCallTable::DeadCallTable()
+{
+    m_deadCallWait = Config::getInstance()->getDeadCallWait();
+    m_wakeTime     = 0;
+
+    DeadCallBucket bucket;
+    bucket.period = 0;
+    m_buckets.assign(m_deadCallWait / GSIM_DEAD_CALL_BUCKET_MS + 2, bucket);
+}
+
+DeadCallTable::~DeadCallTable()
+{
+    for (U32 i = 0; i < m_buckets.size(); i++)
+    {
+        expireBucket(&m_buckets[i]);
+    }
+
+    m_pTable = NULL;
+}
+
+/**
+ * @brief
+ *    Periodic run of dead-call table, deletes all the dead-calls from
+ *    the buckets older than dead-call wait time
+ *
+ * @param arg
+ *
+ * @return
+ */
+RETVAL DeadCallTable::run(VOID *arg)
+{
+    LOG_ENTERFN();
+
+    Time_t currTime = getMilliSeconds();
+
+    for (U32 i = 0; i < m_buckets.size(); i++)
+    {
+        DeadCallBucket *pBucket = &m_buckets[i];
+        Time_t bucketEnd = (pBucket->period + 1) * GSIM_DEAD_CALL_BUCKET_MS;
+        if (!pBucket->deadCalls.empty() &&
+            (bucketEnd + m_deadCallWait <= currTime))
+        {
+            expireBucket(pBucket);
+        }
+    }
+
+    m_wakeTime = currTime + GSIM_DEAD_CALL_BUCKET_MS;
+    pause();
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Adds a dead-call into the bucket of current time period and indexes
+ *    it by local TEID and by (peer, sequence number)
+ *
+ * @param pDeadCall
+ */
+VOID DeadCallTable::addDeadCall(DeadCall *pDeadCall)
+{
+    LOG_ENTERFN();
+
+    Time_t          period  = getMilliSeconds() / GSIM_DEAD_CALL_BUCKET_MS;
+    DeadCallBucket *pBucket = &m_buckets[period % m_buckets.size()];
+
+    if (pBucket->period != period)
+    {
+        /* bucket is reused for a new time period, any dead-call still in
+         * it has already outlived the dead-call wait time
+         */
+        expireBucket(pBucket);
+        pBucket->period = period;
+    }
+
+    pBucket->deadCalls.push_back(pDeadCall);
+
+    if (0 != pDeadCall->teid)
+    {
+        m_teidMap[pDeadCall->teid] = pDeadCall;
+    }
+
+    DeadCallKey key;
+    key.addr      = pDeadCall->peerEp.ipAddr.u.ipv4Addr.addr;
+    key.port      = pDeadCall->peerEp.port;
+    key.seqNumber = pDeadCall->seqNumber;
+    (*seqMap(pDeadCall))[key] = pDeadCall;
+
+    Stats::incStats(GSIM_STAT_NUM_DEADCALLS);
+
+    LOG_EXITVOID();
+}
+
+VOID DeadCallTable::expireBucket(DeadCallBucket *pBucket)
+{
+    LOG_ENTERFN();
+
+    for (U32 i = 0; i < pBucket->deadCalls.size(); i++)
+    {
+        DeadCall *pDeadCall = pBucket->deadCalls[i];
+
+        /* a newer dead-call may have taken over the index entry */
+        DeadCallTeidMap::iterator tItr = m_teidMap.find(pDeadCall->teid);
+        if (tItr != m_teidMap.end() && tItr->second == pDeadCall)
+        {
+            m_teidMap.erase(tItr);
+        }
+
+        DeadCallKey key;
+        key.addr      = pDeadCall->peerEp.ipAddr.u.ipv4Addr.addr;
+        key.port      = pDeadCall->peerEp.port;
+        key.seqNumber = pDeadCall->seqNumber;
+        DeadCallSeqMap          *pSeqMap = seqMap(pDeadCall);
+        DeadCallSeqMap::iterator sItr    = pSeqMap->find(key);
+        if (sItr != pSeqMap->end() && sItr->second == pDeadCall)
+        {
+            pSeqMap->erase(sItr);
+        }
+
+        delete []pDeadCall->pRsp;
+        delete pDeadCall;
+        Stats::decStats(GSIM_STAT_NUM_DEADCALLS);
+    }
+
+    pBucket->deadCalls.clear();
+
+    LOG_EXITVOID();
+}
+
+DeadCall *DeadCallTable::findDeadCall(GtpTeid_t teid)
+{
+    LOG_ENTERFN();
+
+    DeadCall *pDeadCall = NULL;
+
+    DeadCallTeidMap::iterator itr = m_teidMap.find(teid);
+    if (itr != m_teidMap.end())
+    {
+        pDeadCall = itr->second;
+    }
+
+    LOG_EXITFN(pDeadCall);
+}
+
+/**
+ * @brief
+ *    Index of the sequence number of a dead-call, the response is kept
+ *    only if the last transaction was a request received from the peer
+ *
+ * @param pDeadCall
+ *
+ * @return
+ */
+DeadCallSeqMap *DeadCallTable::seqMap(DeadCall *pDeadCall)
+{
+    return (NULL != pDeadCall->pRsp) ? &m_rcvdSeqMap : &m_sentSeqMap;
+}
+
+DeadCall *DeadCallTable::findDeadCall(
+    const IPEndPoint *ep, GtpSeqNumber_t seqNumber, BOOL rcvdReq)
+{
+    LOG_ENTERFN();
+
+    DeadCall       *pDeadCall = NULL;
+    DeadCallKey    key;
+    DeadCallSeqMap *pSeqMap   = rcvdReq ? &m_rcvdSeqMap : &m_sentSeqMap;
+
+    key.addr      = ep->ipAddr.u.ipv4Addr.addr;
+    key.port      = ep->port;
+    key.seqNumber = seqNumber;
+
+    DeadCallSeqMap::iterator itr = pSeqMap->find(key);
+    if (itr != pSeqMap->end())
+    {
+        pDeadCall = itr->second;
+    }
+
+    LOG_EXITFN(pDeadCall);
+}
+
+/**
+ * @brief
+ *    Processes a GTP-C message received for a session which is no longer
+ *    alive. A retransmitted request is answered with the stored response,
+ *    retransmitted responses and unexpected messages are only counted
+ *
+ * @param data
+ *    received message, not freed by this function
+ * @param teid
+ *    teid in the GTP header, 0 if not present
+ *
+ * @return
+ *    TRUE if the message belongs to a dead-call. Without the teid only
+ *    a message of the same type and sequence number as the last
+ *    transaction belongs to it, so that a new request reusing the
+ *    sequence number, e.g. of a restarted peer, is not taken for a
+ *    retransmission
+ */
+BOOL DeadCallTable::procRetransMsg(UdpData_t *data, GtpTeid_t teid)
+{
+    LOG_ENTERFN();
+
+    GtpMsgType_t    msgType   = GTPC_MSG_TYPE_INVALID;
+    GtpSeqNumber_t  seqNumber = 0;
+    DeadCall        *pDeadCall = NULL;
+
+    GTP_MSG_GET_TYPE(data->buf.pVal, msgType);
+    GTP_MSG_GET_SEQN(data->buf.pVal, seqNumber);
+
+    if (0 != teid)
+    {
+        pDeadCall = findDeadCall(teid);
+    }
+    else
+    {
+        /* a request is a retransmission of a request received, a
+         * response is a late response to a request sent
+         */
+        BOOL rcvdReq = (GTP_MSG_CAT_RSP != gtpGetMsgCategory(msgType));
+        pDeadCall = findDeadCall(&data->peerEp, seqNumber, rcvdReq);
+        if (NULL != pDeadCall && pDeadCall->reqType != msgType &&
+            pDeadCall->rspType != msgType)
+        {
+            pDeadCall = NULL;
+        }
+    }
+
+    if (NULL == pDeadCall)
+    {
+        LOG_EXITFN(FALSE);
+    }
+
+    Procedure *pProc = pDeadCall->pProc;
+    if (pDeadCall->reqType == msgType && pDeadCall->seqNumber == seqNumber)
+    {
+        if (NULL != pDeadCall->pRsp)
+        {
+            /* resend the request response */
+            Buffer *buf = new Buffer;
+            BUFFER_CPY(buf, pDeadCall->pRsp, pDeadCall->rspLen);
+            sendMsg(pDeadCall->connId, &pDeadCall->peerEp, buf);
+            pProc->m_trigMsg->m_numSndRetrans++;
+        }
+        pProc->m_initial->m_numRcvRetrans++;
+    }
+    else if (pDeadCall->rspType == msgType &&
+             pDeadCall->seqNumber == seqNumber)
+    {
+        pProc->m_trigMsg->m_numRcvRetrans++;
+    }
+    else
+    {
+        pProc->m_initial->m_numUnexp++;
+        Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+    }
+
+    LOG_EXITFN(TRUE);
+}
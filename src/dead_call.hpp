@@ -0,0 +1,115 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __DEAD_CALL_HPP__
+#define __DEAD_CALL_HPP__
+
+/* dead-calls are grouped into time buckets of this size, a whole bucket
+ * is expired at once
+ */
+#define GSIM_DEAD_CALL_BUCKET_MS      1000
+
+/* Tombstone of a UE session whose scenario is complete. The UE session
+ * is deleted as soon as the scenario ends, only the information needed
+ * to answer late retransmissions from the peer is kept here
+ */
+struct DeadCall
+{
+   GtpTeid_t         teid;       /* local c-plane teid of the session */
+   GtpSeqNumber_t    seqNumber;  /* sequence number of last transaction */
+   GtpMsgType_t      reqType;
+   GtpMsgType_t      rspType;
+   TransConnId       connId;
+   IPEndPoint        peerEp;
+   Procedure         *pProc;     /* last procedure, for statistics */
+   U8                *pRsp;      /* last response sent to the peer, NULL if
+                                  * the response was received from peer
+                                  */
+   U32               rspLen;
+};
+
+struct DeadCallKey
+{
+   U32               addr;
+   U16               port;
+   GtpSeqNumber_t    seqNumber;
+
+   bool operator==(const DeadCallKey &k) const
+   {
+      return (addr == k.addr && port == k.port && seqNumber == k.seqNumber);
+   }
+};
+
+struct DeadCallKeyHash
+{
+   size_t operator()(const DeadCallKey &k) const
+   {
+      U64 h = ((U64)k.addr << 32) | ((U64)k.port << 16);
+      h ^= (U64)k.seqNumber * 0x9e3779b97f4a7c15ULL;
+      return (size_t)(h ^ (h >> 29));
+   }
+};
+
+typedef std::vector<DeadCall*>                                 DeadCallVec;
+typedef std::unordered_map<GtpTeid_t, DeadCall*>               DeadCallTeidMap;
+typedef std::unordered_map<DeadCallKey, DeadCall*, DeadCallKeyHash>
+                                                               DeadCallSeqMap;
+
+struct DeadCallBucket
+{
+   Time_t            period;     /* bucket start time / bucket size */
+   DeadCallVec       deadCalls;
+};
+
+/* Time bucketed hash of dead-calls, indexed by local TEID and by
+ * (peer, sequence number). The sequence numbers of the requests received
+ * from the peer and of the requests sent to the peer are indexed apart,
+ * as both sides number their requests independently. The task wakes up
+ * once every bucket period and expires the buckets older than the
+ * dead-call wait time
+ */
+class DeadCallTable: public Task
+{
+   public:
+      static DeadCallTable* getInstance();
+      ~DeadCallTable();
+
+      RETVAL            run(VOID *arg = NULL);
+      inline Time_t     wake() { return m_wakeTime; }
+
+      VOID              addDeadCall(DeadCall *pDeadCall);
+      BOOL              procRetransMsg(UdpData_t *data, GtpTeid_t teid);
+
+   private:
+      DeadCallTable();
+
+      static DeadCallTable *m_pTable;
+
+      DeadCall*         findDeadCall(GtpTeid_t teid);
+      DeadCall*         findDeadCall(const IPEndPoint *ep,\
+                              GtpSeqNumber_t seqNumber, BOOL rcvdReq);
+      DeadCallSeqMap*   seqMap(DeadCall *pDeadCall);
+      VOID              expireBucket(DeadCallBucket *pBucket);
+
+      Time_t            m_deadCallWait;
+      Time_t            m_wakeTime;
+      DeadCallTeidMap   m_teidMap;
+      DeadCallSeqMap    m_rcvdSeqMap;  /* last request received */
+      DeadCallSeqMap    m_sentSeqMap;  /* last request sent */
+      std::vector<DeadCallBucket> m_buckets;
+};
+
+#endif
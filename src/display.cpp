@@ -20,14 +20,18 @@
 #include <exception>
 #include <list>
 #include <vector>
+#include <unordered_map>
 #include <fstream>
+using std::vector;
 
 #include "types.hpp"
 #include "error.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "logger.hpp"
 #include "timer.hpp"
 #include "task.hpp"
+#include "transport.hpp"
 #include "gtp_types.hpp"
 #include "sim_cfg.hpp"
 #include "gtp_util.hpp"
@@ -38,6 +42,11 @@
 #include "procedure.hpp"
 #include "scenario.hpp"
 #include "gtp_stats.hpp"
+#include "gtp_peer.hpp"
+#include "rate_ctrl.hpp"
+#include "tunnel.hpp"
+#include "gtpu_gen.hpp"
+#include "gtpu_sink.hpp"
 #include "display.hpp"
 
 #define COUT std::cout
@@ -66,6 +75,8 @@
             "[c]------+-------Quit [q]--------+\r\n");      \
     }
 
+#define DISP_RATE_GRAPH_ROWS 5
+
 #define PRINT_BLANK_LINE()       \
     {                            \
         fprintf(stdout, "\r\n"); \
@@ -299,6 +310,43 @@ VOID Display::disp()
     fprintf(stdout, "Session-Completed: %u\r\n", ssnSucc);
     fprintf(stdout, "Session-Aborted:   %u\r\n", ssnFail);
     fprintf(stdout, "Dead-Calls:        %u\r\n", deadCalls);
+    fprintf(stdout, "Tx-Queue:          Depth:%u Stalled-ms:%u Drops:%u\r\n",
+        getStats(GSIM_STAT_TX_QUEUE_DEPTH), getStats(GSIM_STAT_TX_STALL_MS),
+        getStats(GSIM_STAT_TX_QUEUE_DROPS));
+    printDropStats();
+    fprintf(stdout, "Sched-Idle:        %u%%%s\r\n",
+        getStats(GSIM_STAT_SCHED_IDLE_PCT),
+        Config::getInstance()->getBusyPoll() ? " (busy-poll)" : "");
+    printMemStats();
+    printLatency("Latency-Observed: ", GSIM_HIST_SSN_LATENCY);
+    printLatency("Latency-Corrected:", GSIM_HIST_SSN_LATENCY_CORRECTED);
+    printLatency("Rsp-Latency:      ", GSIM_HIST_RSP_LATENCY);
+    printLatency("Rx-Delay:         ", GSIM_HIST_RX_DELAY);
+
+    if (Config::getInstance()->getAdaptiveRate())
+    {
+        printRateGraph();
+    }
+
+    if (0 != Config::getInstance()->getGtpuRate())
+    {
+        printGtpuStats();
+    }
+
+    if (Config::getInstance()->getGtpuSink())
+    {
+        printGtpuSinkStats();
+    }
+
+    if (numRemotePeers() > 1)
+    {
+        printPeerStats();
+    }
+
+    if (numSenders() > 1)
+    {
+        printLocalEpStats();
+    }
 
     PRINT_SEPERATOR();
     if (!m_summaryOnly)
@@ -352,6 +400,241 @@ VOID Display::disp()
     fflush(stdout);
 }
 
+/**
+ * @brief
+ *    prints the session latency percentiles in milli-seconds, nothing is
+ *    printed till the first session is completed
+ */
+VOID Display::printLatency(const S8 *name, GtpHist_t type)
+{
+    Histogram *pHist = Stats::getHist(type);
+    if (0 == pHist->count())
+    {
+        return;
+    }
+
+    fprintf(stdout, "%s P50 %.3fms  P90 %.3fms  P99 %.3fms  "
+        "P99.9 %.3fms  Max %.3fms\r\n", name,
+        pHist->percentile(50) / 1000.0, pHist->percentile(90) / 1000.0,
+        pHist->percentile(99) / 1000.0, pHist->percentile(99.9) / 1000.0,
+        pHist->max() / 1000.0);
+}
+
+VOID Display::printLatencyFile(const S8 *name, GtpHist_t type)
+{
+    Histogram *pHist = Stats::getHist(type);
+    if (0 == pHist->count())
+    {
+        return;
+    }
+
+    fout << name
+         << " Count:" << pHist->count()
+         << " Min:" << pHist->min()
+         << " P50:" << pHist->percentile(50)
+         << " P90:" << pHist->percentile(90)
+         << " P99:" << pHist->percentile(99)
+         << " P999:" << pHist->percentile(99.9)
+         << " Max:" << pHist->max()
+         << std::endl;
+}
+
+/**
+ * @brief
+ *    prints the GTP-U generator counters, the packet and bit rates are
+ *    averaged over the run time
+ */
+VOID Display::printGtpuStats()
+{
+    GtpuGen *pGen    = GtpuGen::getInstance();
+    Time_t  runTime  = (getMilliSeconds() / 1000) - m_startTime;
+    U64     pkts     = pGen->pktsSent();
+    U64     bytes    = pGen->bytesSent();
+
+    if (0 == runTime)
+    {
+        runTime = 1;
+    }
+
+    fprintf(stdout, "GTP-U-Tx: Bearers %u  Packets %llu  %llu pps  %.2f Mbps"
+        "  Drops %llu\r\n", pGen->numBearers(), (unsigned long long)pkts,
+        (unsigned long long)(pkts / runTime),
+        (double)bytes * 8 / runTime / 1000000,
+        (unsigned long long)pGen->txDrops());
+}
+
+/**
+ * @brief
+ *    prints the GTP-U sink counters, the packet and bit rates are averaged
+ *    over the run time
+ */
+VOID Display::printGtpuSinkStats()
+{
+    GtpuSink *pSink   = GtpuSink::getInstance();
+    Time_t   runTime  = (getMilliSeconds() / 1000) - m_startTime;
+
+    if (0 == runTime)
+    {
+        runTime = 1;
+    }
+
+    fprintf(stdout, "GTP-U-Rx: Bearers %u  Packets %llu  %llu pps  %.2f Mbps"
+        "\r\n", pSink->numBearers(), (unsigned long long)pSink->rxPkts(),
+        (unsigned long long)(pSink->rxPkts() / runTime),
+        (double)pSink->rxBytes() * 8 / runTime / 1000000);
+    fprintf(stdout, "          Lost %llu  Dup %llu  Reorder %llu  Late %llu"
+        "  Unknown-TEID %llu\r\n", (unsigned long long)pSink->lost(),
+        (unsigned long long)pSink->dup(), (unsigned long long)pSink->reorder(),
+        (unsigned long long)pSink->late(),
+        (unsigned long long)pSink->unknownTeid());
+    printLatency("GTP-U-Latency:    ", GSIM_HIST_GTPU_LATENCY);
+}
+
+/**
+ * @brief
+ *    prints the messages lost in the simulator apart from the requests
+ *    the peer did not answer, a timeout with kernel drops may not be a
+ *    fault of the peer
+ */
+/**
+ * @brief
+ *    Memory of all the pools and tables, share on hugepages and the numa
+ *    nodes it is on
+ */
+VOID Display::printMemStats()
+{
+    U64 total    = 0;
+    U64 huge     = 0;
+    U64 nodeMask = 0;
+
+    for (U32 i = 0; i < memNumUsers(); i++)
+    {
+        MemUser_t *pUser = memGetUser(i);
+        for (U32 page = 0; page < MEM_PAGE_MAX; page++)
+        {
+            total += pUser->bytes[page];
+        }
+        huge     += pUser->bytes[MEM_PAGE_HUGE_2M];
+        huge     += pUser->bytes[MEM_PAGE_HUGE_1G];
+        nodeMask |= pUser->nodeMask;
+    }
+
+    fprintf(stdout, "Memory:            %lu MB, Hugepages:%lu%% Numa-Nodes:0x%lx"
+        "\r\n", total >> 20, total ? huge * 100 / total : 0, nodeMask);
+}
+
+VOID Display::printDropStats()
+{
+    fprintf(stdout, "Sim-Drops:         Kernel-Rx:%u Tx-Queue:%u  "
+        "Rx-Buf:%u%% (peak %u%%)  Tx-Buf:%u%% (peak %u%%)\r\n",
+        getStats(GSIM_STAT_SOCK_RX_DROPS), getStats(GSIM_STAT_TX_QUEUE_DROPS),
+        getStats(GSIM_STAT_SOCK_RX_FILL),
+        getStats(GSIM_STAT_SOCK_RX_FILL_PEAK),
+        getStats(GSIM_STAT_SOCK_TX_FILL),
+        getStats(GSIM_STAT_SOCK_TX_FILL_PEAK));
+    fprintf(stdout, "Peer-No-Answer:    Retrans:%u Timeout:%u\r\n",
+        getStats(GSIM_STAT_NUM_RETRANS), getStats(GSIM_STAT_NUM_TIMEOUTS));
+}
+
+/**
+ * @brief
+ *    prints the requests sent to each remote peer, the first
+ *    GSIM_DISP_MAX_PEERS peers are shown. The rate is the average over the
+ *    run time and the latency the average of the requests sent once
+ */
+VOID Display::printPeerStats()
+{
+    Time_t runTime = (getMilliSeconds() / 1000) - m_startTime;
+    U32    numPeers = numRemotePeers();
+
+    PRINT_SEPERATOR();
+    fprintf(stdout, "Remote-Peer                Sent      Rsp   Rate/s  "
+        "Retrans  Timeout Rejected Rsp-Latency\r\n");
+    for (U32 i = 0; i < numPeers && i < GSIM_DISP_MAX_PEERS; i++)
+    {
+        PeerData *pPeer = getRemotePeer(i);
+        fprintf(stdout, "%-22s %8u %8u %8u %8u %8u %8u %8.3fms\r\n",
+            pPeer->name, pPeer->reqSent, pPeer->rspRcvd,
+            runTime ? (U32)(pPeer->reqSent / runTime) : 0,
+            pPeer->retrans, pPeer->timeouts, pPeer->rejected,
+            pPeer->rspTimed ?
+            (double)pPeer->rspLatencySum / pPeer->rspTimed / 1000 : 0.0);
+    }
+
+    if (numPeers > GSIM_DISP_MAX_PEERS)
+    {
+        fprintf(stdout, "... %u more peers\r\n",
+            numPeers - GSIM_DISP_MAX_PEERS);
+    }
+}
+
+/**
+ * @brief
+ *    prints the GTP-C messages of each local endpoint, the first
+ *    GSIM_DISP_MAX_LOCAL_EPS endpoints are shown
+ */
+VOID Display::printLocalEpStats()
+{
+    Time_t runTime = (getMilliSeconds() / 1000) - m_startTime;
+    U32    numEps  = numSenders();
+
+    PRINT_SEPERATOR();
+    fprintf(stdout, "Local-Endpoint               Tx       Rx  Tx-Rate/s\r\n");
+    for (U32 i = 0; i < numEps && i < GSIM_DISP_MAX_LOCAL_EPS; i++)
+    {
+        LocalEpStats_t stats;
+        S8             name[GSIM_PEER_NAME_LEN];
+        getSenderStats(i, &stats);
+        convIpEpToStr(&stats.ep, name, sizeof(name));
+        fprintf(stdout, "%-22s %8u %8u %10u\r\n", name, stats.txMsgs,
+            stats.rxMsgs, runTime ? (U32)(stats.txMsgs / runTime) : 0);
+    }
+
+    if (numEps > GSIM_DISP_MAX_LOCAL_EPS)
+    {
+        fprintf(stdout, "... %u more endpoints\r\n",
+            numEps - GSIM_DISP_MAX_LOCAL_EPS);
+    }
+}
+
+/**
+ * @brief
+ *    plots the session-rate set by the rate controller in the last
+ *    intervals, one column per interval with the latest on the right
+ */
+VOID Display::printRateGraph()
+{
+    RateController *pCtrl = RateController::getInstance();
+    U32 rates[GSIM_RATE_CTRL_HIST_LEN];
+    U32 len     = pCtrl->getRateGraph(rates, GSIM_RATE_CTRL_HIST_LEN);
+    U32 maxRate = pCtrl->getMaxRate();
+
+    fprintf(stdout, "Rate-Control: %u/%u  %s  Retrans %u  No-Resources %u"
+        "\r\n", Config::getInstance()->getCallRate(), maxRate,
+        pCtrl->getReason(), getStats(GSIM_STAT_NUM_RETRANS),
+        getStats(GSIM_STAT_NUM_OVERLOAD_RSP));
+
+    for (U32 row = DISP_RATE_GRAPH_ROWS; row > 0; row--)
+    {
+        if (DISP_RATE_GRAPH_ROWS == row)
+        {
+            fprintf(stdout, "%9u |", maxRate);
+        }
+        else
+        {
+            fprintf(stdout, "          |");
+        }
+
+        for (U32 i = 0; i < len; i++)
+        {
+            U32 height = (maxRate == 0) ? 0 : \
+                (rates[i] * DISP_RATE_GRAPH_ROWS + maxRate / 2) / maxRate;
+            fputc((height >= row) ? '#' : ' ', stdout);
+        }
+        fprintf(stdout, "\r\n");
+    }
+}
+
 VOID Display::printJobFile(Job *job)
 {
     switch (job->type())
@@ -398,6 +681,108 @@ VOID Display::dispFile()
     fout << "Sessions:" << ssnCreated << " Completed:" << ssnSucc
          << " Aborted:" << ssnFail << " Dead-Calls:" << deadCalls
 	 << std::endl;
+    fout << "Tx-Queue: Depth:" << getStats(GSIM_STAT_TX_QUEUE_DEPTH)
+         << " Stall-ms:" << getStats(GSIM_STAT_TX_STALL_MS)
+         << " Drops:" << getStats(GSIM_STAT_TX_QUEUE_DROPS)
+         << std::endl;
+    fout << "Sim-Drops: Kernel-Rx:" << getStats(GSIM_STAT_SOCK_RX_DROPS)
+         << " Tx-Queue:" << getStats(GSIM_STAT_TX_QUEUE_DROPS)
+         << " Rx-Buf-Pct:" << getStats(GSIM_STAT_SOCK_RX_FILL)
+         << " Rx-Buf-Peak-Pct:" << getStats(GSIM_STAT_SOCK_RX_FILL_PEAK)
+         << " Tx-Buf-Pct:" << getStats(GSIM_STAT_SOCK_TX_FILL)
+         << " Tx-Buf-Peak-Pct:" << getStats(GSIM_STAT_SOCK_TX_FILL_PEAK)
+         << std::endl;
+    fout << "Peer-No-Answer: Retrans:" << getStats(GSIM_STAT_NUM_RETRANS)
+         << " Timeout:" << getStats(GSIM_STAT_NUM_TIMEOUTS)
+         << std::endl;
+    fout << "Sched-Idle-Pct:" << getStats(GSIM_STAT_SCHED_IDLE_PCT)
+         << " Busy-Poll:" << (Config::getInstance()->getBusyPoll() ? 1 : 0)
+         << std::endl;
+    for (U32 i = 0; i < memNumUsers(); i++)
+    {
+        MemUser_t *pUser = memGetUser(i);
+        fout << "Memory: " << pUser->name
+             << " Normal-KB:" << (pUser->bytes[MEM_PAGE_SMALL] >> 10)
+             << " Huge-2M-KB:" << (pUser->bytes[MEM_PAGE_HUGE_2M] >> 10)
+             << " Huge-1G-KB:" << (pUser->bytes[MEM_PAGE_HUGE_1G] >> 10)
+             << " Node-Mask:0x" << std::hex << pUser->nodeMask << std::dec
+             << std::endl;
+    }
+    printLatencyFile("Latency-Observed-us:", GSIM_HIST_SSN_LATENCY);
+    printLatencyFile("Latency-Corrected-us:", GSIM_HIST_SSN_LATENCY_CORRECTED);
+    printLatencyFile("Rsp-Latency-us:", GSIM_HIST_RSP_LATENCY);
+    printLatencyFile("Rx-Delay-us:", GSIM_HIST_RX_DELAY);
+
+    if (Config::getInstance()->getAdaptiveRate())
+    {
+        RateController *pCtrl = RateController::getInstance();
+        fout << "Rate-Control: Rate:" << Config::getInstance()->getCallRate()
+             << " Max:" << pCtrl->getMaxRate()
+             << " Reason:" << pCtrl->getReason()
+             << " Retrans:" << getStats(GSIM_STAT_NUM_RETRANS)
+             << " No-Resources:" << getStats(GSIM_STAT_NUM_OVERLOAD_RSP)
+             << std::endl;
+    }
+
+    if (0 != Config::getInstance()->getGtpuRate())
+    {
+        GtpuGen *pGen = GtpuGen::getInstance();
+        fout << "GTP-U-Tx: Bearers:" << pGen->numBearers()
+             << " Packets:" << pGen->pktsSent()
+             << " Bytes:" << pGen->bytesSent()
+             << " Drops:" << pGen->txDrops()
+             << std::endl;
+    }
+
+    if (Config::getInstance()->getGtpuSink())
+    {
+        GtpuSink *pSink = GtpuSink::getInstance();
+        fout << "GTP-U-Rx: Bearers:" << pSink->numBearers()
+             << " Packets:" << pSink->rxPkts()
+             << " Bytes:" << pSink->rxBytes()
+             << " Lost:" << pSink->lost()
+             << " Dup:" << pSink->dup()
+             << " Reorder:" << pSink->reorder()
+             << " Late:" << pSink->late()
+             << " Unknown-TEID:" << pSink->unknownTeid()
+             << " Malformed:" << pSink->malformed()
+             << std::endl;
+        printLatencyFile("GTP-U-Latency-us:", GSIM_HIST_GTPU_LATENCY);
+    }
+
+    if (numRemotePeers() > 1)
+    {
+        for (U32 i = 0; i < numRemotePeers(); i++)
+        {
+            PeerData *pPeer = getRemotePeer(i);
+            fout << "Remote-Peer: " << pPeer->name
+                 << " Sent:" << pPeer->reqSent
+                 << " Rsp:" << pPeer->rspRcvd
+                 << " Rate:" << (runTime ? pPeer->reqSent / runTime : 0)
+                 << " Retrans:" << pPeer->retrans
+                 << " Timeout:" << pPeer->timeouts
+                 << " Rejected:" << pPeer->rejected
+                 << " Rsp-Latency-us:" << (pPeer->rspTimed ?
+                    pPeer->rspLatencySum / pPeer->rspTimed : 0)
+                 << std::endl;
+        }
+    }
+
+    if (numSenders() > 1)
+    {
+        for (U32 i = 0; i < numSenders(); i++)
+        {
+            LocalEpStats_t stats;
+            S8             name[GSIM_PEER_NAME_LEN];
+            getSenderStats(i, &stats);
+            convIpEpToStr(&stats.ep, name, sizeof(name));
+            fout << "Local-Endpoint: " << name
+                 << " Tx:" << stats.txMsgs
+                 << " Rx:" << stats.rxMsgs
+                 << " Rate:" << (runTime ? stats.txMsgs / runTime : 0)
+                 << std::endl;
+        }
+    }
 
     if (!m_summaryOnly)
     {
@@ -17,6 +17,9 @@
 #ifndef __DISPLAY_HPP__
 #define __DISPLAY_HPP__
 
+#define GSIM_DISP_MAX_PEERS      8   /* remote peers shown on the screen */
+#define GSIM_DISP_MAX_LOCAL_EPS  8   /* local endpoints shown on the screen */
+
 class Display: virtual public Task
 {
    public:
@@ -50,6 +53,15 @@ class Display: virtual public Task
       ProcSequence      *m_procSeq;
       VOID              printJob(Job*);
       VOID              printJobFile(Job*);
+      VOID              printLatency(const S8 *name, GtpHist_t type);
+      VOID              printLatencyFile(const S8 *name, GtpHist_t type);
+      VOID              printRateGraph();
+      VOID              printGtpuStats();
+      VOID              printGtpuSinkStats();
+      VOID              printPeerStats();
+      VOID              printLocalEpStats();
+      VOID              printDropStats();
+      VOID              printMemStats();
       std::string       m_ifTypeStr;
       DisplayTargetEn   m_dispTgt;
       std::string       m_dispTgtFile;
@@ -43,6 +43,7 @@ typedef enum {
     ERR_SYS_SOCKET_CREATE,
     ERR_SYS_SOCK_READ,
     ERR_SYS_SOCK_SEND,
+    ERR_SYS_SOCK_SEND_AGAIN, // socket send buffer full
     ERR_SYS_SOCK_CNTRL,
     ERR_PDN_CREATION,
     ERR_CTUN_CREATION,
@@ -16,11 +16,13 @@
 
 #include <list>
 #include <string>
+#include <new>
 
 #include "types.hpp"
 #include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 
 #include "pugixml.hpp"
 using namespace pugi;
@@ -34,12 +36,64 @@ using namespace std;
 #include "gtp_if.hpp"
 #include "gtp_ie.hpp"
 
-BOOL gtpIeDict[GTP_IE_MAX] = \
+#define GTP_IE_POOL_MIN_OBJ_SIZE   32
+#define GTP_IE_NUM_POOLS           5    /* 32 to 512 bytes */
+
+static MemPool s_ieMemPool[GTP_IE_NUM_POOLS] = \
 {
-   TRUE,
-   FALSE
+   MemPool("gtp-ie", GTP_IE_POOL_MIN_OBJ_SIZE),
+   MemPool("gtp-ie", GTP_IE_POOL_MIN_OBJ_SIZE << 1),
+   MemPool("gtp-ie", GTP_IE_POOL_MIN_OBJ_SIZE << 2),
+   MemPool("gtp-ie", GTP_IE_POOL_MIN_OBJ_SIZE << 3),
+   MemPool("gtp-ie", GTP_IE_POOL_MIN_OBJ_SIZE << 4)
 };
 
+/**
+ * @brief returns the pool of the smallest size class that fits an IE
+ *    object of len bytes, GTP_IE_NUM_POOLS if the object is too large to
+ *    be pooled
+ */
+static inline U32 gtpIePoolIndx(size_t len)
+{
+   U32 indx = 0;
+   while (indx < GTP_IE_NUM_POOLS &&
+         (size_t)(GTP_IE_POOL_MIN_OBJ_SIZE << indx) < len)
+   {
+      indx++;
+   }
+
+   return indx;
+}
+
+VOID *GtpIe::operator new(size_t len)
+{
+   U32 indx = gtpIePoolIndx(len);
+   if (indx >= GTP_IE_NUM_POOLS)
+   {
+      return ::operator new(len);
+   }
+
+   VOID *p = s_ieMemPool[indx].alloc();
+   if (NULL == p)
+   {
+      throw std::bad_alloc();
+   }
+
+   return p;
+}
+
+VOID GtpIe::operator delete(VOID *p, size_t len)
+{
+   U32 indx = gtpIePoolIndx(len);
+   if (indx >= GTP_IE_NUM_POOLS)
+   {
+      ::operator delete(p);
+      return;
+   }
+
+   s_ieMemPool[indx].free(p);
+}
+
 /**
  * @brief Helper function used by derived IE objects to encode the IE
  *    into byte buffer
@@ -133,193 +187,157 @@ RETVAL GtpIe::buildIeHelper(const HexString *inbuf, U8 *outbuf,\
 
 
 
+template <class T>
+static GtpIe* gtpNewIe(GtpInstance_t instance)
+{
+   return new T(instance);
+}
+
+typedef GtpIe* (*GtpIeCreateFn)(GtpInstance_t);
+
+typedef struct
+{
+   GtpIeType_t    ieType;
+   GtpLength_t    maxLen;
+   GtpIeCreateFn  create;
+} GtpIeInfo;
+
+#define GTP_IE_INFO(_cls) {(GtpIeType_t)_cls::TYPE, _cls::MAX_LEN, gtpNewIe<_cls>}
+
+/* Catalog of the supported IEs, createGtpIe() builds its per type lookup
+ * table from this list, to support a new IE add its class to gtp_ie.hpp
+ * and an entry here
+ */
+static const GtpIeInfo s_gtpIeCatalog[] = \
+{
+   GTP_IE_INFO(GtpImsi),
+   GTP_IE_INFO(GtpCause),
+   GTP_IE_INFO(GtpRecovery),
+   GTP_IE_INFO(GtpStnSr),
+   GTP_IE_INFO(GtpApn),
+   GTP_IE_INFO(GtpAmbr),
+   GTP_IE_INFO(GtpEbi),
+   GTP_IE_INFO(GtpIpAddress),
+   GTP_IE_INFO(GtpMei),
+   GTP_IE_INFO(GtpMsisdn),
+   GTP_IE_INFO(GtpIndication),
+   GTP_IE_INFO(GtpPco),
+   GTP_IE_INFO(GtpPaa),
+   GTP_IE_INFO(GtpBearerQos),
+   GTP_IE_INFO(GtpFlowQos),
+   GTP_IE_INFO(GtpRatType),
+   GTP_IE_INFO(GtpServingNw),
+   GTP_IE_INFO(GtpEpsBearerTft),
+   GTP_IE_INFO(GtpTad),
+   GTP_IE_INFO(GtpUli),
+   GTP_IE_INFO(GtpFteid),
+   GTP_IE_INFO(GtpTmsi),
+   GTP_IE_INFO(GtpGlobalCnId),
+   GTP_IE_INFO(GtpS103Pdf),
+   GTP_IE_INFO(GtpS1uDf),
+   GTP_IE_INFO(GtpDelayValue),
+   GTP_IE_INFO(GtpBearerContext),
+   GTP_IE_INFO(GtpChargingId),
+   GTP_IE_INFO(GtpChargingCharcs),
+   GTP_IE_INFO(GtpTraceInfo),
+   GTP_IE_INFO(GtpBearerFlags),
+   GTP_IE_INFO(GtpPdnType),
+   GTP_IE_INFO(GtpPti),
+   GTP_IE_INFO(GtpDrxParam),
+   GTP_IE_INFO(GtpUeNetworkCap),
+   GTP_IE_INFO(GtpMmCntxtGsmKeyAndTriplets),
+   GTP_IE_INFO(GtpMmCntxtUmtsKeyUsedCipherAndQuint),
+   GTP_IE_INFO(GtpMmCntxtGsmKeyUsedCipherAndQuint),
+   GTP_IE_INFO(GtpMmCntxtUmtsKeyAndQuint),
+   GTP_IE_INFO(GtpMmCntxtEpcSecCntxtQuadrAndQuint),
+   GTP_IE_INFO(GtpMmCntxtUmtsKeyQuadrAndQuint),
+   GTP_IE_INFO(GtpPdnConnection),
+   GTP_IE_INFO(GtpPduNumbers),
+   GTP_IE_INFO(GtpPtmsi),
+   GTP_IE_INFO(GtpPtmsiSignature),
+   GTP_IE_INFO(GtpHopCounter),
+   GTP_IE_INFO(GtpUeTimeZone),
+   GTP_IE_INFO(GtpTraceReference),
+   GTP_IE_INFO(GtpCompleteReqMsg),
+   GTP_IE_INFO(GtpGuti),
+   GTP_IE_INFO(GtpFContainer),
+   GTP_IE_INFO(GtpFCause),
+   GTP_IE_INFO(GtpSelectedPlmnId),
+   GTP_IE_INFO(GtpTargetId),
+   GTP_IE_INFO(GtpPacketFlowId),
+   GTP_IE_INFO(GtpRabCntxt),
+   GTP_IE_INFO(GtpSourceRncPdcpCntxtInfo),
+   GTP_IE_INFO(GtpUdpSrcPort),
+   GTP_IE_INFO(GtpApnRestriction),
+   GTP_IE_INFO(GtpSelectionMode),
+   GTP_IE_INFO(GtpSrcId),
+   GTP_IE_INFO(GtpChangeReportingAction),
+   GTP_IE_INFO(GtpFqCsid),
+   GTP_IE_INFO(GtpChannelNeeded),
+   GTP_IE_INFO(GtpEmlppPriority),
+   GTP_IE_INFO(GtpNodeType),
+   GTP_IE_INFO(GtpFqdn),
+   GTP_IE_INFO(GtpTi),
+   GTP_IE_INFO(GtpMbmsSessionDuration),
+   GTP_IE_INFO(GtpMbmsServiceArea),
+   GTP_IE_INFO(GtpMbmsSessionId),
+   GTP_IE_INFO(GtpMbmsFlowId),
+   GTP_IE_INFO(GtpMbmsIpMulticastDistribution),
+   GTP_IE_INFO(GtpMbmsDistributionAck),
+   GTP_IE_INFO(GtpRfspIndex),
+   GTP_IE_INFO(GtpUci),
+   GTP_IE_INFO(GtpCsgInfoReportingAction),
+   GTP_IE_INFO(GtpCsgId),
+   GTP_IE_INFO(GtpCmi),
+   GTP_IE_INFO(GtpServiceIndicator),
+   GTP_IE_INFO(GtpDetachType),
+   GTP_IE_INFO(GtpLdn),
+   GTP_IE_INFO(GtpMbmsTimeToDataTransfer),
+   GTP_IE_INFO(GtpTmgi),
+   GTP_IE_INFO(GtpAdditionalMmCntxtForSrvcc),
+   GTP_IE_INFO(GtpAdditionalFlagsForSrvcc),
+};
+
+class GtpIeFactory
+{
+   public:
+      GtpIeFactory()
+      {
+         MEMSET(m_create, 0, sizeof(m_create));
+         for (U32 i = 0; i < sizeof(s_gtpIeCatalog) / sizeof(GtpIeInfo); i++)
+         {
+            m_create[s_gtpIeCatalog[i].ieType] = s_gtpIeCatalog[i].create;
+         }
+      }
+
+      GtpIe* create(GtpIeType_t ieType, GtpInstance_t instance) const
+      {
+         if (ieType >= GTP_IE_MAX || NULL == m_create[ieType])
+         {
+            return NULL;
+         }
+
+         return m_create[ieType](instance);
+      }
+
+   private:
+      GtpIeCreateFn  m_create[GTP_IE_MAX];
+};
+
 /**
  * @brief Factor Method to create GTP IE
  *
  * @param ieType
  * @param instance
  *
- * @return 
+ * @return
+ *    IE object, NULL if the IE type is not supported
  */
 GtpIe* GtpIe::createGtpIe(GtpIeType_t  ieType, GtpInstance_t instance)
 {
-   switch (ieType)
-   {
-      case GTP_IE_IMSI:
-         return new GtpImsi(instance);
-      case GTP_IE_CAUSE:
-         return new GtpCause(instance);
-      case GTP_IE_RECOVERY:
-         return new GtpRecovery(instance);
-      case GTP_IE_STN_SR:
-         return new GtpStnSr(instance);
-      case GTP_IE_APN:
-         return new GtpApn(instance);
-      case GTP_IE_AMBR:
-         return new GtpAmbr(instance);
-      case GTP_IE_EBI:
-         return new GtpEbi(instance);
-      case GTP_IE_IP_ADDR:
-         return new GtpIpAddress(instance);
-      case GTP_IE_MEI:
-         return new GtpMei(instance);
-      case GTP_IE_MSISDN:
-         return new GtpMsisdn(instance);
-      case GTP_IE_INDICATION:
-         return new GtpIndication(instance);
-      case GTP_IE_PCO:
-         return new GtpPco(instance);
-      case GTP_IE_PAA:
-         return new GtpPaa(instance);
-      case GTP_IE_BEARER_QOS:
-         return new GtpBearerQos(instance);
-      case GTP_IE_FLOW_QOS:
-         return new GtpFlowQos(instance);
-      case GTP_IE_RAT_TYPE:
-         return new GtpRatType(instance);
-      case GTP_IE_SERVING_NW:
-         return new GtpServingNw(instance);
-      case GTP_IE_EPS_BEARER_TFT:
-         return new GtpEpsBearerTft(instance);
-      case GTP_IE_TAD:
-         return new GtpTad(instance);
-      case GTP_IE_ULI:
-         return new GtpUli(instance);
-      case GTP_IE_FTEID:
-         return new GtpFteid(instance);
-      case GTP_IE_TMSI:
-         return new GtpTmsi(instance);
-      case GTP_IE_GLOBAL_CN_ID:
-         return new GtpGlobalCnId(instance);
-      case GTP_IE_S103_PDF:
-         return new GtpS103Pdf(instance);
-      case GTP_IE_S1UDF:
-         return new GtpS1uDf(instance);
-      case GTP_IE_DELAY_VALUE:
-         return new GtpDelayValue(instance);
-      case GTP_IE_BEARER_CNTXT:
-         return new GtpBearerContext(instance);
-      case GTP_IE_CHARGING_ID:
-         return new GtpChargingId(instance);
-      case GTP_IE_CHARGING_CHARACTERISTICS:
-         return new GtpChargingCharcs(instance);
-      case GTP_IE_TRACE_INFO:
-         return new GtpTraceInfo(instance);
-      case GTP_IE_BEARER_FLAGS:
-         return new GtpBearerFlags(instance);
-      case GTP_IE_PDN_TYPE:
-         return new GtpPdnType(instance);
-      case GTP_IE_PTI:
-         return new GtpPti(instance);
-      case GTP_IE_DRX_PARAM:
-         return new GtpDrxParam(instance);
-      case GTP_IE_UE_NETWORK_CAP:
-         return new GtpUeNetworkCap(instance);
-      case GTP_IE_MM_CNTXT_GSM_KEY_N_TRIPLETS:
-         return new GtpMmCntxtGsmKeyAndTriplets(instance);
-      case GTP_IE_MM_CNTXT_UMTS_KEY_USED_CIPHER_N_QUINT:
-         return new GtpMmCntxtUmtsKeyUsedCipherAndQuint(instance);
-      case GTP_IE_MM_CNTXT_GSM_KEY_USED_CIPHER_N_QUINT:
-         return new GtpMmCntxtGsmKeyUsedCipherAndQuint(instance);
-      case GTP_IE_MM_CNTXT_UMTS_KEY_N_QUINT:
-         return new GtpMmCntxtUmtsKeyAndQuint(instance);
-      case GTP_IE_MM_CNTXT_EPS_SEC_CNTXT_QUADR_N_QUINT:
-         return new GtpMmCntxtEpcSecCntxtQuadrAndQuint(instance);
-      case GTP_IE_MM_CNTXT_UMTS_KEY_QUADR_N_QUINT:
-         return new GtpMmCntxtUmtsKeyQuadrAndQuint(instance);
-      case GTP_IE_PDN_CONNECTION:
-         return new GtpPdnConnection(instance);
-      case GTP_IE_PDU_NUMBERS:
-         return new GtpPduNumbers(instance);
-      case GTP_IE_PTMSI:
-         return new GtpPtmsi(instance);
-      case GTP_IE_PTMSI_SIGNATURE:
-         return new GtpPtmsiSignature(instance);
-      case GTP_IE_HOP_COUNTER:
-         return new GtpHopCounter(instance);
-      case GTP_IE_UE_TIME_ZONE:
-         return new GtpUeTimeZone(instance);
-      case GTP_IE_TRACE_REFERENCE:
-         return new GtpTraceReference(instance);
-      case GTP_IE_COMPLETE_REQ_MSG:
-         return new GtpCompleteReqMsg(instance);
-      case GTP_IE_GUTI:
-         return new GtpGuti(instance);
-      case GTP_IE_FCONTAINER:
-         return new GtpFContainer(instance);
-      case GTP_IE_FCAUSE:
-         return new GtpFCause(instance);
-      case GTP_IE_SELECTED_PLMN_ID:
-         return new GtpSelectedPlmnId(instance);
-      case GTP_IE_TARGET_ID:
-         return new GtpTargetId(instance);
-      case GTP_IE_PACKET_FLOW_ID:
-         return new GtpPacketFlowId(instance);
-      case GTP_IE_RAB_CNTXT:
-         return new GtpRabCntxt(instance);
-      case GTP_IE_SOURCE_RNC_PDCP_CNTXT_INFO:
-         return new GtpSourceRncPdcpCntxtInfo(instance);
-      case GTP_IE_UDP_SRC_PORT:
-         return new GtpUdpSrcPort(instance);
-      case GTP_IE_APN_RESTRICTION:
-         return new GtpApnRestriction(instance);
-      case GTP_IE_SELECTION_MODE:
-         return new GtpSelectionMode(instance);
-      case GTP_IE_SRC_ID:
-         return new GtpSrcId(instance);
-      case GTP_IE_CHANGE_REPORTING_ACTION:
-         return new GtpChangeReportingAction(instance);
-      case GTP_IE_FQ_CSID:
-         return new GtpFqCsid(instance);
-      case GTP_IE_CHANNEL_NEEDED:
-         return new GtpChannelNeeded(instance);
-      case GTP_IE_EMLPP_PRIORITY:
-         return new GtpEmlppPriority(instance);
-      case GTP_IE_NODE_TYPE:
-         return new GtpNodeType(instance);
-      case GTP_IE_FQDN:
-         return new GtpFqdn(instance);
-      case GTP_IE_TI:
-         return new GtpTi(instance);
-      case GTP_IE_MBMS_SESSION_DURATION:
-         return new GtpMbmsSessionDuration(instance);
-      case GTP_IE_MBMS_SERVICE_AREA:
-         return new GtpMbmsServiceArea(instance);
-      case GTP_IE_MBMS_SESSION_ID:
-         return new GtpMbmsSessionId(instance);
-      case GTP_IE_MBMS_FLOW_ID:
-         return new GtpMbmsFlowId(instance);
-      case GTP_IE_MBMS_IP_MULTICAST_DISTRIBUTION:
-         return new GtpMbmsIpMulticastDistribution(instance);
-      case GTP_IE_MBMS_DISTRIBUTION_ACK:
-         return new GtpMbmsDistributionAck(instance);
-      case GTP_IE_RFSP_INDEX:
-         return new GtpRfspIndex(instance);
-      case GTP_IE_UCI:
-         return new GtpUci(instance);
-      case GTP_IE_CSG_INFO_REPORTING_ACTION:
-         return new GtpCsgInfoReportingAction(instance);
-      case GTP_IE_CSG_ID:
-         return new GtpCsgId(instance);
-      case GTP_IE_CMI:
-         return new GtpCmi(instance);
-      case GTP_IE_SERVICE_INDICATOR:
-         return new GtpServiceIndicator(instance);
-      case GTP_IE_DETACH_TYPE:
-         return new GtpDetachType(instance);
-      case GTP_IE_LDN:
-         return new GtpLdn(instance);
-      case GTP_IE_MBMS_TIME_TO_DATA_TRANSFER:
-         return new GtpMbmsTimeToDataTransfer(instance);
-      case GTP_IE_TMGI:
-         return new GtpTmgi(instance);
-      case GTP_IE_ADDITIONAL_MM_CNTXT_FOR_SRVCC:
-         return new GtpAdditionalMmCntxtForSrvcc(instance);
-      case GTP_IE_ADDITIONAL_FLAGS_FOR_SRVCC:
-         return new GtpAdditionalFlagsForSrvcc(instance);
-      default:
-         return NULL;
-   }
+   static const GtpIeFactory factory;
+
+   return factory.create(ieType, instance);
 }
 
 /**
@@ -349,7 +367,7 @@ RETVAL GtpImsi::buildIe(const S8 *pVal)
    }
 
    /* Enocde even number of digits into hex buffer */
-   for (indx = 0; indx < (imsiStrLen - 1); indx += 2)
+   for (indx = 0; (indx + 1) < imsiStrLen; indx += 2)
    {
       m_val[len++] = GSIM_CHAR_TO_DIGIT(pVal[indx]) | \
             GSIM_CHAR_TO_DIGIT(pVal[indx + 1]) << 4;
@@ -403,7 +421,7 @@ RETVAL GtpMsisdn::buildIe(const S8 *pVal)
    }
 
    /* Enocde even number of digits into hex buffer */
-   for (indx = 0; indx < (msisdnStrLen - 1); indx += 2)
+   for (indx = 0; (indx + 1) < msisdnStrLen; indx += 2)
    {
       m_val[len++] = GSIM_CHAR_TO_DIGIT(pVal[indx]) | \
             GSIM_CHAR_TO_DIGIT(pVal[indx + 1]) << 4;
@@ -509,6 +527,29 @@ VOID GtpBearerContext::setGtpuTeid(GtpTeid_t teid, GtpInstance_t inst)
    LOG_EXITVOID();
 }
 
+/**
+ * @brief
+ *    Decodes the teid of F-TEID ie of given instance
+ *
+ * @return
+ *    FALSE if the F-TEID ie is not present
+ */
+BOOL GtpBearerContext::getGtpuTeid(GtpTeid_t *pTeid, GtpInstance_t inst)
+{
+   LOG_ENTERFN();
+
+   U8 *pBuf = getIeBufPtr(m_val, this->m_hdr.len, GTP_IE_FTEID, inst, 1);
+   if (NULL == pBuf)
+   {
+      LOG_EXITFN(FALSE);
+   }
+
+   pBuf += GTP_IE_HDR_LEN + 1;
+   GTP_DEC_TEID(pBuf, *pTeid);
+
+   LOG_EXITFN(TRUE);
+}
+
 GtpEbi_t GtpBearerContext::getEbi()
 {
    LOG_ENTERFN();
@@ -657,7 +698,7 @@ RETVAL GtpEbi::buildIe(const S8 *pVal)
 {
    LOG_ENTERFN();
    
-   m_val = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
    this->m_hdr.len = STRLEN(pVal);
 
    LOG_EXITFN(ROK);
@@ -738,7 +779,7 @@ RETVAL GtpMei::buildIe(const S8 *pVal)
    }
 
    /* Enocde even number of digits into hex buffer */
-   for (indx = 0; indx < (meiStrLen - 1); indx += 2)
+   for (indx = 0; (indx + 1) < meiStrLen; indx += 2)
    {
       m_val[len++] = GSIM_CHAR_TO_DIGIT(pVal[indx]) | \
             GSIM_CHAR_TO_DIGIT(pVal[indx + 1]) << 4;
@@ -767,7 +808,7 @@ RETVAL GtpRatType::buildIe(const S8 *pVal)
 {
    LOG_ENTERFN();
    
-   m_val = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
    this->m_hdr.len = STRLEN(pVal);
 
    LOG_EXITFN(ROK);
@@ -980,15 +1021,15 @@ RETVAL GtpPdnType::buildIe(const S8 *pVal)
 
    if (!STRCASECMP(pVal, "ipv4"))
    {
-      m_val = (U8)GTP_PDN_TYPE_IPV4;
+      m_val[0] = (U8)GTP_PDN_TYPE_IPV4;
    }
    else if (!STRCASECMP(pVal, "ipv6"))
    {
-      m_val = (U8)GTP_PDN_TYPE_IPV6;
+      m_val[0] = (U8)GTP_PDN_TYPE_IPV6;
    }
    else if (!STRCASECMP(pVal, "ipv4v6"))
    {
-      m_val = (U8)GTP_PDN_TYPE_IPV4V6;
+      m_val[0] = (U8)GTP_PDN_TYPE_IPV4V6;
    }
    else
    {
@@ -1344,7 +1385,7 @@ RETVAL GtpRecovery::buildIe(const S8 *value)
 {
    LOG_ENTERFN();
 
-   m_val = (GtpRecovery_t)gtpConvStrToU32((const S8*)value, STRLEN(value));
+   m_val[0] = (GtpRecovery_t)gtpConvStrToU32((const S8*)value, STRLEN(value));
    this->m_hdr.len = STRLEN(value);;
    LOG_EXITFN(ROK);
 }
@@ -1571,7 +1612,7 @@ RETVAL GtpDelayValue::buildIe(const S8 *pVal)
 {
    LOG_ENTERFN();
    
-   m_val = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
    this->m_hdr.len = STRLEN(pVal);
 
    LOG_EXITFN(ROK);
@@ -1677,7 +1718,7 @@ RETVAL GtpPti::buildIe(const S8 *value)
 {
    LOG_ENTERFN();
    
-   m_val = (U8)gtpConvStrToU32((const S8*)value, STRLEN(value));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)value, STRLEN(value));
    this->m_hdr.len = STRLEN(value);
 
    LOG_EXITFN(ROK);
@@ -1694,7 +1735,7 @@ RETVAL GtpHopCounter::buildIe(const S8 *pVal)
 {
    LOG_ENTERFN();
    
-   m_val = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
    this->m_hdr.len = STRLEN(pVal);
 
    LOG_EXITFN(ROK);
@@ -1711,7 +1752,7 @@ RETVAL GtpSelectionMode::buildIe(const S8 *pVal)
 {
    LOG_ENTERFN();
 
-   m_val = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
+   m_val[0] = (U8)gtpConvStrToU32((const S8*)pVal, STRLEN(pVal));
    this->m_hdr.len = STRLEN(pVal);
 
    LOG_EXITFN(ROK);
@@ -53,6 +53,10 @@ class GtpIe
 
       virtual ~GtpIe() {};
 
+      /* IEs are allocated from pools of a few size classes */
+      static VOID *operator new(size_t len);
+      static VOID operator delete(VOID *p, size_t len);
+
       // the factory method returns Gtp IE instance
       static GtpIe*  createGtpIe(GtpIeType_t ieType, GtpInstance_t instance);
 
@@ -83,4 +87,65 @@ class GtpIe
 
 };
 
+/* Common base of the IEs, the IE type, the size of the IE contents and
+ * whether the IE is grouped are compile time constants of each IE class.
+ * The contents are kept inline in the IE object, so an IE takes a single
+ * allocation and the plain IEs need no code of their own
+ */
+template <GtpIeType_t IeType, GtpLength_t MaxLen, BOOL Grouped = FALSE>
+class GtpIeT : public GtpIe
+{
+   public:
+      enum
+      {
+         TYPE    = IeType,
+         MAX_LEN = MaxLen
+      };
+
+      GtpIeT(GtpInstance_t inst)
+      {
+         m_hdr.ieType   = IeType;
+         m_hdr.instance = inst;
+         m_hdr.len      = 0;
+      }
+
+      RETVAL buildIe(const S8 *pVal)
+      {
+         return ROK;
+      }
+
+      RETVAL buildIe(const HexString *value)
+      {
+         return buildIeHelper(value, m_val, MaxLen);
+      }
+
+      RETVAL buildIe(IeParamLst *pBuf)
+      {
+         return ROK;
+      }
+
+      RETVAL buildIe(const GtpIeLst *pIeLst)
+      {
+         return ROK;
+      }
+
+      GtpLength_t encode(U8 *outbuf)
+      {
+         return encodeHelper(m_val, outbuf);
+      }
+
+      GtpLength_t decode(const U8 *inbuf)
+      {
+         return decodeHelper(inbuf, m_val, MaxLen);
+      }
+
+      BOOL isGroupedIe()
+      {
+         return Grouped;
+      }
+
+   protected:
+      U8 m_val[MaxLen];
+};
+
 #endif
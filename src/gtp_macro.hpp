@@ -275,6 +275,25 @@ do                                                 \
    GSIM_ENC_U32(_buf, _v);                         \
 } while (0);
 
-#define GTP_SET_SEQN_MSB(_v)  ((_v) |= (1 << 15))
+/* 24 bit sequence number, the MSB is set for commands and the requests
+ * triggered by commands, so the requests are numbered in 23 bits
+ */
+#define GTP_SEQN_MASK         0x00FFFFFF
+#define GTP_SEQN_MSB          0x00800000
+#define GTP_SEQN_REQ_MASK     0x007FFFFF
+#define GTP_SEQN_REQ_HALF     0x00400000
+#define GTP_SET_SEQN_MSB(_v)  ((_v) |= GTP_SEQN_MSB)
+
+/* serial number arithmetic (RFC 1982) in the 23 bit request sequence
+ * space, the command MSB is ignored. _a is older than _b if _b is ahead
+ * of _a by less than half the space
+ */
+#define GTP_SEQN_DIFF(_a, _b)                                        \
+   ((((_b) & GTP_SEQN_REQ_MASK) - ((_a) & GTP_SEQN_REQ_MASK)) &      \
+    GTP_SEQN_REQ_MASK)
+#define GTP_SEQN_LT(_a, _b)                                          \
+   ((0 != GTP_SEQN_DIFF(_a, _b)) &&                                  \
+    (GTP_SEQN_DIFF(_a, _b) < GTP_SEQN_REQ_HALF))
+#define GTP_SEQN_GT(_a, _b)   GTP_SEQN_LT(_b, _a)
 
 #define GTP_BEARER_INDEX(_v)  ((_v) - 5)
@@ -118,10 +118,9 @@ RETVAL GtpMsg::setSenderFteid(GtpTeid_t teid, const IpAddr *pIp)
 
    RETVAL   ret = ROK;
 
-   GtpIe *pGtpIe = getIe(GTP_IE_FTEID, 0, 1);
-   if (NULL != pGtpIe)
+   GtpFteid *pFteid = getIe<GtpFteid>(0, 1);
+   if (NULL != pFteid)
    {
-      GtpFteid *pFteid = dynamic_cast<GtpFteid *>(pGtpIe);
       pFteid->setTeid(teid);
       pFteid->setIpAddr(pIp);
    }
@@ -220,9 +219,19 @@ RETVAL GtpMsg::decode()
          updateBearerCount(ieInst);
       }
 
+      U32 ieLen = 0;
       GtpIe *pIe = GtpIe::createGtpIe(ieType, ieInst);
-      U32 ieLen = pIe->decode(pMsgBuf);
-      m_ieLst.push_back(pIe);
+      if (NULL != pIe)
+      {
+         ieLen = pIe->decode(pMsgBuf);
+         m_ieLst.push_back(pIe);
+      }
+      else
+      {
+         /* unknown IEs are skipped, TS 29.274 7.7.6 */
+         GTP_GET_IE_LEN(pMsgBuf, ieLen);
+         ieLen += GTP_IE_HDR_LEN;
+      }
 
       pMsgBuf += ieLen;
       len -= ieLen;
@@ -390,8 +399,7 @@ VOID GtpMsg::setImsi(GtpImsiKey *pImsiKey)
 {
    LOG_ENTERFN();
 
-   GtpIe    *pGtpIe = getIe(GTP_IE_IMSI, 0, 1);
-   GtpImsi  *pImsi = dynamic_cast<GtpImsi *>(pGtpIe);
+   GtpImsi  *pImsi = getIe<GtpImsi>(0, 1);
 
    pImsi->setImsi(pImsiKey);
 
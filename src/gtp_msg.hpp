@@ -34,6 +34,12 @@ class GtpMsg
       VOID              setMsgHdr(const GtpMsgHdr* pHdr);
       RETVAL            setSenderFteid(GtpTeid_t teid, const IpAddr *pIp);
       GtpIe*            getIe(GtpIeType_t, GtpInstance_t, U32);
+      template <class T>
+      T*                getIe(GtpInstance_t inst, U32 occurance)
+      {
+         /* the IE type determines the IE class, see createGtpIe() */
+         return static_cast<T *>(getIe((GtpIeType_t)T::TYPE, inst, occurance));
+      }
       U32               getIeCount(GtpIeType_t ieType, GtpInstance_t inst);
       U8*               getIeBufPtr(GtpIeType_t, GtpInstance_t, U32);
       GtpSeqNumber_t    seqNumber() {return m_msgHdr.seqN;}
@@ -15,11 +15,16 @@
  */  
 
 #include <vector>
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
 using std::vector;
 
 #include "types.hpp"
+#include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "timer.hpp"
 #include "gtp_types.hpp"
 #include "gtp_util.hpp"
@@ -28,56 +33,101 @@ using std::vector;
 #include "gtp_if.hpp"
 #include "gtp_ie.hpp"
 #include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
 #include "gtp_peer.hpp"
 
-static PeerDataVec g_peerData;
+static PeerDataVec         g_peerData;
 
-PUBLIC BOOL isOldReq(PeerData *peer, Buffer *gtpMsg)
-{
-   LOG_ENTERFN();
+/* open addressing hash of the peers by endpoint, the peer index + 1 is
+ * kept in a slot, 0 for an empty slot
+ */
+static std::vector<U32>    s_peerHash;
+
+/* remote peers the sessions are sent to, the first s_numRemotePeers of
+ * the peer table. s_peerSched has the peer indices in the order they are
+ * selected, one entry per unit of weight
+ */
+static U32                 s_numRemotePeers = 0;
+static BOOL                s_remotePeersInit = FALSE;
+static std::vector<U32>    s_peerSched;
+static U32                 s_peerSchedIndx = 0;
+static PeerSelectEn        s_peerSelect = PEER_SELECT_RR;
+
+typedef std::pair<double, U32>   PeerPass;
 
-   BOOL              isOld     = FALSE;
-   GtpSeqNumber_t    seqNumber = 0;
+PRIVATE U32 hashPeerEp(const IPEndPoint *ep)
+{
+   U64 h = ep->port;
 
-   GTP_MSG_GET_SEQN(gtpMsg->pVal, seqNumber);
-   if (peer->seqNumber > seqNumber)
+   if (IP_ADDR_TYPE_V6 == ep->ipAddr.ipAddrType)
    {
-      isOld = TRUE;
+      for (U32 i = 0; i < IPV6_ADDR_MAX_LEN; i++)
+      {
+         h = (h ^ ep->ipAddr.u.ipv6Addr.addr[i]) * 0x100000001b3ULL;
+      }
+   }
+   else
+   {
+      h ^= (U64)ep->ipAddr.u.ipv4Addr.addr << 16;
    }
 
-   LOG_EXITFN(isOld);
+   h *= 0x9e3779b97f4a7c15ULL;
+   return (U32)(h >> 32);
 }
 
-PRIVATE PeerData *findPeer(IPEndPoint *ep)
+PRIVATE BOOL isSamePeerEp(const IPEndPoint *a, const IPEndPoint *b)
 {
-   LOG_ENTERFN();
+   if (a->port != b->port || a->ipAddr.ipAddrType != b->ipAddr.ipAddrType)
+   {
+      return FALSE;
+   }
 
-   PeerData *peerData = NULL;
+   if (IP_ADDR_TYPE_V6 == a->ipAddr.ipAddrType)
+   {
+      return (0 == MEMCMP(a->ipAddr.u.ipv6Addr.addr,
+               b->ipAddr.u.ipv6Addr.addr, IPV6_ADDR_MAX_LEN));
+   }
 
-   for (U32 i = 0; i < g_peerData.size(); i++)
+   return (a->ipAddr.u.ipv4Addr.addr == b->ipAddr.u.ipv4Addr.addr);
+}
+
+PRIVATE VOID hashPeer(U32 indx)
+{
+   U32 mask = s_peerHash.size() - 1;
+   U32 slot = hashPeerEp(&g_peerData[indx]->peerEp) & mask;
+
+   while (0 != s_peerHash[slot])
    {
-      peerData = g_peerData[i];
-      if ((peerData->peerEp.ipAddr.u.ipv4Addr.addr == \
-         ep->ipAddr.u.ipv4Addr.addr) &&(peerData->peerEp.port == ep->port))
-      {
-         break;
-      }
+      slot = (slot + 1) & mask;
    }
 
-   LOG_EXITFN(peerData);
+   s_peerHash[slot] = indx + 1;
 }
 
-VOID updatePeerSeqNumber(IPEndPoint *ep, GtpSeqNumber_t seqNumber)
+PeerData *findPeer(const IPEndPoint *ep)
 {
    LOG_ENTERFN();
 
-   PeerData *peerData = findPeer(ep);
-   if (NULL != peerData && (seqNumber > peerData->seqNumber))
+   PeerData *peerData = NULL;
+
+   if (!s_peerHash.empty())
    {
-      peerData->seqNumber = seqNumber;
+      U32 mask = s_peerHash.size() - 1;
+      U32 slot = hashPeerEp(ep) & mask;
+
+      while (0 != s_peerHash[slot])
+      {
+         PeerData *peer = g_peerData[s_peerHash[slot] - 1];
+         if (isSamePeerEp(&peer->peerEp, ep))
+         {
+            peerData = peer;
+            break;
+         }
+         slot = (slot + 1) & mask;
+      }
    }
 
-   LOG_EXITVOID();
+   LOG_EXITFN(peerData);
 }
 
 PeerData *addPeerData(IPEndPoint ep)
@@ -92,36 +142,223 @@ PeerData *addPeerData(IPEndPoint ep)
 
    peerData = new PeerData;
    peerData->peerEp = ep;
+   peerData->indx = g_peerData.size();
    peerData->seqNumber = 0;
+   peerData->reqSent = 0;
+   peerData->rspRcvd = 0;
+   peerData->retrans = 0;
+   peerData->timeouts = 0;
+   peerData->rejected = 0;
+   peerData->rspTimed = 0;
+   peerData->rspLatencySum = 0;
+
+   convIpEpToStr(&ep, peerData->name, sizeof(peerData->name));
+
    g_peerData.push_back(peerData);
 
+   /* at most half full, the size is a power of 2 */
+   if (2 * g_peerData.size() > s_peerHash.size())
+   {
+      s_peerHash.assign(std::max<size_t>(16, 4 * s_peerHash.size()), 0);
+      for (U32 i = 0; i < g_peerData.size(); i++)
+      {
+         hashPeer(i);
+      }
+   }
+   else
+   {
+      hashPeer(peerData->indx);
+   }
+
    return peerData;
 }
 
 /**
  * @brief Generates a new sequence number for the sending a request
- *    to the peer
+ *    to the peer, the sequence numbers wrap around in 23 bits
  *
  * @param peer
  *
  * @return 
  */
-PUBLIC GtpSeqNumber_t generateSeqNum(IPEndPoint *ep, GtpMsgCategory_t cat)
+PUBLIC GtpSeqNumber_t generateSeqNum(PeerData *peer, GtpMsgCategory_t cat)
 {
    LOG_ENTERFN();
 
-   PeerData *peer = findPeer(ep);
-   GtpSeqNumber_t seqNumber = ++(peer->seqNumber);
+   peer->seqNumber = (peer->seqNumber + 1) & GTP_SEQN_REQ_MASK;
+   GtpSeqNumber_t seqNumber = peer->seqNumber;
    if (GTP_MSG_CAT_CMD == cat)
       GTP_SET_SEQN_MSB(seqNumber);
 
    LOG_EXITFN(seqNumber);
 }
 
+/**
+ * @brief
+ *    adds a request sent to the peer, so that the response is matched to
+ *    the session by the sequence number. A transaction left over from
+ *    the same sequence number before wrap around is replaced
+ *
+ * @param ep
+ * @param seqNumber
+ * @param pUeSession
+ */
+PUBLIC VOID addPeerTxn(PeerData *peer, GtpSeqNumber_t seqNumber,
+      UeSession *pUeSession)
+{
+   peer->txns[seqNumber] = pUeSession;
+}
+
+PUBLIC VOID delPeerTxn(PeerData *peer, GtpSeqNumber_t seqNumber,
+      UeSession *pUeSession)
+{
+   PeerTxnMapItr itr = peer->txns.find(seqNumber);
+   if (itr != peer->txns.end() && itr->second == pUeSession)
+   {
+      peer->txns.erase(itr);
+   }
+}
+
+PUBLIC UeSession *findPeerTxn(const IPEndPoint *ep, GtpSeqNumber_t seqNumber)
+{
+   PeerData *peer = findPeer(ep);
+   if (NULL == peer)
+   {
+      return NULL;
+   }
+
+   PeerTxnMapItr itr = peer->txns.find(seqNumber);
+   if (itr == peer->txns.end())
+   {
+      return NULL;
+   }
+
+   return itr->second;
+}
+
+/**
+ * @brief
+ *    Adds the remote peers of the configuration to the peer table, and
+ *    orders them for the selection of the peer of a new session by
+ *    weight, so that the sessions of a peer are spread evenly between
+ *    the sessions of the others
+ */
+PUBLIC VOID initRemotePeers()
+{
+   LOG_ENTERFN();
+
+   std::vector<RemotePeerCfg> peers = Config::getInstance()->getRemotePeers();
+   std::priority_queue<PeerPass, std::vector<PeerPass>,
+      std::greater<PeerPass> > passes;
+   U32                        total = 0;
+
+   s_peerSelect = Config::getInstance()->getPeerSelect();
+   for (U32 i = 0; i < peers.size(); i++)
+   {
+      if (g_peerData.size() != i)
+      {
+         throw GsimError("Remote peers must be added before other peers");
+      }
+
+      if (NULL != findPeer(&peers[i].ep))
+      {
+         throw GsimError("Duplicate remote peer");
+      }
+
+      addPeerData(peers[i].ep);
+      if (PEER_SELECT_RR == s_peerSelect)
+      {
+         peers[i].weight = 1;
+      }
+
+      total += peers[i].weight;
+      passes.push(PeerPass(0.5 / peers[i].weight, i));
+   }
+
+   /* stride scheduling, a peer of weight w is taken every 1/w */
+   s_peerSched.clear();
+   s_peerSched.reserve(total);
+   for (U32 n = 0; n < total; n++)
+   {
+      PeerPass pass = passes.top();
+      passes.pop();
+
+      s_peerSched.push_back(pass.second);
+      pass.first += 1.0 / peers[pass.second].weight;
+      passes.push(pass);
+   }
+
+   s_numRemotePeers  = peers.size();
+   s_remotePeersInit = TRUE;
+
+   LOG_EXITVOID();
+}
+
+PUBLIC U32 numRemotePeers()
+{
+   return s_numRemotePeers;
+}
+
+PUBLIC PeerData *getRemotePeer(U32 indx)
+{
+   if (!s_remotePeersInit)
+   {
+      initRemotePeers();
+   }
+
+   return g_peerData[indx];
+}
+
+/**
+ * @brief
+ *    Selects the remote peer of a new session. With imsi-hash the same
+ *    IMSI is always sent to the same peer
+ *
+ * @param pImsi
+ *    TBCD encoded IMSI
+ * @param imsiLen
+ *
+ * @return
+ */
+PUBLIC PeerData *selectRemotePeer(const U8 *pImsi, U32 imsiLen)
+{
+   if (!s_remotePeersInit)
+   {
+      initRemotePeers();
+   }
+
+   U32 indx = 0;
+   if (PEER_SELECT_IMSI_HASH == s_peerSelect)
+   {
+      U64 h = 0xcbf29ce484222325ULL;
+      for (U32 i = 0; i < imsiLen; i++)
+      {
+         h = (h ^ pImsi[i]) * 0x100000001b3ULL;
+      }
+      h = (h ^ (h >> 29)) * 0x9e3779b97f4a7c15ULL;
+      indx = (U32)((h >> 32) % s_peerSched.size());
+   }
+   else
+   {
+      indx = s_peerSchedIndx;
+      s_peerSchedIndx = (s_peerSchedIndx + 1 == s_peerSched.size()) ? \
+         0 : s_peerSchedIndx + 1;
+   }
+
+   return g_peerData[s_peerSched[indx]];
+}
+
 PUBLIC VOID deletePeerTable()
 {
    for (U32 i = 0; i < g_peerData.size(); i++)
    {
       delete g_peerData[i];
    }
+
+   g_peerData.clear();
+   s_peerHash.clear();
+   s_peerSched.clear();
+   s_peerSchedIndx   = 0;
+   s_numRemotePeers  = 0;
+   s_remotePeersInit = FALSE;
 }
@@ -15,19 +15,50 @@
  */
 
 #ifndef __GTP_PEER__
-#define __GTP_PEER_
+#define __GTP_PEER__
+
+class UeSession;
+
+/* requests sent to the peer waiting for the response, by sequence number */
+typedef std::unordered_map<GtpSeqNumber_t, UeSession*,
+      std::hash<GtpSeqNumber_t>, std::equal_to<GtpSeqNumber_t>,
+      MemAllocator<std::pair<const GtpSeqNumber_t, UeSession*> > >
+                                                            PeerTxnMap;
+typedef PeerTxnMap::iterator                                PeerTxnMapItr;
+
+#define GSIM_PEER_NAME_LEN    56   /* [IPv6 address]:port */
 
 typedef struct
 {
    IPEndPoint        peerEp;
-   GtpSeqNumber_t    seqNumber;
+   U32               indx;           /* in the peer table */
+   GtpSeqNumber_t    seqNumber;      /* last request sent */
+   PeerTxnMap        txns;
+   S8                name[GSIM_PEER_NAME_LEN];
+
+   /* requests sent to the peer */
+   Counter           reqSent;
+   Counter           rspRcvd;
+   Counter           retrans;
+   Counter           timeouts;
+   Counter           rejected;       /* cause other than accepted */
+   Counter           rspTimed;       /* responses to requests sent once */
+   U64               rspLatencySum;  /* micro seconds, of rspTimed */
 } PeerData;
 
 typedef vector<PeerData*> PeerDataVec;
 
-PUBLIC BOOL isOldReq(PeerData *peer, Buffer *gtpMsg);
 PeerData *addPeerData(IPEndPoint ep);
-VOID updatePeerSeqNumber(IPEndPoint *ep, GtpSeqNumber_t seqNumber);
-PUBLIC GtpSeqNumber_t generateSeqNum(IPEndPoint *peer, GtpMsgCategory_t cat);
+PeerData *findPeer(const IPEndPoint *ep);
+PUBLIC GtpSeqNumber_t generateSeqNum(PeerData *peer, GtpMsgCategory_t cat);
+PUBLIC VOID addPeerTxn(PeerData *peer, GtpSeqNumber_t seqNumber,
+      UeSession *pUeSession);
+PUBLIC VOID delPeerTxn(PeerData *peer, GtpSeqNumber_t seqNumber,
+      UeSession *pUeSession);
+PUBLIC UeSession *findPeerTxn(const IPEndPoint *ep, GtpSeqNumber_t seqNumber);
+PUBLIC VOID initRemotePeers();
+PUBLIC U32 numRemotePeers();
+PUBLIC PeerData *getRemotePeer(U32 indx);
+PUBLIC PeerData *selectRemotePeer(const U8 *pImsi, U32 imsiLen);
 PUBLIC VOID deletePeerTable();
 #endif
@@ -63,6 +63,7 @@ do \
 
 // GTP Statistics counters
 static Counter  s_gsimStats[GSIM_STAT_MAX];
+static Histogram s_gsimHist[GSIM_HIST_MAX];
 static Stats   *s_pStats = NULL;
 
 /**
@@ -141,5 +142,122 @@ VOID Stats::decStats(GtpStat_t statsType)
    --s_gsimStats[statsType];
 }
 
+VOID Stats::addStats(GtpStat_t statsType, Counter val)
+{
+   s_gsimStats[statsType] += val;
+}
+
+VOID Stats::setStats(GtpStat_t statsType, Counter val)
+{
+   s_gsimStats[statsType] = val;
+}
+
+VOID Stats::recordLatency(GtpHist_t histType, U64 val)
+{
+   s_gsimHist[histType].record(val);
+}
+
+Histogram* Stats::getHist(GtpHist_t histType)
+{
+   return &s_gsimHist[histType];
+}
+
+Histogram::Histogram()
+{
+   reset();
+}
+
+VOID Histogram::reset()
+{
+   MEMSET(m_buckets, 0, sizeof(m_buckets));
+   m_count = 0;
+   m_sum   = 0;
+   m_min   = 0;
+   m_max   = 0;
+}
+
+/**
+ * @brief
+ *    values below GSIM_HIST_SUB_BUCKETS have a bucket of their own, for
+ *    larger values the bucket is given by the position of the most
+ *    significant bit and the next GSIM_HIST_SUB_BITS bits
+ */
+U32 Histogram::bucketIndex(U64 val)
+{
+   if (val < GSIM_HIST_SUB_BUCKETS)
+   {
+      return (U32)val;
+   }
+
+   U32 msb   = 63 - __builtin_clzll(val);
+   U32 shift = msb - GSIM_HIST_SUB_BITS;
+
+   return ((shift + 1) << GSIM_HIST_SUB_BITS) + \
+      (U32)((val >> shift) & (GSIM_HIST_SUB_BUCKETS - 1));
+}
+
+/**
+ * @brief
+ *    returns the mid value of the range of values in a bucket
+ */
+U64 Histogram::bucketValue(U32 indx)
+{
+   if (indx < GSIM_HIST_SUB_BUCKETS)
+   {
+      return indx;
+   }
+
+   U32 shift = (indx >> GSIM_HIST_SUB_BITS) - 1;
+   U64 sub   = GSIM_HIST_SUB_BUCKETS + (indx & (GSIM_HIST_SUB_BUCKETS - 1));
+
+   return (sub << shift) + ((1ULL << shift) >> 1);
+}
+
+VOID Histogram::record(U64 val)
+{
+   m_buckets[bucketIndex(val)]++;
 
+   if (0 == m_count || val < m_min)
+   {
+      m_min = val;
+   }
+
+   if (val > m_max)
+   {
+      m_max = val;
+   }
+
+   m_count++;
+   m_sum += val;
+}
 
+/**
+ * @brief
+ *    returns the value at the percentile pct (0 - 100)
+ */
+U64 Histogram::percentile(double pct)
+{
+   if (0 == m_count)
+   {
+      return 0;
+   }
+
+   U64 rank = (U64)((pct / 100.0) * m_count + 0.5);
+   if (rank < 1)
+   {
+      rank = 1;
+   }
+
+   U64 cumulative = 0;
+   for (U32 i = 0; i < GSIM_HIST_NUM_BUCKETS; i++)
+   {
+      cumulative += m_buckets[i];
+      if (cumulative >= rank)
+      {
+         U64 val = bucketValue(i);
+         return (val > m_max) ? m_max : ((val < m_min) ? m_min : val);
+      }
+   }
+
+   return m_max;
+}
@@ -35,10 +35,71 @@ typedef enum
    GSIM_STAT_NUM_SESSIONS_FAIL,
    GSIM_STAT_UNEXCEPTED_MSG_RECD,
    GSIM_STAT_NUM_DEADCALLS,
+   GSIM_STAT_NUM_RETRANS,           /* requests retransmitted on T3 expiry */
+   GSIM_STAT_NUM_OVERLOAD_RSP,      /* responses rejected for no resources */
+   GSIM_STAT_TX_QUEUE_DEPTH,        /* messages parked on a full socket */
+   GSIM_STAT_TX_QUEUE_DROPS,        /* messages dropped, queue full */
+   GSIM_STAT_TX_STALL_MS,           /* time the sockets were not writable */
+   GSIM_STAT_NUM_TIMEOUTS,          /* requests not answered after n3 */
+   GSIM_STAT_SOCK_RX_DROPS,         /* datagrams dropped by the kernel */
+   GSIM_STAT_SOCK_RX_FILL,          /* receive buffer use, percent */
+   GSIM_STAT_SOCK_RX_FILL_PEAK,
+   GSIM_STAT_SOCK_TX_FILL,          /* send buffer use, percent */
+   GSIM_STAT_SOCK_TX_FILL_PEAK,
+   GSIM_STAT_SCHED_IDLE_PCT,        /* scheduler idle time, last second */
 
    GSIM_STAT_MAX
 } GtpStat_t;
 
+/**
+ * Latency histograms, values in micro-seconds
+ */
+typedef enum
+{
+   GSIM_HIST_SSN_LATENCY,           /* from actual session start */
+   GSIM_HIST_SSN_LATENCY_CORRECTED, /* from intended session start */
+   GSIM_HIST_SSN_LATENCY_INTVL,     /* corrected, reset every interval */
+   GSIM_HIST_GTPU_LATENCY,          /* one-way latency of G-PDUs */
+   GSIM_HIST_RSP_LATENCY,           /* request sent to response received */
+   GSIM_HIST_RX_DELAY,              /* kernel receive to processing */
+
+   GSIM_HIST_MAX
+} GtpHist_t;
+
+#define GSIM_HIST_SUB_BITS       4
+#define GSIM_HIST_SUB_BUCKETS    (1 << GSIM_HIST_SUB_BITS)
+#define GSIM_HIST_NUM_BUCKETS    ((64 - GSIM_HIST_SUB_BITS + 1) * \
+                                  GSIM_HIST_SUB_BUCKETS)
+
+/**
+ * Log-linear histogram, each power of two range of values is split into
+ * GSIM_HIST_SUB_BUCKETS linear buckets. Recording is a constant time
+ * operation and the relative error of a percentile is within 1/16
+ */
+class Histogram
+{
+   public:
+      Histogram();
+
+      VOID     record(U64 val);
+      VOID     reset();
+      U64      percentile(double pct);
+      U64      count() { return m_count; }
+      U64      min() { return m_min; }
+      U64      max() { return m_max; }
+      U64      mean() { return (m_count ? m_sum / m_count : 0); }
+
+   private:
+      U32      bucketIndex(U64 val);
+      U64      bucketValue(U32 indx);
+
+      U64      m_buckets[GSIM_HIST_NUM_BUCKETS];
+      U64      m_count;
+      U64      m_sum;
+      U64      m_min;
+      U64      m_max;
+};
+
 /**
  * Statistics Class
  * Singleton instance of this class is created 
@@ -51,12 +112,20 @@ class Stats
 
    void static incStats(GtpStat_t   statType);
    void static decStats(GtpStat_t   statType);
+   void static addStats(GtpStat_t   statType, Counter val);
+   void static setStats(GtpStat_t   statType, Counter val);
 
    /**
     * Get the GTP statistics counter values
     */
    Counter static getStats(GtpStat_t statType);
 
+   /**
+    * Latency histograms
+    */
+   void static recordLatency(GtpHist_t histType, U64 val);
+   Histogram static *getHist(GtpHist_t histType);
+
    /**
     * Destructor
     */
@@ -51,6 +51,14 @@ typedef U8  GtpEbi_t;
 typedef U8  GtpArp_t;
 typedef U8  GtpQci_t;
 typedef U8  GtpCause_t;
+
+/* cause values of a node rejecting requests due to overload */
+#define GTP_CAUSE_NO_RESOURCES_AVAILABLE     73
+#define GTP_CAUSE_APN_CONGESTION             113
+
+/* request accepted causes, the rest from 64 are rejections */
+#define GTP_CAUSE_REQUEST_ACCEPTED           16
+#define GTP_CAUSE_REJECTION_MIN              64
 typedef U8  GtpRecovery_t;
 
 typedef enum {
@@ -925,6 +925,31 @@ IpAddr convIpStrToIpAddr(const S8* pIp, U32 len)
    LOG_EXITFN(ipAddr);
 }
 
+/**
+ * @brief
+ *    Formats an endpoint as ip:port, or [ip]:port for IPv6
+ *
+ * @param pEp
+ * @param pStr
+ * @param len
+ */
+VOID convIpEpToStr(const IPEndPoint *pEp, S8 *pStr, U32 len)
+{
+   S8 addr[INET6_ADDRSTRLEN] = {'\0'};
+
+   if (IP_ADDR_TYPE_V6 == pEp->ipAddr.ipAddrType)
+   {
+      inet_ntop(AF_INET6, pEp->ipAddr.u.ipv6Addr.addr, addr, sizeof(addr));
+      snprintf(pStr, len, "[%s]:%u", addr, pEp->port);
+   }
+   else
+   {
+      U32 ipv4 = htonl(pEp->ipAddr.u.ipv4Addr.addr);
+      inet_ntop(AF_INET, &ipv4, addr, sizeof(addr));
+      snprintf(pStr, len, "%s:%u", addr, pEp->port);
+   }
+}
+
 VOID decIeHdr(U8 *pBuf, GtpIeHdr *pHdr)
 {
    LOG_ENTERFN();
@@ -1030,6 +1055,53 @@ PUBLIC U8* getImsiBufPtr(Buffer *pGtpcBuf)
    LOG_EXITFN(pImsi);
 }
 
+/**
+ * @brief
+ *    finds an IE in a buffer of encoded IEs, i.e. the IEs of a GTP message
+ *    following the header, or the IEs within a grouped IE
+ *
+ * @param pBuf
+ *    buffer of encoded IEs
+ * @param len
+ *    length of the buffer
+ * @param ieType
+ * @param inst
+ * @param occr
+ *    occurrence of the IE with same type and instance, starts at 1
+ *
+ * @return
+ *    pointer to the IE header, NULL if the IE is not present
+ */
+PUBLIC U8* gtpFindIe(U8 *pBuf, U32 len, GtpIeType_t ieType,\
+      GtpInstance_t inst, U32 occr)
+{
+   LOG_ENTERFN();
+
+   U8          *pIe = NULL;
+   GtpIeHdr    ieHdr;
+
+   while (len >= GTP_IE_HDR_LEN)
+   {
+      decIeHdr(pBuf, &ieHdr);
+      if ((U32)(ieHdr.len + GTP_IE_HDR_LEN) > len)
+      {
+         /* truncated IE */
+         break;
+      }
+
+      if (ieHdr.ieType == ieType && ieHdr.instance == inst && 0 == --occr)
+      {
+         pIe = pBuf;
+         break;
+      }
+
+      len -= (ieHdr.len + GTP_IE_HDR_LEN);
+      pBuf += (ieHdr.len + GTP_IE_HDR_LEN);
+   }
+
+   LOG_EXITFN(pIe);
+}
+
 /**
  * @brief encodes PLMN ID into buffer based on encoding PLMN ID encoding
  *        in 23.003
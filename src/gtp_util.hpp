@@ -38,10 +38,13 @@ GtpLength_t      gtpConvStrToHex(const HexString *value, U8 *pDst);
 EXTERN U32  gtpConvStrToU32(const S8 *pVal, U32 len);
 GtpIfType_t gtpConvStrToIfType(const S8 *pVal, U32 len);
 IpAddr      convIpStrToIpAddr(const S8 *pIp, U32 len);
+VOID        convIpEpToStr(const IPEndPoint *pEp, S8 *pStr, U32 len);
 VOID        decIeHdr(U8 *pBuf, GtpIeHdr *pHdr);
 U32         encodeImsi(S8 *pImsiStr, U32 imsiStrLen, U8 *pBuf);
 EXTERN VOID numericStrIncriment(S8 *pStr, U32 len);
 PUBLIC U8 *getImsiBufPtr(Buffer *pGtpcBuf);
+PUBLIC U8 *gtpFindIe(U8 *pBuf, U32 len, GtpIeType_t ieType,
+                     GtpInstance_t inst, U32 occr);
 EXTERN VOID gtpUtlEncPlmnId(GtpPlmnId_t *pPlmnId, U8 *pBuf);
 PUBLIC S8 *gtpGetIeName(GtpIeType_t ieType);
 PUBLIC U8 gtpCharToHex(U8 c);
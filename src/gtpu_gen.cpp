@@ -0,0 +1,586 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "sim_cfg.hpp"
+#include "keyboard.hpp"
+#include "tunnel.hpp"
+#include "packet_ring.hpp"
+#include "gtpu_gen.hpp"
+
+/* simple IMIX, 7:4:1 of 64, 576 and 1500 byte packets, interleaved */
+static const U32 s_imixPattern[GSIM_GTPU_IMIX_LEN] = 
+    {64, 576, 64, 64, 576, 64, 1500, 64, 576, 64, 64, 576};
+
+/* padding of all the packets, never modified */
+static U8        s_gtpuPad[DFLT_GTPU_MAX_PKT_SIZE] = {0};
+
+GtpuGen *GtpuGen::m_pGen = NULL;
+
+GtpuGen *GtpuGen::getInstance()
+{
+    try
+    {
+        if (NULL == m_pGen)
+        {
+            m_pGen = new GtpuGen;
+        }
+    }
+    catch (std::exception &e)
+    {
+        LOG_FATAL("Memory allocation failure, GtpuGen");
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    return m_pGen;
+}
+
+GtpuGen::GtpuGen()
+{
+    Config *pCfg = Config::getInstance();
+
+    m_rate          = pCfg->getGtpuRate();
+    m_flows         = pCfg->getGtpuFlows();
+    m_connId        = getGtpuConnId();
+    m_peerEp.ipAddr = pCfg->getGtpuRemoteIpAddr();
+    m_peerEp.port   = pCfg->getGtpuRemotePort();
+    m_nextTmpl      = 0;
+    m_nextBearer    = 0;
+    m_wakeTime      = 0;
+    m_lastRunTime   = getMicroSeconds();
+    m_credit        = 0;
+    m_pktsSent      = 0;
+    m_bytesSent     = 0;
+    m_txDrops       = 0;
+
+    U32 pktSize = pCfg->getGtpuPktSize();
+    if (DFLT_GTPU_PKT_SIZE_IMIX == pktSize)
+    {
+        m_numTmpl = GSIM_GTPU_IMIX_LEN;
+        for (U32 i = 0; i < m_numTmpl; i++)
+        {
+            buildTemplate(&m_tmpl[i], s_imixPattern[i]);
+        }
+    }
+    else
+    {
+        m_numTmpl = 1;
+        buildTemplate(&m_tmpl[0], pktSize);
+    }
+
+    m_pRing = getGtpuRing();
+    m_ipId  = 0;
+    if (NULL != m_pRing)
+    {
+        for (U32 i = 0; i < m_numTmpl; i++)
+        {
+            buildOuterTemplate(&m_tmpl[i]);
+        }
+    }
+
+    /* all the trains have as many packets as fit the largest G-PDU */
+    m_trainLen = 0;
+    if (GSIM_CHK_MASK(getGtpuOffload(), GSIM_GTPU_OFFLOAD_GSO))
+    {
+        U32 maxSegLen = 0;
+        for (U32 i = 0; i < m_numTmpl; i++)
+        {
+            U32 segLen = GSIM_GTPU_PKT_HDR_LEN + m_tmpl[i].padLen;
+            maxSegLen  = (segLen > maxSegLen) ? segLen : maxSegLen;
+        }
+
+        m_trainLen = GSIM_GTPU_GSO_MAX_LEN / maxSegLen;
+        if (m_trainLen > GSIM_GTPU_GSO_MAX_SEGS)
+        {
+            m_trainLen = GSIM_GTPU_GSO_MAX_SEGS;
+        }
+
+        m_gsoBuf.assign(GSIM_GTPU_GSO_BATCH * GSIM_GTPU_GSO_MAX_LEN, 0);
+        MEMSET(m_gsoSegLen, 0, sizeof(m_gsoSegLen));
+    }
+}
+
+GtpuGen::~GtpuGen()
+{
+    for (U32 i = 0; i < m_bearers.size(); i++)
+    {
+        m_bearers[i].pTun->setGenIndx(GSIM_GTPU_INV_INDX);
+    }
+
+    m_pGen = NULL;
+}
+
+/**
+ * @brief
+ *    Builds the headers of G-PDU with inner packet of given length. The
+ *    inner IPv4 checksum is computed here, the inner UDP checksum is not
+ *    used, so patching the flow port needs no checksum update
+ *
+ * @param pTmpl
+ * @param pktLen
+ *    inner IP packet length
+ */
+VOID GtpuGen::buildTemplate(GtpuPktTmpl *pTmpl, U32 pktLen)
+{
+    U8  *pBuf  = pTmpl->hdr;
+    U32 gtpLen = pktLen + GSIM_GTPU_HDR_LEN - 8; /* excludes mandatory hdr */
+    U32 udpLen = pktLen - GSIM_GTPU_IP_HDR_LEN;
+    U32 srcIp  = GSIM_GTPU_INNER_SRC_IP;
+    U32 dstIp  = GSIM_GTPU_INNER_DST_IP;
+    U32 port   = 0;
+
+    MEMSET(pTmpl, 0, sizeof(GtpuPktTmpl));
+    pTmpl->padLen = pktLen - (GSIM_GTPU_PKT_HDR_LEN - GSIM_GTPU_HDR_LEN);
+
+    /* GTP-U header, TEID and sequence number are patched */
+    pBuf[0] = GSIM_GTPU_FLAGS;
+    pBuf[1] = GSIM_GTPU_MSG_GPDU;
+    pBuf += 2;
+    GSIM_ENC_U16(pBuf, gtpLen);
+
+    /* inner IPv4 header */
+    pBuf = pTmpl->hdr + GSIM_GTPU_HDR_LEN;
+    pBuf[0] = 0x45;
+    pBuf[6] = 0x40;                  /* don't fragment */
+    pBuf[8] = 64;                    /* ttl */
+    pBuf[9] = 17;                    /* udp */
+    U8 *pTmp = pBuf + 2;
+    GSIM_ENC_U16(pTmp, pktLen);
+    pTmp = pBuf + 12;
+    GSIM_ENC_U32(pTmp, srcIp);
+    pTmp = pBuf + 16;
+    GSIM_ENC_U32(pTmp, dstIp);
+
+    U32 csum = 0;
+    for (U32 i = 0; i < GSIM_GTPU_IP_HDR_LEN; i += 2)
+    {
+        csum += ((U32)pBuf[i] << 8) | pBuf[i + 1];
+    }
+    while (csum >> 16)
+    {
+        csum = (csum & 0xFFFF) + (csum >> 16);
+    }
+    csum = ~csum & 0xFFFF;
+    pTmp = pBuf + 10;
+    GSIM_ENC_U16(pTmp, csum);
+
+    /* inner UDP header, source port is patched with the flow */
+    pBuf = pTmpl->hdr + GSIM_GTPU_UDP_SPORT_OFF;
+    port = GSIM_GTPU_INNER_SRC_PORT;
+    GSIM_ENC_U16(pBuf, port);
+    pTmp = pBuf + 2;
+    port = GSIM_GTPU_INNER_DST_PORT;
+    GSIM_ENC_U16(pTmp, port);
+    pTmp = pBuf + 4;
+    GSIM_ENC_U16(pTmp, udpLen);
+
+    /* payload header, sequence and timestamp are patched */
+    U32 magic = GSIM_GTPU_MAGIC;
+    pBuf = pTmpl->hdr + GSIM_GTPU_PAYLOAD_OFF;
+    GSIM_ENC_U32(pBuf, magic);
+}
+
+/**
+ * @brief
+ *    Builds the ethernet, outer IPv4 and UDP headers of the frames of a
+ *    template. The outer UDP checksum is not used
+ *
+ * @param pTmpl
+ */
+VOID GtpuGen::buildOuterTemplate(GtpuPktTmpl *pTmpl)
+{
+    Config *pCfg   = Config::getInstance();
+    U8     *pBuf   = pTmpl->outer;
+    U32    udpLen  = GSIM_GTPU_UDP_HDR_LEN + GSIM_GTPU_PKT_HDR_LEN + \
+                     pTmpl->padLen;
+    U32    ipLen   = GSIM_GTPU_IP_HDR_LEN + udpLen;
+    U32    srcIp   = pCfg->getLocalIpAddr()->u.ipv4Addr.addr;
+    U32    dstIp   = m_peerEp.ipAddr.u.ipv4Addr.addr;
+    U32    srcPort = pCfg->getGtpuLocalPort();
+    U32    dstPort = m_peerEp.port;
+
+    MEMSET(pBuf, 0, GSIM_GTPU_OUTER_HDR_LEN);
+    MEMCPY(pBuf, pCfg->getGtpuPeerMac(), GSIM_ETH_ADDR_LEN);
+    MEMCPY(pBuf + GSIM_ETH_ADDR_LEN, m_pRing->macAddr(), GSIM_ETH_ADDR_LEN);
+    pBuf[12] = 0x08;                 /* IPv4 */
+
+    pBuf = pTmpl->outer + GSIM_GTPU_OUTER_IP_OFF;
+    pBuf[0] = 0x45;
+    pBuf[6] = 0x40;                  /* don't fragment */
+    pBuf[8] = 64;                    /* ttl */
+    pBuf[9] = 17;                    /* udp */
+    U8 *pTmp = pBuf + 2;
+    GSIM_ENC_U16(pTmp, ipLen);
+    pTmp = pBuf + 12;
+    GSIM_ENC_U32(pTmp, srcIp);
+    pTmp = pBuf + 16;
+    GSIM_ENC_U32(pTmp, dstIp);
+
+    pTmpl->outerSum = 0;
+    for (U32 i = 0; i < GSIM_GTPU_IP_HDR_LEN; i += 2)
+    {
+        pTmpl->outerSum += ((U32)pBuf[i] << 8) | pBuf[i + 1];
+    }
+
+    pBuf = pTmpl->outer + GSIM_GTPU_OUTER_IP_OFF + GSIM_GTPU_IP_HDR_LEN;
+    GSIM_ENC_U16(pBuf, srcPort);
+    pTmp = pBuf + 2;
+    GSIM_ENC_U16(pTmp, dstPort);
+    pTmp = pBuf + 4;
+    GSIM_ENC_U16(pTmp, udpLen);
+}
+
+/**
+ * @brief
+ *    Adds the bearer to the generator table, for a bearer already in the
+ *    table only the remote TEID is updated
+ *
+ * @param pTun
+ */
+VOID GtpuGen::addBearer(GtpuTun *pTun)
+{
+    LOG_ENTERFN();
+
+    if (GSIM_GTPU_INV_INDX != pTun->genIndx())
+    {
+        m_bearers[pTun->genIndx()].remTeid = pTun->remoteTeid();
+        LOG_EXITVOID();
+    }
+
+    GtpuGenBearer bearer;
+    bearer.pTun    = pTun;
+    bearer.remTeid = pTun->remoteTeid();
+    bearer.seq     = 0;
+    bearer.flow    = 0;
+
+    pTun->setGenIndx(m_bearers.size());
+    m_bearers.push_back(bearer);
+
+    /* bearers may live shorter than the idle wake up time */
+    if (TASK_STATE_PAUSED == state())
+    {
+        m_lastRunTime = getMicroSeconds();
+        resumeTask();
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Removes the bearer by moving the last bearer of the table in its
+ *    place
+ *
+ * @param pTun
+ */
+VOID GtpuGen::delBearer(GtpuTun *pTun)
+{
+    LOG_ENTERFN();
+
+    U32 indx = pTun->genIndx();
+    U32 last = m_bearers.size() - 1;
+
+    if (indx != last)
+    {
+        m_bearers[indx] = m_bearers[last];
+        m_bearers[indx].pTun->setGenIndx(indx);
+    }
+
+    m_bearers.pop_back();
+    pTun->setGenIndx(GSIM_GTPU_INV_INDX);
+
+    if (m_nextBearer >= m_bearers.size())
+    {
+        m_nextBearer = 0;
+    }
+
+    LOG_EXITVOID();
+}
+
+RETVAL GtpuGen::run(VOID *arg)
+{
+    LOG_ENTERFN();
+
+    Time_t currTime = getMicroSeconds();
+    Time_t elapsed  = currTime - m_lastRunTime;
+    m_lastRunTime   = currTime;
+
+    if (m_bearers.empty() || (KB_KEY_PAUSE_TRAFFIC == Keyboard::key))
+    {
+        m_credit   = 0;
+        m_wakeTime = getMilliSeconds() + GSIM_GTPU_IDLE_WAKE_MS;
+        pause();
+        LOG_EXITFN(ROK);
+    }
+
+    /* packets due since the last run, limited so that a stall of the
+     * simulator does not result in a huge burst
+     */
+    U64 totalRate = (U64)m_rate * m_bearers.size();
+    U64 maxCredit = totalRate * GSIM_GTPU_MAX_BURST_US;
+
+    m_credit += elapsed * totalRate;
+    if (m_credit > maxCredit)
+    {
+        m_credit = maxCredit;
+    }
+
+    U64 numPkts = m_credit / 1000000;
+    m_credit   -= numPkts * 1000000;
+
+    /* segmentation offload is disabled by transport if it fails */
+    BOOL useGso = (0 != m_trainLen) && \
+        GSIM_CHK_MASK(getGtpuOffload(), GSIM_GTPU_OFFLOAD_GSO);
+    U32  chunk  = useGso ? m_trainLen * GSIM_GTPU_GSO_BATCH : GSIM_GTPU_BATCH;
+
+    while (numPkts > 0)
+    {
+        U32 batch = (numPkts > chunk) ? chunk : numPkts;
+        if (NULL != m_pRing)
+        {
+            sendFrames(batch);
+        }
+        else if (useGso)
+        {
+            sendTrains(batch);
+        }
+        else
+        {
+            sendPkts(batch);
+        }
+        numPkts -= batch;
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Sends the packets round robin over the bearers and templates, the
+ *    packets which could not be sent are counted as tx drops
+ *
+ * @param numPkts
+ */
+VOID GtpuGen::sendPkts(U32 numPkts)
+{
+    Time_t currTime   = getWallMicroSeconds();
+    U32    tsHi       = (U32)(currTime >> 32);
+    U32    tsLo       = (U32)currTime;
+    U64    numBytes   = 0;
+
+    for (U32 i = 0; i < numPkts; i++)
+    {
+        GtpuPktTmpl *pTmpl = &m_tmpl[m_nextTmpl];
+        U8          *pHdr  = m_hdrs[i];
+
+        MEMCPY(pHdr, pTmpl->hdr, GSIM_GTPU_PKT_HDR_LEN);
+        fillPkt(pHdr, tsHi, tsLo);
+
+        m_msgs[i].pHdr    = pHdr;
+        m_msgs[i].hdrLen  = GSIM_GTPU_PKT_HDR_LEN;
+        m_msgs[i].pData   = s_gtpuPad;
+        m_msgs[i].dataLen = pTmpl->padLen;
+        m_msgs[i].segLen  = 0;
+        numBytes += GSIM_GTPU_PKT_HDR_LEN + pTmpl->padLen;
+
+        m_nextTmpl = (m_nextTmpl + 1 == m_numTmpl) ? 0 : m_nextTmpl + 1;
+    }
+
+    U32 numSent = sendMsgBatch(m_connId, &m_peerEp, m_msgs, numPkts);
+
+    if (numSent < numPkts)
+    {
+        for (U32 i = numSent; i < numPkts; i++)
+        {
+            numBytes -= m_msgs[i].hdrLen + m_msgs[i].dataLen;
+        }
+        m_txDrops += numPkts - numSent;
+    }
+
+    m_pktsSent  += numSent;
+    m_bytesSent += numBytes;
+}
+
+/**
+ * @brief
+ *    Sends the packets as trains of same size G-PDUs segmented by the
+ *    kernel (GSO). Each train is built in its own buffer from a single
+ *    template, the templates are rotated between the trains, so with
+ *    IMIX all the trains have the same number of packets
+ *
+ * @param numPkts
+ *    not more than m_trainLen * GSIM_GTPU_GSO_BATCH
+ */
+VOID GtpuGen::sendTrains(U32 numPkts)
+{
+    Time_t currTime  = getWallMicroSeconds();
+    U32    tsHi      = (U32)(currTime >> 32);
+    U32    tsLo      = (U32)currTime;
+    U32    numTrains = 0;
+    U32    trainPkts[GSIM_GTPU_GSO_BATCH];
+
+    while (numPkts > 0 && numTrains < GSIM_GTPU_GSO_BATCH)
+    {
+        GtpuPktTmpl *pTmpl  = &m_tmpl[m_nextTmpl];
+        U32          segLen = GSIM_GTPU_PKT_HDR_LEN + pTmpl->padLen;
+        U32          n      = (numPkts > m_trainLen) ? m_trainLen : numPkts;
+        U8          *pBuf   = &m_gsoBuf[numTrains * GSIM_GTPU_GSO_MAX_LEN];
+
+        /* headers of a different segment size would be left in padding */
+        if (m_gsoSegLen[numTrains] != segLen)
+        {
+            MEMSET(pBuf, 0, GSIM_GTPU_GSO_MAX_LEN);
+            m_gsoSegLen[numTrains] = segLen;
+        }
+
+        for (U32 i = 0; i < n; i++)
+        {
+            U8 *pHdr = pBuf + i * segLen;
+            MEMCPY(pHdr, pTmpl->hdr, GSIM_GTPU_PKT_HDR_LEN);
+            fillPkt(pHdr, tsHi, tsLo);
+        }
+
+        m_msgs[numTrains].pHdr    = pBuf;
+        m_msgs[numTrains].hdrLen  = n * segLen;
+        m_msgs[numTrains].pData   = NULL;
+        m_msgs[numTrains].dataLen = 0;
+        m_msgs[numTrains].segLen  = segLen;
+        trainPkts[numTrains]      = n;
+
+        numPkts -= n;
+        numTrains++;
+        m_nextTmpl = (m_nextTmpl + 1 == m_numTmpl) ? 0 : m_nextTmpl + 1;
+    }
+
+    U32 numSent = sendMsgBatch(m_connId, &m_peerEp, m_msgs, numTrains);
+
+    for (U32 i = 0; i < numTrains; i++)
+    {
+        if (i < numSent)
+        {
+            m_pktsSent  += trainPkts[i];
+            m_bytesSent += m_msgs[i].hdrLen;
+        }
+        else
+        {
+            m_txDrops += trainPkts[i];
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Patches the headers copied from a template for the next bearer in
+ *    round robin order
+ *
+ * @param pHdr
+ * @param tsHi
+ * @param tsLo
+ *    send timestamp
+ */
+VOID GtpuGen::fillPkt(U8 *pHdr, U32 tsHi, U32 tsLo)
+{
+    GtpuGenBearer *pBearer    = &m_bearers[m_nextBearer];
+    U32            numBearers = m_bearers.size();
+    U32            port       = GSIM_GTPU_INNER_SRC_PORT + pBearer->flow;
+
+    U8 *pTmp = pHdr + GSIM_GTPU_TEID_OFF;
+    GTP_ENC_TEID(pTmp, pBearer->remTeid);
+    pTmp = pHdr + GSIM_GTPU_SEQN_OFF;
+    GSIM_ENC_U16(pTmp, pBearer->seq);
+    pTmp = pHdr + GSIM_GTPU_UDP_SPORT_OFF;
+    GSIM_ENC_U16(pTmp, port);
+    pTmp = pHdr + GSIM_GTPU_PAYLOAD_OFF + 4;
+    GSIM_ENC_U32(pTmp, pBearer->seq);
+    pTmp = pHdr + GSIM_GTPU_PAYLOAD_OFF + 8;
+    GSIM_ENC_U32(pTmp, tsHi);
+    pTmp = pHdr + GSIM_GTPU_PAYLOAD_OFF + 12;
+    GSIM_ENC_U32(pTmp, tsLo);
+
+    pBearer->seq++;
+    pBearer->flow = (pBearer->flow + 1 == m_flows) ? 0 : pBearer->flow + 1;
+    m_nextBearer  = (m_nextBearer + 1 == numBearers) ? 0 : m_nextBearer + 1;
+}
+
+/**
+ * @brief
+ *    Builds the frames directly in the tx ring of the GTP-U interface and
+ *    kicks the ring once every GSIM_GTPU_RING_FLUSH frames. The outer IPv4
+ *    checksum is updated from the template sum with the identification
+ *    of the frame. Frames for which the ring is full are counted as drops
+ *
+ * @param numPkts
+ */
+VOID GtpuGen::sendFrames(U32 numPkts)
+{
+    Time_t currTime = getWallMicroSeconds();
+    U32    tsHi     = (U32)(currTime >> 32);
+    U32    tsLo     = (U32)currTime;
+
+    for (U32 i = 0; i < numPkts; i++)
+    {
+        U8 *pFrame = m_pRing->txFrame();
+        if (NULL == pFrame)
+        {
+            m_txDrops += numPkts - i;
+            break;
+        }
+
+        GtpuPktTmpl *pTmpl  = &m_tmpl[m_nextTmpl];
+        U32          segLen = GSIM_GTPU_PKT_HDR_LEN + pTmpl->padLen;
+
+        MEMCPY(pFrame, pTmpl->outer, GSIM_GTPU_OUTER_HDR_LEN);
+        MEMCPY(pFrame + GSIM_GTPU_OUTER_HDR_LEN, pTmpl->hdr,
+            GSIM_GTPU_PKT_HDR_LEN);
+        fillPkt(pFrame + GSIM_GTPU_OUTER_HDR_LEN, tsHi, tsLo);
+
+        U32 ipId = m_ipId++;
+        U32 csum = pTmpl->outerSum + ipId;
+        csum     = (csum & 0xFFFF) + (csum >> 16);
+        csum     = (csum & 0xFFFF) + (csum >> 16);
+        csum     = ~csum & 0xFFFF;
+
+        U8 *pTmp = pFrame + GSIM_GTPU_OUTER_IP_OFF + 4;
+        GSIM_ENC_U16(pTmp, ipId);
+        pTmp = pFrame + GSIM_GTPU_OUTER_IP_OFF + 10;
+        GSIM_ENC_U16(pTmp, csum);
+
+        m_pRing->txCommit(GSIM_GTPU_OUTER_HDR_LEN + segLen);
+        m_pktsSent++;
+        m_bytesSent += segLen;
+
+        if (0 == (m_pktsSent % GSIM_GTPU_RING_FLUSH))
+        {
+            m_pRing->txFlush();
+        }
+
+        m_nextTmpl = (m_nextTmpl + 1 == m_numTmpl) ? 0 : m_nextTmpl + 1;
+    }
+
+    m_pRing->txFlush();
+}
@@ -0,0 +1,146 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTPU_GEN_HPP__
+#define __GTPU_GEN_HPP__
+
+/* G-PDU layout: GTP-U header with sequence number, inner IPv4 and UDP
+ * header and the gsim payload header, followed by padding up to the
+ * inner packet length
+ */
+#define GSIM_GTPU_HDR_LEN           12
+#define GSIM_GTPU_IP_HDR_LEN        20
+#define GSIM_GTPU_UDP_HDR_LEN       8
+#define GSIM_GTPU_PAYLOAD_HDR_LEN   16    /* magic, seq, timestamp */
+#define GSIM_GTPU_PKT_HDR_LEN       (GSIM_GTPU_HDR_LEN + \
+                                     GSIM_GTPU_IP_HDR_LEN + \
+                                     GSIM_GTPU_UDP_HDR_LEN + \
+                                     GSIM_GTPU_PAYLOAD_HDR_LEN)
+#define GSIM_GTPU_TEID_OFF          4
+#define GSIM_GTPU_SEQN_OFF          8
+#define GSIM_GTPU_UDP_SPORT_OFF     (GSIM_GTPU_HDR_LEN + GSIM_GTPU_IP_HDR_LEN)
+#define GSIM_GTPU_PAYLOAD_OFF       (GSIM_GTPU_UDP_SPORT_OFF + \
+                                     GSIM_GTPU_UDP_HDR_LEN)
+
+#define GSIM_GTPU_FLAGS             0x32  /* version 1, PT, S */
+#define GSIM_GTPU_MSG_GPDU          0xFF
+#define GSIM_GTPU_MAGIC             0x4753494D    /* "GSIM" */
+#define GSIM_GTPU_INNER_SRC_IP      0x0A2D0001    /* 10.45.0.1 */
+#define GSIM_GTPU_INNER_DST_IP      0xC6120001    /* 198.18.0.1 */
+#define GSIM_GTPU_INNER_SRC_PORT    10000         /* + flow number */
+#define GSIM_GTPU_INNER_DST_PORT    5001
+
+#define GSIM_GTPU_IMIX_LEN          12
+#define GSIM_GTPU_BATCH             256   /* packets per send call */
+#define GSIM_GTPU_MAX_BURST_US      10000 /* credit limit after a stall */
+#define GSIM_GTPU_IDLE_WAKE_MS      10
+
+/* frames on the GTP-U interface, ethernet, outer IPv4 and UDP headers */
+#define GSIM_GTPU_OUTER_HDR_LEN     42
+#define GSIM_GTPU_OUTER_IP_OFF      14
+#define GSIM_GTPU_RING_FLUSH        64    /* frames per tx ring kick */
+
+#define GSIM_GTPU_GSO_MAX_LEN       65000 /* UDP payload of a GSO train */
+#define GSIM_GTPU_GSO_MAX_SEGS      64    /* kernel limit of segments */
+#define GSIM_GTPU_GSO_BATCH         8     /* trains per send call */
+
+/* bearer in the generator table, the table is kept dense so that sending
+ * is a linear walk over an array
+ */
+typedef struct
+{
+   GtpuTun     *pTun;
+   GtpTeid_t   remTeid;
+   U32         seq;
+   U32         flow;
+} GtpuGenBearer;
+
+/* template of the G-PDU headers for one inner packet length. The outer
+ * headers are used only on the GTP-U interface, outerSum is the IPv4
+ * header checksum sum with zero identification, which is then added per
+ * frame
+ */
+typedef struct
+{
+   U8          hdr[GSIM_GTPU_PKT_HDR_LEN];
+   U32         padLen;
+   U8          outer[GSIM_GTPU_OUTER_HDR_LEN];
+   U32         outerSum;
+} GtpuPktTmpl;
+
+/* Generates G-PDUs on all the bearers with a known remote TEID, at
+ * gtpu-rate packets per second per bearer. The packets are built from
+ * prebuilt header templates, only the TEID, sequence number, flow and
+ * timestamp are patched per packet, and the padding is shared by all the
+ * packets. The task stays in running state while there are bearers and
+ * sends the packets due since the last run in batches, or in trains of
+ * GSO segments when the kernel supports UDP segmentation offload. On a
+ * GTP-U interface complete frames are built in the packet tx ring
+ */
+class GtpuGen: public Task
+{
+   public:
+      static GtpuGen*   getInstance();
+      ~GtpuGen();
+
+      RETVAL            run(VOID *arg = NULL);
+      inline Time_t     wake() { return m_wakeTime; }
+
+      VOID              addBearer(GtpuTun *pTun);
+      VOID              delBearer(GtpuTun *pTun);
+
+      U32               numBearers() { return m_bearers.size(); }
+      U64               pktsSent() { return m_pktsSent; }
+      U64               bytesSent() { return m_bytesSent; }
+      U64               txDrops() { return m_txDrops; }
+
+   private:
+      GtpuGen();
+
+      static GtpuGen    *m_pGen;
+
+      VOID              buildTemplate(GtpuPktTmpl *pTmpl, U32 pktLen);
+      VOID              buildOuterTemplate(GtpuPktTmpl *pTmpl);
+      VOID              sendFrames(U32 numPkts);
+      VOID              sendPkts(U32 numPkts);
+      VOID              sendTrains(U32 numPkts);
+      VOID              fillPkt(U8 *pHdr, U32 tsHi, U32 tsLo);
+
+      std::vector<GtpuGenBearer> m_bearers;
+      GtpuPktTmpl       m_tmpl[GSIM_GTPU_IMIX_LEN];
+      U32               m_numTmpl;
+      U32               m_nextTmpl;
+      U32               m_nextBearer;
+      U32               m_rate;
+      U32               m_flows;
+      TransConnId       m_connId;
+      IPEndPoint        m_peerEp;
+      Time_t            m_wakeTime;
+      Time_t            m_lastRunTime;  /* micro-seconds */
+      U64               m_credit;       /* packets * 1000000 */
+      U64               m_pktsSent;
+      U64               m_bytesSent;
+      U64               m_txDrops;
+      U8                m_hdrs[GSIM_GTPU_BATCH][GSIM_GTPU_PKT_HDR_LEN];
+      SendVec_t         m_msgs[GSIM_GTPU_BATCH];
+      PacketRing        *m_pRing;       /* NULL if UDP socket is used */
+      U16               m_ipId;
+      U32               m_trainLen;     /* packets per GSO train, 0 if no GSO */
+      std::vector<U8>   m_gsoBuf;       /* GSIM_GTPU_GSO_BATCH trains */
+      U32               m_gsoSegLen[GSIM_GTPU_GSO_BATCH];
+};
+
+#endif
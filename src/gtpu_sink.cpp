@@ -0,0 +1,390 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "tunnel.hpp"
+#include "gtpu_gen.hpp"
+#include "gtpu_sink.hpp"
+
+GtpuSink *GtpuSink::m_pSink = NULL;
+
+GtpuSink *GtpuSink::getInstance()
+{
+    try
+    {
+        if (NULL == m_pSink)
+        {
+            m_pSink = new GtpuSink;
+        }
+    }
+    catch (std::exception &e)
+    {
+        LOG_FATAL("Memory allocation failure, GtpuSink");
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    return m_pSink;
+}
+
+GtpuSink::GtpuSink()
+    : m_bearerPool("gtpu-sink-bearer", sizeof(GtpuSinkBearer))
+{
+    m_table = (GtpuSinkBearer **)memAlloc(memRegister("gtpu-sink-table"),
+        GSIM_GTPU_SINK_TBL_SIZE * sizeof(GtpuSinkBearer *));
+    if (NULL == m_table)
+    {
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    m_numBearers  = 0;
+    m_rxPkts      = 0;
+    m_rxBytes     = 0;
+    m_lost        = 0;
+    m_dup         = 0;
+    m_reorder     = 0;
+    m_late        = 0;
+    m_unknownTeid = 0;
+    m_malformed   = 0;
+    m_collisions  = 0;
+}
+
+GtpuSink::~GtpuSink()
+{
+    for (U32 i = 0; i < GSIM_GTPU_SINK_TBL_SIZE; i++)
+    {
+        if (NULL != m_table[i])
+        {
+            m_bearerPool.free(m_table[i]);
+        }
+    }
+
+    m_pSink = NULL;
+}
+
+VOID GtpuSink::addBearer(GtpTeid_t teid)
+{
+    LOG_ENTERFN();
+
+    U32 indx = teid & GSIM_GTPU_SINK_TBL_MASK;
+    if (NULL != m_table[indx])
+    {
+        /* more than table size bearers alive, G-PDUs of this bearer are
+         * counted as unknown TEID
+         */
+        LOG_ERROR("GTP-U sink table slot in use, TEID [%u]", teid);
+        m_collisions++;
+        LOG_EXITVOID();
+    }
+
+    GtpuSinkBearer *pBearer = (GtpuSinkBearer *)m_bearerPool.alloc();
+    if (NULL == pBearer)
+    {
+        LOG_ERROR("Memory allocation failure, GTP-U sink bearer");
+        LOG_EXITVOID();
+    }
+
+    MEMSET(pBearer, 0, sizeof(GtpuSinkBearer));
+    pBearer->teid   = teid;
+    pBearer->latMin = (U64)-1;
+
+    m_table[indx] = pBearer;
+    m_numBearers++;
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Removes the bearer from the table, sequence numbers still missing in
+ *    the window are counted as lost
+ *
+ * @param teid
+ */
+VOID GtpuSink::delBearer(GtpTeid_t teid)
+{
+    LOG_ENTERFN();
+
+    GtpuSinkBearer *pBearer = findBearer(teid);
+    if (NULL == pBearer)
+    {
+        LOG_EXITVOID();
+    }
+
+    if (pBearer->seqInit)
+    {
+        U64 missing = GSIM_GTPU_SINK_WINDOW - \
+            __builtin_popcountll(pBearer->window);
+        pBearer->lost += missing;
+        m_lost        += missing;
+    }
+
+    LOG_DEBUG("GTP-U bearer [%u] Packets [%llu] Lost [%llu] Dup [%llu] "
+        "Reorder [%llu] Latency-us Min [%llu] Avg [%llu] Max [%llu]",
+        teid, (unsigned long long)pBearer->rxPkts,
+        (unsigned long long)pBearer->lost, (unsigned long long)pBearer->dup,
+        (unsigned long long)pBearer->reorder,
+        (unsigned long long)(pBearer->latCount ? pBearer->latMin : 0),
+        (unsigned long long)(pBearer->latCount ? \
+            pBearer->latSum / pBearer->latCount : 0),
+        (unsigned long long)pBearer->latMax);
+
+    m_table[teid & GSIM_GTPU_SINK_TBL_MASK] = NULL;
+    m_numBearers--;
+    m_bearerPool.free(pBearer);
+
+    LOG_EXITVOID();
+}
+
+GtpuSinkBearer *GtpuSink::findBearer(GtpTeid_t teid)
+{
+    GtpuSinkBearer *pBearer = m_table[teid & GSIM_GTPU_SINK_TBL_MASK];
+    if (NULL != pBearer && pBearer->teid != teid)
+    {
+        pBearer = NULL;
+    }
+
+    return pBearer;
+}
+
+/**
+ * @brief
+ *    Processes a batch of received G-PDUs. The TEID is looked up in the
+ *    table and the sequence number and the send timestamp are read from
+ *    the payload header added by the GTP-U generator. G-PDUs without the
+ *    payload header are counted against the bearer but not measured
+ *
+ * @param pMsgs
+ * @param cnt
+ */
+VOID GtpuSink::procPkts(RecvVec_t *pMsgs, U32 cnt)
+{
+    Time_t currTime = getWallMicroSeconds();
+
+    for (U32 i = 0; i < cnt; i++)
+    {
+        U8  *pBuf   = pMsgs[i].pBuf;
+        U32 bufLen  = (pMsgs[i].len < pMsgs[i].bufLen) ? \
+                      pMsgs[i].len : pMsgs[i].bufLen;
+
+        m_rxPkts++;
+        m_rxBytes += pMsgs[i].len;
+
+        if ((bufLen < GSIM_GTPU_MIN_HDR_LEN) ||
+            ((pBuf[0] & (GSIM_GTPU_FLAG_VERSION | GSIM_GTPU_FLAG_PT)) != \
+             0x30) ||
+            (GSIM_GTPU_MSG_GPDU != pBuf[1]))
+        {
+            m_malformed++;
+            continue;
+        }
+
+        GtpTeid_t teid = 0;
+        U8 *pTmp = pBuf + GSIM_GTPU_TEID_OFF;
+        GTP_DEC_TEID(pTmp, teid);
+
+        GtpuSinkBearer *pBearer = findBearer(teid);
+        if (NULL == pBearer)
+        {
+            m_unknownTeid++;
+            continue;
+        }
+
+        pBearer->rxPkts++;
+        pBearer->rxBytes += pMsgs[i].len;
+
+        /* skip the optional fields and the extension headers */
+        U32 off = GSIM_GTPU_MIN_HDR_LEN;
+        if (pBuf[0] & GSIM_GTPU_FLAG_OPT)
+        {
+            off = GSIM_GTPU_HDR_LEN;
+            U8 nextExt = (pBuf[0] & GSIM_GTPU_FLAG_E) ? pBuf[off - 1] : 0;
+            while (0 != nextExt && off < bufLen)
+            {
+                U32 extLen = pBuf[off] * 4;
+                if (0 == extLen || off + extLen > bufLen)
+                {
+                    off = bufLen;
+                    break;
+                }
+
+                nextExt = pBuf[off + extLen - 1];
+                off    += extLen;
+            }
+        }
+
+        /* inner IPv4 and UDP headers followed by the payload header */
+        if (off + GSIM_GTPU_IP_HDR_LEN > bufLen || (pBuf[off] >> 4) != 4 || \
+            pBuf[off + 9] != 17)
+        {
+            continue;
+        }
+
+        off += (pBuf[off] & 0x0F) * 4 + GSIM_GTPU_UDP_HDR_LEN;
+        if (off + GSIM_GTPU_PAYLOAD_HDR_LEN > bufLen)
+        {
+            continue;
+        }
+
+        U32 magic = 0;
+        U32 seq   = 0;
+        U32 tsHi  = 0;
+        U32 tsLo  = 0;
+        pTmp = pBuf + off;
+        GSIM_DEC_U32(pTmp, magic);
+        if (GSIM_GTPU_MAGIC != magic)
+        {
+            continue;
+        }
+
+        pTmp = pBuf + off + 4;
+        GSIM_DEC_U32(pTmp, seq);
+        pTmp = pBuf + off + 8;
+        GSIM_DEC_U32(pTmp, tsHi);
+        pTmp = pBuf + off + 12;
+        GSIM_DEC_U32(pTmp, tsLo);
+
+        procSeq(pBearer, seq);
+
+        /* clocks of sender and receiver may not be exactly in sync */
+        Time_t sentTime = ((Time_t)tsHi << 32) | tsLo;
+        procLatency(pBearer, (currTime > sentTime) ? currTime - sentTime : 0);
+    }
+}
+
+/**
+ * @brief
+ *    Updates the sequence window of the bearer with a received sequence
+ *    number. Sequence numbers are compared as serial numbers, so the
+ *    wrap around of the generator sequence is handled
+ *
+ * @param pBearer
+ * @param seq
+ */
+VOID GtpuSink::procSeq(GtpuSinkBearer *pBearer, U32 seq)
+{
+    if (!pBearer->seqInit)
+    {
+        /* sequence numbers before the first one are not expected */
+        pBearer->seqInit = TRUE;
+        pBearer->maxSeq  = seq;
+        pBearer->window  = ~(U64)0;
+        return;
+    }
+
+    S32 diff = (S32)(seq - pBearer->maxSeq);
+    if (diff > 0)
+    {
+        U64 missing = 0;
+        if (diff >= GSIM_GTPU_SINK_WINDOW)
+        {
+            missing = (GSIM_GTPU_SINK_WINDOW - \
+                       __builtin_popcountll(pBearer->window)) + \
+                      (diff - GSIM_GTPU_SINK_WINDOW);
+            pBearer->window = 1;
+        }
+        else
+        {
+            U64 shiftedOut = pBearer->window >> \
+                (GSIM_GTPU_SINK_WINDOW - diff);
+            missing = diff - __builtin_popcountll(shiftedOut);
+            pBearer->window = (pBearer->window << diff) | 1;
+        }
+
+        pBearer->maxSeq = seq;
+        pBearer->lost  += missing;
+        m_lost         += missing;
+    }
+    else if (-diff < GSIM_GTPU_SINK_WINDOW)
+    {
+        U64 bit = (U64)1 << -diff;
+        if (pBearer->window & bit)
+        {
+            pBearer->dup++;
+            m_dup++;
+        }
+        else
+        {
+            pBearer->window |= bit;
+            pBearer->reorder++;
+            m_reorder++;
+        }
+    }
+    else
+    {
+        /* already counted as lost, a duplicate this old is not detected */
+        pBearer->late++;
+        m_late++;
+        if (pBearer->lost > 0)
+        {
+            pBearer->lost--;
+            m_lost--;
+        }
+    }
+}
+
+VOID GtpuSink::procLatency(GtpuSinkBearer *pBearer, U64 latency)
+{
+    U32 bucket = 0;
+    if (0 != latency)
+    {
+        bucket = 64 - __builtin_clzll(latency);
+        if (bucket >= GSIM_GTPU_SINK_LAT_BUCKETS)
+        {
+            bucket = GSIM_GTPU_SINK_LAT_BUCKETS - 1;
+        }
+    }
+
+    pBearer->latBuckets[bucket]++;
+    pBearer->latCount++;
+    pBearer->latSum += latency;
+    if (latency < pBearer->latMin)
+    {
+        pBearer->latMin = latency;
+    }
+    if (latency > pBearer->latMax)
+    {
+        pBearer->latMax = latency;
+    }
+
+    Stats::recordLatency(GSIM_HIST_GTPU_LATENCY, latency);
+}
+
+PUBLIC VOID procGtpuMsgBatch(RecvVec_t *pMsgs, U32 cnt)
+{
+    if (Config::getInstance()->getGtpuSink())
+    {
+        GtpuSink::getInstance()->procPkts(pMsgs, cnt);
+    }
+}
@@ -0,0 +1,108 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GTPU_SINK_HPP__
+#define __GTPU_SINK_HPP__
+
+/* local GTP-U TEIDs are allocated sequentially, so a TEID indexes the
+ * table directly and the slot is reused only after so many bearers
+ */
+#define GSIM_GTPU_SINK_TBL_SIZE     (1 << 20)
+#define GSIM_GTPU_SINK_TBL_MASK     (GSIM_GTPU_SINK_TBL_SIZE - 1)
+#define GSIM_GTPU_SINK_WINDOW       64    /* bits in the sequence window */
+#define GSIM_GTPU_SINK_LAT_BUCKETS  20    /* power of two, upto 0.5 sec */
+
+#define GSIM_GTPU_FLAG_VERSION      0xE0
+#define GSIM_GTPU_FLAG_PT           0x10
+#define GSIM_GTPU_FLAG_E            0x04
+#define GSIM_GTPU_FLAG_OPT          0x07  /* E, S and PN flags */
+#define GSIM_GTPU_MIN_HDR_LEN       8
+
+/* Receive side accounting of a bearer. The sequence window has a bit for
+ * each of the last GSIM_GTPU_SINK_WINDOW sequence numbers upto maxSeq,
+ * bit 0 being maxSeq. A sequence number is counted as lost when it is
+ * shifted out of the window without being received
+ */
+typedef struct
+{
+   GtpTeid_t   teid;
+   BOOL        seqInit;
+   U32         maxSeq;
+   U64         window;
+   U64         rxPkts;
+   U64         rxBytes;
+   U64         lost;
+   U64         dup;
+   U64         reorder;
+   U64         late;       /* received after it was counted as lost */
+   U64         latCount;
+   U64         latSum;
+   U64         latMin;
+   U64         latMax;
+   U32         latBuckets[GSIM_GTPU_SINK_LAT_BUCKETS];
+} GtpuSinkBearer;
+
+/* Receives the G-PDUs sent by the GTP-U generator of the peer and
+ * accounts them against the bearer of the TEID. Only the headers of each
+ * G-PDU are read from the socket. Counters of all the bearers are also
+ * kept in total, the counters of a bearer are lost when it is deleted
+ */
+class GtpuSink
+{
+   public:
+      static GtpuSink*  getInstance();
+      ~GtpuSink();
+
+      VOID              addBearer(GtpTeid_t teid);
+      VOID              delBearer(GtpTeid_t teid);
+      GtpuSinkBearer*   findBearer(GtpTeid_t teid);
+      VOID              procPkts(RecvVec_t *pMsgs, U32 cnt);
+
+      U32               numBearers() { return m_numBearers; }
+      U64               rxPkts() { return m_rxPkts; }
+      U64               rxBytes() { return m_rxBytes; }
+      U64               lost() { return m_lost; }
+      U64               dup() { return m_dup; }
+      U64               reorder() { return m_reorder; }
+      U64               late() { return m_late; }
+      U64               unknownTeid() { return m_unknownTeid; }
+      U64               malformed() { return m_malformed; }
+
+   private:
+      GtpuSink();
+
+      static GtpuSink   *m_pSink;
+
+      VOID              procSeq(GtpuSinkBearer *pBearer, U32 seq);
+      VOID              procLatency(GtpuSinkBearer *pBearer, U64 latency);
+
+      GtpuSinkBearer    **m_table;       /* from the memory arena */
+      MemPool           m_bearerPool;
+      U32               m_numBearers;
+      U64               m_rxPkts;
+      U64               m_rxBytes;
+      U64               m_lost;
+      U64               m_dup;
+      U64               m_reorder;
+      U64               m_late;
+      U64               m_unknownTeid;
+      U64               m_malformed;
+      U64               m_collisions;
+};
+
+EXTERN VOID procGtpuMsgBatch(RecvVec_t *pMsgs, U32 cnt);
+
+#endif
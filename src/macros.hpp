@@ -59,6 +59,12 @@
    (_v) |= ((U32)(_buf[3]));                       \
 }
 
+#define GSIM_ENC_U16(_buf, _v)                     \
+{                                                  \
+   _buf[0] = (U8)((0xff00 & _v) >> 8);             \
+   _buf[1] = (U8)((0x00ff & _v));                  \
+}
+
 #define GSIM_ENC_U32(_buf, _v)                     \
 {                                                  \
    _buf[0] = (U8)((0xff000000 & _v) >> 24);        \
@@ -53,6 +53,11 @@ int main(int argc, char **argv)
              ("rate-period", "Default is one second. This options allows "\
               "user to change the rate period",
               cxxopts::value<std::uint32_t>());
+        options.add_options()
+             ("concurrency", "Closed-loop mode, keeps this many UE sessions "\
+              "in flight. A new session is started whenever one completes "\
+              "or fails, session-rate is not used",
+              cxxopts::value<std::uint32_t>());
         options.add_options()
             ("local-ip", "Local IP Address at which the GTP simulator "\
              "will listen for GTPv2-C messages from peer entity",
@@ -61,13 +66,167 @@ int main(int argc, char **argv)
             ("remote-ip", "Remote peer IP Address, GTP simulator sends all "\
              "initiating messages to this IP address",
              cxxopts::value<std::string>());
+        options.add_options()
+            ("remote-peers", "Pool of remote peers the sessions are "
+            "distributed across, a comma separated list of "
+            "ip[-ip][/port][*weight], e.g. 10.0.0.1-10.0.0.8,10.0.1.1/2124*2. "
+            "A range adds every IPv4 address of the range. The port is "
+            "remote-port and the weight, 1 to 100, is 1 if not given",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("peer-select", "Remote peer of a new session, rr, weighted or "
+            "imsi-hash. imsi-hash keeps an IMSI on the same peer. Default "
+            "value is rr",
+             cxxopts::value<std::string>());
         options.add_options()
             ("local-port", "Local GTPv2-C listening port. "\
              "Default value is 2123.",
              cxxopts::value<std::uint16_t>());
+        options.add_options()
+            ("local-endpoints", "Local endpoints the initiated sessions are "
+            "sent from, one socket each, a comma separated list of "
+            "ip[-ip][/port[-port]], e.g. 10.1.0.1-10.1.0.100,10.2.0.1/"
+            "40000-40099. Every IPv4 address and port of the ranges is an "
+            "endpoint, the port is ephemeral if not given. The sessions are "
+            "assigned to the endpoints round-robin. Default is local-ip",
+             cxxopts::value<std::string>());
         options.add_options()
             ("remote-port", "Remote peer UDP port number",
              cxxopts::value<std::uint16_t>());
+        options.add_options()
+            ("find-max-rate", "Benchmark mode, searches the maximum "
+            "session-rate meeting the search SLOs starting from session-rate, "
+            "writes the report to search-report file and exits");
+        options.add_options()
+            ("search-step-time", "Time in milli-seconds each session-rate "
+            "is measured, after a warmup of (n3-requests + 1) * t3-timer. "
+            "Default value is 10000",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("search-max-fail", "SLO, maximum percentage of sessions "
+            "failed due to timeout. Default value is 0.1",
+             cxxopts::value<double>());
+        options.add_options()
+            ("search-max-p99", "SLO, maximum p99 session latency in "
+            "milli-seconds. Default value is 1000",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("search-max-unexp", "SLO, maximum unexpected messages received "
+            "in a step. Default value is 0",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("search-report", "JSON report file of find-max-rate",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("adaptive-rate", "Adapts the session-rate to the load of the "
+            "peer, the rate is halved on timeouts, retransmissions, "
+            "no-resources rejections or high latency and increased back "
+            "up to session-rate otherwise");
+        options.add_options()
+            ("adaptive-max-latency", "p99 session latency in milli-seconds "
+            "above which adaptive-rate decreases the rate, 0 to disable. "
+            "Default value is 1000",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("gtpu-rate", "G-PDUs per second sent on each bearer once the "
+            "remote GTP-U TEID is known, 0 disables the GTP-U traffic",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("gtpu-size", "Inner IP packet length of G-PDUs in bytes, or "
+            "imix for 7:4:1 of 64, 576 and 1500 bytes. Default value is 64",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("gtpu-flows", "Inner UDP flows per bearer. Default value is 1",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("gtpu-local-port", "Local GTP-U port. Default value is 2152",
+             cxxopts::value<std::uint16_t>());
+        options.add_options()
+            ("gtpu-remote-port", "Remote GTP-U port. Default value is 2152",
+             cxxopts::value<std::uint16_t>());
+        options.add_options()
+            ("gtpu-remote-ip", "Remote GTP-U IP Address, default is "
+            "remote-ip",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("gtpu-sink", "Receive G-PDUs on the local GTP-U port and measure "
+            "loss, reordering and one-way latency of each bearer");
+        options.add_options()
+            ("gtpu-iface", "Send and receive GTP-U frames on this interface "
+            "with AF_PACKET rings instead of the UDP socket, e.g. a veth",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("gtpu-peer-mac", "Destination MAC address of the GTP-U frames "
+            "sent on gtpu-iface, default is broadcast",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("gtpu-offload", "Use UDP segmentation (GSO) to send and UDP "
+            "receive coalescing (GRO) on the GTP-U socket, if supported by "
+            "the kernel");
+        options.add_options()
+            ("transport", "GTP-C socket I/O, poll for one system call per "
+            "message, mmsg for recvmmsg and sendmmsg batches or uring for "
+            "io_uring with multishot receive. Default value is poll",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("sock-rcvbuf", "Receive buffer size of the UDP sockets in "
+            "bytes, limited by net.core.rmem_max unless run with "
+            "CAP_NET_ADMIN. Default value is 1048576",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("sock-sndbuf", "Send buffer size of the UDP sockets in bytes, "
+            "limited by net.core.wmem_max unless run with CAP_NET_ADMIN. "
+            "Default value is 1048576",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("timestamps", "Take the receive time of GTP-C messages from "
+            "kernel socket timestamps, the response time of the peer is "
+            "then measured apart from the scheduling delay of gsim");
+        options.add_options()
+            ("busy-poll", "Low latency mode, the scheduler spins on the "
+            "sockets with SO_BUSY_POLL instead of sleeping in poll() and "
+            "uses a TSC clock, if the CPU has an invariant TSC");
+        options.add_options()
+            ("cpu-affinity", "Pin the scheduler thread to these cores, e.g. "
+            "2 or 2,4-5",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("rt-prio", "Run the scheduler thread with SCHED_FIFO at this "
+            "priority, 1 to 99, and lock its memory",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("hugepages", "Page size of the session, index and packet "
+            "pools, off, 2M or 1G. The pools fall back to normal pages if "
+            "no hugepages are reserved. Default value is 2M",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("imsi", "IMSI of the first UE session, the following sessions "
+            "take the next IMSIs. Default value is 112233445566778",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("imsi-stride", "Difference between the IMSIs of consecutive "
+            "UE sessions. Default value is 1",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("imsi-partition", "Use the i-th of n equal IMSI ranges, given "
+            "as i/n, to run n simulators with distinct IMSIs, e.g. 0/4. A range "
+            "has num-sessions IMSIs, or 1/n of the IMSIs if num-sessions "
+            "is not set",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("imsi-order", "Order of the IMSIs within the range, seq or "
+            "random. random visits each IMSI of the range once. Default "
+            "value is seq",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("teid-shard", "Use the i-th of n TEID shards, given as i/n, "
+            "to run n simulators with distinct TEIDs, e.g. 0/4. The shard "
+            "id is kept in the top bits of the TEIDs",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("teid-quarantine", "Seconds a TEID of a deleted tunnel is not "
+            "reused. Default value is (n3-requests + 1) * t3-timer",
+             cxxopts::value<std::uint32_t>());
         options.add_options()
             ("t3-timer", "GTP retransmission timer (T3 Timer)",
              cxxopts::value<std::uint32_t>());
@@ -89,6 +248,10 @@ int main(int argc, char **argv)
              cxxopts::value<std::string>());
         options.add_options()
             ("disp-summary", "Display summary stats only");
+        options.add_options()
+            ("responder", "Stateless responder mode for waiting scenarios, "
+            "requests are answered from precompiled responses without "
+            "creating UE sessions");
         options.add_options()
             ("pid-file", "Run simulator in backgroud and write PID to file"
             "file to which pid should be written",
@@ -0,0 +1,387 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <linux/mempolicy.h>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT           26
+#endif
+#define GSIM_MAP_HUGE_2MB        (21 << MAP_HUGE_SHIFT)
+#define GSIM_MAP_HUGE_1GB        (30 << MAP_HUGE_SHIFT)
+
+#define GSIM_MEM_ROUNDUP(_len, _align) \
+   (((_len) + (_align) - 1) & ~((U64)(_align) - 1))
+
+static U64        s_pageSize = GSIM_MEM_PAGE_2M; /* 0 if hugepages are off */
+static S32        s_node = -1;         /* local node, -1 if not known */
+static U8         *s_pCur = NULL;      /* free part of current region */
+static U64        s_curLeft = 0;
+static MemPage_t  s_curPage = MEM_PAGE_SMALL;
+static U64        s_curNodeMask = 0;
+static BOOL       s_hugeWarned = FALSE;
+static MemUser_t  s_users[GSIM_MEM_MAX_USERS];
+static U32        s_numUsers = 0;
+
+static const S8   *s_pageStr[MEM_PAGE_MAX] = {"normal", "2M", "1G"};
+
+/**
+ * @brief
+ *    Sets the hugepage size of the arena and the numa node to allocate
+ *    from. Must be called by the scheduler thread after it is pinned to
+ *    its cores, the node of the core it runs on is the local node
+ *
+ * @param pageSize
+ *    GSIM_MEM_PAGE_2M, GSIM_MEM_PAGE_1G or 0 for normal pages
+ */
+PUBLIC VOID initMemArena(U64 pageSize)
+{
+    LOG_ENTERFN();
+
+    s_pageSize = pageSize;
+    s_node     = memLocalNode();
+
+    LOG_INFO("Memory arena, hugepages [%s], numa node [%d]",
+        (GSIM_MEM_PAGE_1G == pageSize) ? "1G" :
+        ((GSIM_MEM_PAGE_2M == pageSize) ? "2M" : "off"), s_node);
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    numa node of the core the calling thread runs on
+ *
+ * @return
+ *    -1 if not known
+ */
+PUBLIC S32 memLocalNode()
+{
+    U32 cpu  = 0;
+    U32 node = 0;
+
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) < 0)
+    {
+        return -1;
+    }
+
+    return (S32)node;
+}
+
+PUBLIC MemUser_t* memRegister(const S8 *name)
+{
+    for (U32 i = 0; i < s_numUsers; i++)
+    {
+        if (0 == STRCMP(s_users[i].name, name))
+        {
+            return &s_users[i];
+        }
+    }
+
+    if (GSIM_MEM_MAX_USERS == s_numUsers)
+    {
+        /* accounted with the last user, only the report is affected */
+        LOG_ERROR("Memory users exceed [%u], [%s]", GSIM_MEM_MAX_USERS, name);
+        return &s_users[GSIM_MEM_MAX_USERS - 1];
+    }
+
+    MemUser_t *pUser = &s_users[s_numUsers++];
+    pUser->name = name;
+
+    return pUser;
+}
+
+PUBLIC U32 memNumUsers()
+{
+    return s_numUsers;
+}
+
+PUBLIC MemUser_t* memGetUser(U32 indx)
+{
+    return &s_users[indx];
+}
+
+/**
+ * @brief
+ *    Maps a region of hugepages of the configured size. If no hugepages
+ *    of the size are reserved, the smaller hugepages and then normal
+ *    pages with transparent hugepages advised are tried
+ *
+ * @param len
+ * @param pLen
+ *    length of the region mapped
+ * @param pPage
+ *    page type of the region
+ *
+ * @return
+ *    NULL if even normal pages could not be mapped
+ */
+PRIVATE U8* mapRegion(U64 len, U64 *pLen, MemPage_t *pPage)
+{
+    LOG_ENTERFN();
+
+    VOID *p = MAP_FAILED;
+    S32  flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (GSIM_MEM_PAGE_1G == s_pageSize)
+    {
+        *pLen  = GSIM_MEM_ROUNDUP(len, GSIM_MEM_PAGE_1G);
+        *pPage = MEM_PAGE_HUGE_1G;
+        p = mmap(NULL, *pLen, PROT_READ | PROT_WRITE,
+            flags | MAP_HUGETLB | GSIM_MAP_HUGE_1GB, -1, 0);
+    }
+
+    if (MAP_FAILED == p && 0 != s_pageSize)
+    {
+        *pLen  = GSIM_MEM_ROUNDUP(len, GSIM_MEM_PAGE_2M);
+        *pPage = MEM_PAGE_HUGE_2M;
+        p = mmap(NULL, *pLen, PROT_READ | PROT_WRITE,
+            flags | MAP_HUGETLB | GSIM_MAP_HUGE_2MB, -1, 0);
+    }
+
+    if (MAP_FAILED == p)
+    {
+        if (0 != s_pageSize && !s_hugeWarned)
+        {
+            LOG_ERROR("No hugepages, using normal pages, [%s]",
+                strerror(errno));
+            s_hugeWarned = TRUE;
+        }
+
+        *pLen  = GSIM_MEM_ROUNDUP(len, GSIM_MEM_PAGE_2M);
+        *pPage = MEM_PAGE_SMALL;
+        p = mmap(NULL, *pLen, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (MAP_FAILED == p)
+        {
+            LOG_ERROR("mmap of [%lu] bytes, [%s]", *pLen, strerror(errno));
+            LOG_EXITFN(NULL);
+        }
+
+        if (0 != s_pageSize)
+        {
+            madvise(p, *pLen, MADV_HUGEPAGE);
+        }
+    }
+
+    LOG_EXITFN((U8 *)p);
+}
+
+/**
+ * @brief
+ *    Places a new region on the local node. The pages are touched here,
+ *    so that they are allocated before the simulation starts and the
+ *    node they are on is known
+ *
+ * @param p
+ * @param len
+ *
+ * @return
+ *    mask of the node of the region, 0 if not known
+ */
+PRIVATE U64 placeRegion(U8 *p, U64 len)
+{
+    LOG_ENTERFN();
+
+    if (s_node >= 0 && s_node < GSIM_MEM_MAX_NODES)
+    {
+        unsigned long nodeMask = 1UL << s_node;
+        if (syscall(SYS_mbind, p, len, MPOL_PREFERRED, &nodeMask,
+                GSIM_MEM_MAX_NODES + 1, 0) < 0)
+        {
+            LOG_DEBUG("mbind() failed, [%s]", strerror(errno));
+        }
+    }
+
+    for (U64 off = 0; off < len; off += GSIM_MEM_PAGE_4K)
+    {
+        p[off] = 0;
+    }
+
+    S32 node = -1;
+    if (syscall(SYS_get_mempolicy, &node, NULL, 0, p,
+            MPOL_F_NODE | MPOL_F_ADDR) < 0 || node < 0 ||
+        node >= GSIM_MEM_MAX_NODES)
+    {
+        LOG_EXITFN(0);
+    }
+
+    LOG_EXITFN(1UL << node);
+}
+
+/**
+ * @brief
+ *    Allocates memory from the arena, cache line aligned and zeroed. An
+ *    allocation is carved from the current region if it fits, else from
+ *    a new region. The memory is never returned to the system, it is
+ *    reused by the pools
+ *
+ * @param pUser
+ *    accounting for the placement report
+ * @param len
+ *
+ * @return
+ *    NULL if memory could not be mapped
+ */
+PUBLIC VOID* memAlloc(MemUser_t *pUser, U64 len)
+{
+    LOG_ENTERFN();
+
+    len = GSIM_MEM_ROUNDUP(len, GSIM_MEM_ALIGN);
+
+    U8        *p        = NULL;
+    MemPage_t page      = s_curPage;
+    U64       nodeMask  = s_curNodeMask;
+
+    if (len <= s_curLeft)
+    {
+        p = s_pCur;
+        s_pCur    += len;
+        s_curLeft -= len;
+    }
+    else
+    {
+        U64 regionLen = 0;
+        p = mapRegion(len, &regionLen, &page);
+        if (NULL == p)
+        {
+            LOG_EXITFN(NULL);
+        }
+
+        nodeMask = placeRegion(p, regionLen);
+
+        /* the region with more space left is used for the next
+         * allocations, so a large table does not waste the current one
+         */
+        if (regionLen - len >= s_curLeft)
+        {
+            s_pCur        = p + len;
+            s_curLeft     = regionLen - len;
+            s_curPage     = page;
+            s_curNodeMask = nodeMask;
+        }
+    }
+
+    pUser->bytes[page] += len;
+    pUser->nodeMask    |= nodeMask;
+
+    LOG_EXITFN(p);
+}
+
+/**
+ * @brief
+ *    Logs the memory taken by each pool and table, with the page size and
+ *    the numa nodes of the memory
+ */
+PUBLIC VOID memReport()
+{
+    LOG_ENTERFN();
+
+    for (U32 i = 0; i < s_numUsers; i++)
+    {
+        MemUser_t *pUser = &s_users[i];
+        for (U32 page = 0; page < MEM_PAGE_MAX; page++)
+        {
+            if (0 != pUser->bytes[page])
+            {
+                LOG_INFO("Memory [%s], [%lu] KB on %s pages, numa node mask "
+                    "[0x%lx]", pUser->name, pUser->bytes[page] >> 10,
+                    s_pageStr[page], pUser->nodeMask);
+            }
+        }
+    }
+
+    LOG_EXITVOID();
+}
+
+MemPool::MemPool(const S8 *name, U32 objSize)
+{
+    m_name    = name;
+    m_pUser   = NULL;
+    m_objSize = GSIM_MEM_ROUNDUP(objSize, sizeof(U64));
+    m_pFree   = NULL;
+    m_inUse   = 0;
+
+    if (m_objSize < sizeof(VOID *))
+    {
+        m_objSize = sizeof(VOID *);
+    }
+}
+
+/**
+ * @brief
+ *    Adds a chunk of objects to the free list. The pool registers with
+ *    the arena on first use, as pools are constructed before main()
+ */
+VOID MemPool::grow()
+{
+    LOG_ENTERFN();
+
+    if (NULL == m_pUser)
+    {
+        m_pUser = memRegister(m_name);
+    }
+
+    U32 numObjs = GSIM_MEM_POOL_CHUNK / m_objSize;
+    U8  *pChunk = (U8 *)memAlloc(m_pUser, (U64)numObjs * m_objSize);
+    if (NULL == pChunk)
+    {
+        LOG_EXITVOID();
+    }
+
+    for (U32 i = numObjs; i > 0; i--)
+    {
+        VOID **pObj = (VOID **)(pChunk + (U64)(i - 1) * m_objSize);
+        *pObj   = m_pFree;
+        m_pFree = pObj;
+    }
+
+    LOG_EXITVOID();
+}
+
+VOID *MemPool::alloc()
+{
+    if (NULL == m_pFree)
+    {
+        grow();
+        if (NULL == m_pFree)
+        {
+            return NULL;
+        }
+    }
+
+    VOID *p = m_pFree;
+    m_pFree = *(VOID **)p;
+    m_inUse++;
+
+    return p;
+}
+
+VOID MemPool::free(VOID *p)
+{
+    *(VOID **)p = m_pFree;
+    m_pFree = p;
+    m_inUse--;
+}
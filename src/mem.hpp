@@ -0,0 +1,130 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MEM_HPP__
+#define __MEM_HPP__
+
+#define GSIM_MEM_PAGE_4K         (1UL << 12)
+#define GSIM_MEM_PAGE_2M         (1UL << 21)
+#define GSIM_MEM_PAGE_1G         (1UL << 30)
+#define GSIM_MEM_POOL_CHUNK      GSIM_MEM_PAGE_2M /* pool growth step */
+#define GSIM_MEM_ALIGN           64               /* cache line */
+#define GSIM_MEM_MAX_USERS       16
+#define GSIM_MEM_MAX_NODES       64
+
+typedef enum
+{
+   MEM_PAGE_SMALL,      /* normal pages, transparent hugepages advised */
+   MEM_PAGE_HUGE_2M,
+   MEM_PAGE_HUGE_1G,
+   MEM_PAGE_MAX
+} MemPage_t;
+
+/* Memory taken from the arena by one pool or table, for the placement
+ * report
+ */
+typedef struct
+{
+   const S8    *name;
+   U64         bytes[MEM_PAGE_MAX];
+   U64         nodeMask;      /* numa nodes the memory is on */
+} MemUser_t;
+
+/* Fixed size objects carved from chunks of the arena. The memory of a
+ * freed object is kept in the pool for the next object, chunks are never
+ * returned to the arena
+ */
+class MemPool
+{
+   public:
+      MemPool(const S8 *name, U32 objSize);
+
+      VOID              *alloc();
+      VOID              free(VOID *p);
+      U64               inUse() { return m_inUse; }
+
+   private:
+      VOID              grow();
+
+      const S8          *m_name;
+      MemUser_t         *m_pUser;
+      U32               m_objSize;
+      VOID              *m_pFree;
+      U64               m_inUse;
+};
+
+/* STL allocator for the nodes of the TEID and IMSI indexes, a node is
+ * allocated from a pool of the node type. Arrays, such as the buckets of
+ * a hash table, are not pooled
+ */
+template <typename T>
+class MemAllocator
+{
+   public:
+      typedef T         value_type;
+
+      MemAllocator() {}
+      template <typename U> MemAllocator(const MemAllocator<U> &) {}
+
+      T *allocate(size_t n)
+      {
+         if (1 != n)
+         {
+            return (T *)::operator new(n * sizeof(T));
+         }
+
+         VOID *p = pool().alloc();
+         if (NULL == p)
+         {
+            throw ERR_MEMORY_ALLOC;
+         }
+
+         return (T *)p;
+      }
+
+      VOID deallocate(T *p, size_t n)
+      {
+         if (1 != n)
+         {
+            ::operator delete(p);
+            return;
+         }
+
+         pool().free(p);
+      }
+
+      template <typename U>
+      bool operator==(const MemAllocator<U> &) const { return true; }
+      template <typename U>
+      bool operator!=(const MemAllocator<U> &) const { return false; }
+
+   private:
+      static MemPool &pool()
+      {
+         static MemPool p("index", sizeof(T));
+         return p;
+      }
+};
+
+EXTERN VOID       initMemArena(U64 pageSize);
+EXTERN MemUser_t* memRegister(const S8 *name);
+EXTERN VOID*      memAlloc(MemUser_t *pUser, U64 len);
+EXTERN VOID       memReport();
+EXTERN U32        memNumUsers();
+EXTERN MemUser_t* memGetUser(U32 indx);
+EXTERN S32        memLocalNode();
+
+#endif
@@ -0,0 +1,457 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+#include "types.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "error.hpp"
+#include "packet_ring.hpp"
+
+#ifndef PACKET_IGNORE_OUTGOING
+#define PACKET_IGNORE_OUTGOING   23
+#endif
+
+/* data of a tx frame follows the frame header, tx has no sockaddr_ll */
+#define GSIM_RING_TX_DATA_OFF    (TPACKET2_HDRLEN - sizeof(struct sockaddr_ll))
+
+PacketRing::PacketRing()
+{
+    m_ifIndex     = 0;
+    m_udpPort     = 0;
+    m_txFd        = -1;
+    m_pTxRing     = NULL;
+    m_txRingLen   = 0;
+    m_txFrameSize = 0;
+    m_txFrameNr   = 0;
+    m_txHead      = 0;
+    m_txMaxLen    = 0;
+    m_txPending   = 0;
+    m_rxFd        = -1;
+    m_pRxRing     = NULL;
+    m_rxRingLen   = 0;
+    m_rxBlock     = 0;
+    m_rxPktsLeft  = 0;
+    m_pRxPkt      = NULL;
+    m_rxHeld      = FALSE;
+    MEMSET(m_macAddr, 0, GSIM_ETH_ADDR_LEN);
+}
+
+PacketRing::~PacketRing()
+{
+    if (NULL != m_pTxRing)
+    {
+        munmap(m_pTxRing, m_txRingLen);
+    }
+
+    if (NULL != m_pRxRing)
+    {
+        munmap(m_pRxRing, m_rxRingLen);
+    }
+
+    if (m_txFd >= 0)
+    {
+        close(m_txFd);
+    }
+
+    if (m_rxFd >= 0)
+    {
+        close(m_rxFd);
+    }
+}
+
+/**
+ * @brief
+ *    Opens the tx and rx rings on the interface
+ *
+ * @param ifName
+ * @param udpPort
+ *    local GTP-U port, only datagrams to this port are received
+ * @param maxFrameLen
+ *    length of the largest frame sent, including ethernet header
+ *
+ * @return
+ */
+RETVAL PacketRing::open(const S8 *ifName, U16 udpPort, U32 maxFrameLen)
+{
+    LOG_ENTERFN();
+
+    m_udpPort = udpPort;
+    m_ifIndex = if_nametoindex(ifName);
+    if (0 == m_ifIndex)
+    {
+        LOG_FATAL("Unknown interface [%s]", ifName);
+        LOG_EXITFN(ERR_SYS_SOCKET_BIND);
+    }
+
+    m_txFd = socket(AF_PACKET, SOCK_RAW, 0);
+    m_rxFd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_IP));
+    if (m_txFd < 0 || m_rxFd < 0)
+    {
+        LOG_FATAL("AF_PACKET socket, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCKET_CREATE);
+    }
+
+    struct ifreq ifr;
+    MEMSET(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, ifName, IFNAMSIZ - 1);
+    if (ioctl(m_txFd, SIOCGIFHWADDR, &ifr) < 0)
+    {
+        LOG_FATAL("Reading MAC address of [%s], [%s]", ifName,
+            strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+    MEMCPY(m_macAddr, ifr.ifr_hwaddr.sa_data, GSIM_ETH_ADDR_LEN);
+
+    /* frames longer than the MTU are rejected by the kernel */
+    if (ioctl(m_txFd, SIOCGIFMTU, &ifr) < 0)
+    {
+        LOG_FATAL("Reading MTU of [%s], [%s]", ifName, strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    if (maxFrameLen > (U32)ifr.ifr_mtu + GSIM_ETH_HDR_LEN)
+    {
+        LOG_FATAL("GTP-U frame length [%u] exceeds MTU [%d] of [%s]",
+            maxFrameLen, ifr.ifr_mtu, ifName);
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    RETVAL ret = setupTxRing(maxFrameLen);
+    if (ROK == ret)
+    {
+        ret = setupRxRing();
+    }
+
+    LOG_EXITFN(ret);
+}
+
+RETVAL PacketRing::setupTxRing(U32 maxFrameLen)
+{
+    LOG_ENTERFN();
+
+    S32 val = TPACKET_V2;
+    if (setsockopt(m_txFd, SOL_PACKET, PACKET_VERSION, &val, sizeof(val)) < 0)
+    {
+        LOG_FATAL("PACKET_VERSION, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    /* a malformed frame is skipped instead of stopping the ring */
+    val = 1;
+    if (setsockopt(m_txFd, SOL_PACKET, PACKET_LOSS, &val, sizeof(val)) < 0)
+    {
+        LOG_INFO("PACKET_LOSS, [%s]", strerror(errno));
+    }
+
+    /* frames are not looped back to the packet sockets of the host and
+     * do not go through the qdisc
+     */
+    if (setsockopt(m_txFd, SOL_PACKET, PACKET_QDISC_BYPASS, &val,
+            sizeof(val)) < 0)
+    {
+        LOG_INFO("PACKET_QDISC_BYPASS, [%s]", strerror(errno));
+    }
+
+    m_txFrameSize = TPACKET_ALIGNMENT;
+    while (m_txFrameSize < GSIM_RING_TX_DATA_OFF + maxFrameLen)
+    {
+        m_txFrameSize <<= 1;
+    }
+
+    struct tpacket_req req;
+    req.tp_block_size = (m_txFrameSize > GSIM_RING_TX_BLOCK_SIZE) ? \
+                        m_txFrameSize : GSIM_RING_TX_BLOCK_SIZE;
+    req.tp_block_nr   = GSIM_RING_TX_MEM / req.tp_block_size;
+    req.tp_frame_size = m_txFrameSize;
+    req.tp_frame_nr   = (req.tp_block_size / m_txFrameSize) * req.tp_block_nr;
+    if (setsockopt(m_txFd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0)
+    {
+        LOG_FATAL("PACKET_TX_RING, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    m_txFrameNr = req.tp_frame_nr;
+    m_txMaxLen  = m_txFrameSize - GSIM_RING_TX_DATA_OFF;
+    m_txRingLen = req.tp_block_size * req.tp_block_nr;
+    m_pTxRing   = (U8 *)mmap(NULL, m_txRingLen, PROT_READ | PROT_WRITE,
+        MAP_SHARED, m_txFd, 0);
+    if (MAP_FAILED == m_pTxRing)
+    {
+        m_pTxRing = NULL;
+        LOG_FATAL("mmap of tx ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    struct sockaddr_ll addr;
+    MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family   = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_IP);
+    addr.sll_ifindex  = m_ifIndex;
+    if (bind(m_txFd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        LOG_FATAL("Binding tx ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCKET_BIND);
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+RETVAL PacketRing::setupRxRing()
+{
+    LOG_ENTERFN();
+
+    S32 val = TPACKET_V3;
+    if (setsockopt(m_rxFd, SOL_PACKET, PACKET_VERSION, &val, sizeof(val)) < 0)
+    {
+        LOG_FATAL("PACKET_VERSION, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    /* outgoing frames are also checked while reading, for older kernels */
+    val = 1;
+    if (setsockopt(m_rxFd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &val,
+            sizeof(val)) < 0)
+    {
+        LOG_INFO("PACKET_IGNORE_OUTGOING, [%s]", strerror(errno));
+    }
+
+    struct tpacket_req3 req;
+    MEMSET(&req, 0, sizeof(req));
+    req.tp_block_size       = GSIM_RING_RX_BLOCK_SIZE;
+    req.tp_block_nr         = GSIM_RING_RX_BLOCK_NR;
+    req.tp_frame_size       = GSIM_RING_RX_FRAME_SIZE;
+    req.tp_frame_nr         = (GSIM_RING_RX_BLOCK_SIZE / \
+                               GSIM_RING_RX_FRAME_SIZE) * GSIM_RING_RX_BLOCK_NR;
+    req.tp_retire_blk_tov   = GSIM_RING_RX_BLOCK_TMO_MS;
+    if (setsockopt(m_rxFd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        LOG_FATAL("PACKET_RX_RING, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    m_rxRingLen = req.tp_block_size * req.tp_block_nr;
+    m_pRxRing   = (U8 *)mmap(NULL, m_rxRingLen, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_LOCKED, m_rxFd, 0);
+    if (MAP_FAILED == m_pRxRing)
+    {
+        m_pRxRing = NULL;
+        LOG_FATAL("mmap of rx ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    struct sockaddr_ll addr;
+    MEMSET(&addr, 0, sizeof(addr));
+    addr.sll_family   = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_IP);
+    addr.sll_ifindex  = m_ifIndex;
+    if (bind(m_rxFd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        LOG_FATAL("Binding rx ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCKET_BIND);
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Returns the data area of the next free tx frame, NULL if the ring is
+ *    full. The frame is sent only after txCommit() and txFlush()
+ */
+U8 *PacketRing::txFrame()
+{
+    U8 *pFrame = m_pTxRing + (m_txHead * m_txFrameSize);
+    struct tpacket2_hdr *pHdr = (struct tpacket2_hdr *)pFrame;
+
+    if (TP_STATUS_AVAILABLE != pHdr->tp_status)
+    {
+        return NULL;
+    }
+
+    return pFrame + GSIM_RING_TX_DATA_OFF;
+}
+
+VOID PacketRing::txCommit(U32 len)
+{
+    struct tpacket2_hdr *pHdr = \
+        (struct tpacket2_hdr *)(m_pTxRing + (m_txHead * m_txFrameSize));
+
+    pHdr->tp_len = len;
+    __sync_synchronize();
+    pHdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+    m_txHead = (m_txHead + 1 == m_txFrameNr) ? 0 : m_txHead + 1;
+    m_txPending++;
+}
+
+VOID PacketRing::txFlush()
+{
+    if (0 == m_txPending)
+    {
+        return;
+    }
+
+    if (send(m_txFd, NULL, 0, MSG_DONTWAIT) < 0 && \
+        EAGAIN != errno && ENOBUFS != errno)
+    {
+        LOG_ERROR("Sending tx ring, [%s]", strerror(errno));
+    }
+
+    m_txPending = 0;
+}
+
+VOID PacketRing::releaseRxBlock()
+{
+    struct tpacket_block_desc *pBlock = (struct tpacket_block_desc *) \
+        (m_pRxRing + (m_rxBlock * GSIM_RING_RX_BLOCK_SIZE));
+
+    __sync_synchronize();
+    pBlock->hdr.bh1.block_status = TP_STATUS_KERNEL;
+
+    m_rxBlock    = (m_rxBlock + 1 == GSIM_RING_RX_BLOCK_NR) ? 0 : m_rxBlock + 1;
+    m_rxHeld     = FALSE;
+    m_rxPktsLeft = 0;
+}
+
+/**
+ * @brief
+ *    Reads upto cnt UDP datagrams to the GTP-U port from the current rx
+ *    block. The datagrams are not copied, they are valid till the next
+ *    call, which returns the block to the kernel once it is read. Frames
+ *    other than IPv4 UDP datagrams to the port are skipped
+ *
+ * @param pMsgs
+ * @param cnt
+ *
+ * @return
+ *    number of datagrams, 0 if no block is ready
+ */
+U32 PacketRing::recvMsgBatch(RecvVec_t *pMsgs, U32 cnt)
+{
+    U32 numRecv = 0;
+
+    while (0 == numRecv)
+    {
+        if (m_rxHeld && 0 == m_rxPktsLeft)
+        {
+            releaseRxBlock();
+        }
+
+        if (!m_rxHeld)
+        {
+            struct tpacket_block_desc *pBlock = (struct tpacket_block_desc *) \
+                (m_pRxRing + (m_rxBlock * GSIM_RING_RX_BLOCK_SIZE));
+
+            if (!(pBlock->hdr.bh1.block_status & TP_STATUS_USER))
+            {
+                break;
+            }
+
+            __sync_synchronize();
+            m_rxHeld     = TRUE;
+            m_rxPktsLeft = pBlock->hdr.bh1.num_pkts;
+            m_pRxPkt     = (U8 *)pBlock + pBlock->hdr.bh1.offset_to_first_pkt;
+        }
+
+        while (m_rxPktsLeft > 0 && numRecv < cnt)
+        {
+            if (ROK == parseFrame(&pMsgs[numRecv]))
+            {
+                numRecv++;
+            }
+        }
+
+        if (0 == numRecv && 0 == m_rxPktsLeft)
+        {
+            continue;
+        }
+
+        break;
+    }
+
+    return numRecv;
+}
+
+/**
+ * @brief
+ *    Moves to the next frame of the rx block, the frame is returned only
+ *    if it is an IPv4 UDP datagram to the GTP-U port. A fragment other
+ *    than the first one is not returned
+ *
+ * @param pMsg
+ *
+ * @return
+ */
+RETVAL PacketRing::parseFrame(RecvVec_t *pMsg)
+{
+    struct tpacket3_hdr *pHdr = (struct tpacket3_hdr *)m_pRxPkt;
+    struct sockaddr_ll  *pSll = (struct sockaddr_ll *) \
+        (m_pRxPkt + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+    U8  *pEth   = m_pRxPkt + pHdr->tp_mac;
+    U32 capLen  = pHdr->tp_snaplen;
+
+    m_pRxPkt += pHdr->tp_next_offset;
+    m_rxPktsLeft--;
+
+    if (PACKET_OUTGOING == pSll->sll_pkttype ||
+        capLen < GSIM_RING_OUTER_HDR_LEN)
+    {
+        return RFAILED;
+    }
+
+    U8  *pTmp      = pEth + 12;
+    U16 etherType  = 0;
+    GSIM_DEC_U16(pTmp, etherType);
+
+    U8  *pIp    = pEth + GSIM_ETH_HDR_LEN;
+    U32 ipHLen  = (pIp[0] & 0x0F) * 4;
+    if (GSIM_ETH_TYPE_IPV4 != etherType || 4 != (pIp[0] >> 4) ||
+        17 != pIp[9] || (pIp[6] & 0x1F) || pIp[7] ||
+        capLen < GSIM_ETH_HDR_LEN + ipHLen + 8)
+    {
+        return RFAILED;
+    }
+
+    U8  *pUdp   = pIp + ipHLen;
+    U16 dstPort = 0;
+    U16 udpLen  = 0;
+    pTmp = pUdp + 2;
+    GSIM_DEC_U16(pTmp, dstPort);
+    pTmp = pUdp + 4;
+    GSIM_DEC_U16(pTmp, udpLen);
+    if (dstPort != m_udpPort || udpLen < 8)
+    {
+        return RFAILED;
+    }
+
+    pMsg->pBuf   = pUdp + 8;
+    pMsg->len    = udpLen - 8;
+    pMsg->bufLen = capLen - GSIM_ETH_HDR_LEN - ipHLen - 8;
+    pMsg->segLen = 0;
+
+    return ROK;
+}
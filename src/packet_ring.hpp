@@ -0,0 +1,87 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PACKET_RING_HPP__
+#define __PACKET_RING_HPP__
+
+#define GSIM_ETH_ADDR_LEN           6
+#define GSIM_ETH_HDR_LEN            14
+#define GSIM_ETH_TYPE_IPV4          0x0800
+
+/* bytes added to a G-PDU on the wire, ethernet, outer IPv4 and UDP */
+#define GSIM_RING_OUTER_HDR_LEN     (GSIM_ETH_HDR_LEN + 20 + 8)
+/* bytes added to an inner packet, GTP-U header with sequence number */
+#define GSIM_RING_GTPU_OVERHEAD     (GSIM_RING_OUTER_HDR_LEN + 12)
+
+#define GSIM_RING_TX_MEM            (8 << 20)   /* bytes of the tx ring */
+#define GSIM_RING_TX_BLOCK_SIZE     (1 << 16)
+#define GSIM_RING_RX_BLOCK_SIZE     (1 << 20)
+#define GSIM_RING_RX_BLOCK_NR       16
+#define GSIM_RING_RX_FRAME_SIZE     2048
+#define GSIM_RING_RX_BLOCK_TMO_MS   1
+
+/* PACKET_MMAP rings on an interface for the GTP-U traffic. Frames are
+ * built by the caller directly in the TPACKET_V2 tx ring and sent with a
+ * single send() call. Received frames are read from TPACKET_V3 blocks,
+ * only the UDP datagrams to the GTP-U port are returned. The datagrams
+ * returned point into the current block, which is handed back to the
+ * kernel on the next receive call
+ */
+class PacketRing
+{
+   public:
+      PacketRing();
+      ~PacketRing();
+
+      RETVAL            open(const S8 *ifName, U16 udpPort, U32 maxFrameLen);
+      S32               rxFd() { return m_rxFd; }
+      const U8*         macAddr() { return m_macAddr; }
+      U32               maxFrameLen() { return m_txMaxLen; }
+
+      U8*               txFrame();
+      VOID              txCommit(U32 len);
+      VOID              txFlush();
+      U32               recvMsgBatch(RecvVec_t *pMsgs, U32 cnt);
+
+   private:
+      RETVAL            setupTxRing(U32 maxFrameLen);
+      RETVAL            setupRxRing();
+      VOID              releaseRxBlock();
+      RETVAL            parseFrame(RecvVec_t *pMsg);
+
+      S32               m_ifIndex;
+      U8                m_macAddr[GSIM_ETH_ADDR_LEN];
+      U16               m_udpPort;
+
+      S32               m_txFd;
+      U8                *m_pTxRing;
+      U32               m_txRingLen;
+      U32               m_txFrameSize;
+      U32               m_txFrameNr;
+      U32               m_txHead;       /* next frame to fill */
+      U32               m_txMaxLen;     /* frame data length */
+      U32               m_txPending;    /* frames not yet flushed */
+
+      S32               m_rxFd;
+      U8                *m_pRxRing;
+      U32               m_rxRingLen;
+      U32               m_rxBlock;      /* current block */
+      U32               m_rxPktsLeft;   /* packets not read in the block */
+      U8                *m_pRxPkt;      /* next packet in the block */
+      BOOL              m_rxHeld;       /* current block is with the user */
+};
+
+#endif
@@ -0,0 +1,223 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "rate_ctrl.hpp"
+
+RateController *RateController::m_pCtrl = NULL;
+
+RateController *RateController::getInstance()
+{
+    try
+    {
+        if (NULL == m_pCtrl)
+        {
+            m_pCtrl = new RateController;
+        }
+    }
+    catch (std::exception &e)
+    {
+        LOG_FATAL("Memory allocation failure, RateController");
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    return m_pCtrl;
+}
+
+/**
+ * @brief
+ *    Constructor, the configured session-rate is the upper limit of the
+ *    controller and the traffic starts at that rate
+ */
+RateController::RateController()
+{
+    Config *pCfg = Config::getInstance();
+
+    m_maxRate    = pCfg->getCallRate();
+    m_rate       = m_maxRate;
+    m_step       = m_maxRate / GSIM_RATE_CTRL_AI_DIVISOR;
+    m_maxLatency = (Time_t)pCfg->getAdaptiveMaxLatency() * 1000;
+    m_holdTime   = 0;
+    m_wakeTime   = getMilliSeconds() + GSIM_RATE_CTRL_INTERVAL_MS;
+    m_decision   = RATE_CTRL_HOLD;
+    m_reason     = "start";
+    m_created    = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED);
+    m_failed     = Stats::getStats(GSIM_STAT_NUM_SESSIONS_FAIL);
+    m_retrans    = Stats::getStats(GSIM_STAT_NUM_RETRANS);
+    m_overload   = Stats::getStats(GSIM_STAT_NUM_OVERLOAD_RSP);
+    m_histIndx   = 0;
+    m_histCount  = 0;
+
+    if (m_step < DFLT_MIN_SESSION_RATE)
+    {
+        m_step = DFLT_MIN_SESSION_RATE;
+    }
+
+    Stats::getHist(GSIM_HIST_SSN_LATENCY_INTVL)->reset();
+}
+
+RateController::~RateController()
+{
+    m_pCtrl = NULL;
+}
+
+RETVAL RateController::run(VOID *arg)
+{
+    LOG_ENTERFN();
+
+    Time_t currTime = getMilliSeconds();
+    if (currTime < m_wakeTime)
+    {
+        pause();
+        LOG_EXITFN(ROK);
+    }
+
+    Counter created  = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED);
+    Counter failed   = Stats::getStats(GSIM_STAT_NUM_SESSIONS_FAIL);
+    Counter retrans  = Stats::getStats(GSIM_STAT_NUM_RETRANS);
+    Counter overload = Stats::getStats(GSIM_STAT_NUM_OVERLOAD_RSP);
+    Histogram *pHist = Stats::getHist(GSIM_HIST_SSN_LATENCY_INTVL);
+    U64 p99          = pHist->percentile(99);
+
+    Counter numCreated  = created - m_created;
+    Counter numRetrans  = retrans - m_retrans;
+
+    m_decision = RATE_CTRL_HOLD;
+    if (currTime < m_holdTime)
+    {
+        m_reason = "backoff";
+    }
+    else if (failed != m_failed)
+    {
+        m_decision = RATE_CTRL_DECREASE;
+        m_reason   = "timeout";
+    }
+    else if (overload != m_overload)
+    {
+        m_decision = RATE_CTRL_DECREASE;
+        m_reason   = "no-resources";
+    }
+    else if (numRetrans * 100 > numCreated * GSIM_RATE_CTRL_MAX_RETRANS)
+    {
+        m_decision = RATE_CTRL_DECREASE;
+        m_reason   = "retransmission";
+    }
+    else if (0 != m_maxLatency && p99 > m_maxLatency)
+    {
+        m_decision = RATE_CTRL_DECREASE;
+        m_reason   = "latency";
+    }
+    else if (m_rate < m_maxRate)
+    {
+        m_decision = RATE_CTRL_INCREASE;
+        m_reason   = "ok";
+    }
+    else
+    {
+        m_reason   = "max-rate";
+    }
+
+    if (RATE_CTRL_DECREASE == m_decision)
+    {
+        setRate((U32)(m_rate * GSIM_RATE_CTRL_MD_FACTOR));
+        m_holdTime = currTime + Config::getInstance()->getT3Timer();
+    }
+    else if (RATE_CTRL_INCREASE == m_decision)
+    {
+        setRate(m_rate + m_step);
+    }
+
+    if (RATE_CTRL_HOLD != m_decision)
+    {
+        LOG_INFO("Rate controller, %s session-rate [%u], %s, sessions [%u] "
+            "retrans [%u] p99 [%llu]us",
+            (RATE_CTRL_DECREASE == m_decision) ? "decreased" : "increased",
+            m_rate, m_reason, numCreated, numRetrans,
+            (unsigned long long)p99);
+    }
+
+    m_rateHist[m_histIndx] = m_rate;
+    m_histIndx = (m_histIndx + 1) % GSIM_RATE_CTRL_HIST_LEN;
+    if (m_histCount < GSIM_RATE_CTRL_HIST_LEN)
+    {
+        m_histCount++;
+    }
+
+    m_created  = created;
+    m_failed   = failed;
+    m_retrans  = retrans;
+    m_overload = overload;
+    pHist->reset();
+
+    m_wakeTime = currTime + GSIM_RATE_CTRL_INTERVAL_MS;
+    pause();
+
+    LOG_EXITFN(ROK);
+}
+
+VOID RateController::setRate(U32 rate)
+{
+    if (rate < DFLT_MIN_SESSION_RATE)
+    {
+        rate = DFLT_MIN_SESSION_RATE;
+    }
+    else if (rate > m_maxRate)
+    {
+        rate = m_maxRate;
+    }
+
+    m_rate = rate;
+    Config::getInstance()->setCallRate(rate);
+}
+
+/**
+ * @brief
+ *    copies the session-rate of the last intervals, oldest first
+ *
+ * @return
+ *    number of rates copied
+ */
+U32 RateController::getRateGraph(U32 *pRates, U32 maxLen)
+{
+    U32 len   = (m_histCount < maxLen) ? m_histCount : maxLen;
+    U32 start = (m_histIndx + GSIM_RATE_CTRL_HIST_LEN - len) % \
+                GSIM_RATE_CTRL_HIST_LEN;
+
+    for (U32 i = 0; i < len; i++)
+    {
+        pRates[i] = m_rateHist[(start + i) % GSIM_RATE_CTRL_HIST_LEN];
+    }
+
+    return len;
+}
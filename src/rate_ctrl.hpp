@@ -0,0 +1,80 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RATE_CTRL_HPP__
+#define __RATE_CTRL_HPP__
+
+#define GSIM_RATE_CTRL_INTERVAL_MS     1000
+#define GSIM_RATE_CTRL_MD_FACTOR       0.5   /* multiplicative decrease */
+#define GSIM_RATE_CTRL_AI_DIVISOR      20    /* additive increase step is
+                                              * max rate / divisor
+                                              */
+#define GSIM_RATE_CTRL_MAX_RETRANS     1     /* percent of requests */
+#define GSIM_RATE_CTRL_HIST_LEN        60    /* intervals in rate graph */
+
+typedef enum
+{
+   RATE_CTRL_HOLD,
+   RATE_CTRL_INCREASE,
+   RATE_CTRL_DECREASE
+} RateCtrlDecision_t;
+
+/* AIMD session-rate controller. Every interval the timeouts,
+ * retransmissions, overload rejections and p99 latency of the interval are
+ * checked. On any sign of overload the session-rate is cut by half, else
+ * it is increased by a fixed step up to the configured session-rate.
+ * After a decrease the controller waits for one T3 time before deciding
+ * again, as the retransmissions caused by the earlier rate lag by T3
+ */
+class RateController: public Task
+{
+   public:
+      static RateController* getInstance();
+      ~RateController();
+
+      RETVAL            run(VOID *arg = NULL);
+      inline Time_t     wake() { return m_wakeTime; }
+
+      U32               getMaxRate() { return m_maxRate; }
+      RateCtrlDecision_t getDecision() { return m_decision; }
+      const S8*         getReason() { return m_reason; }
+      U32               getRateGraph(U32 *pRates, U32 maxLen);
+
+   private:
+      RateController();
+
+      static RateController *m_pCtrl;
+
+      VOID              setRate(U32 rate);
+
+      Time_t            m_wakeTime;
+      Time_t            m_holdTime;     /* no decision before this time */
+      Time_t            m_maxLatency;   /* p99, micro-seconds */
+      U32               m_maxRate;
+      U32               m_rate;
+      U32               m_step;
+      RateCtrlDecision_t m_decision;
+      const S8          *m_reason;
+      Counter           m_created;      /* counters at start of interval */
+      Counter           m_failed;
+      Counter           m_retrans;
+      Counter           m_overload;
+      U32               m_rateHist[GSIM_RATE_CTRL_HIST_LEN];
+      U32               m_histIndx;
+      U32               m_histCount;
+};
+
+#endif
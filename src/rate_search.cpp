@@ -0,0 +1,275 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "keyboard.hpp"
+#include "rate_search.hpp"
+
+static const S8 *s_phaseStr[] = {"ramp", "binary", "done"};
+
+/**
+ * @brief
+ *    Constructor, the search starts from the configured session-rate. The
+ *    warmup time is long enough for a session of the previous step to
+ *    time out after all its retransmissions
+ */
+RateSearch::RateSearch()
+{
+    Config *pCfg = Config::getInstance();
+
+    m_phase      = RATE_SEARCH_PHASE_RAMP;
+    m_stepTime   = pCfg->getSearchStepTime();
+    m_warmupTime = (Time_t)pCfg->getT3Timer() * (pCfg->getN3Requests() + 1);
+    m_passRate   = 0;
+    m_failRate   = 0;
+    m_created    = 0;
+    m_completed  = 0;
+    m_failed     = 0;
+    m_unexpected = 0;
+
+    U32 rate = pCfg->getCallRate();
+    if (rate < DFLT_MIN_SESSION_RATE)
+    {
+        rate = DFLT_MIN_SESSION_RATE;
+    }
+
+    startStep(rate);
+}
+
+RETVAL RateSearch::run(VOID *arg)
+{
+    LOG_ENTERFN();
+
+    if (getMilliSeconds() < m_wakeTime)
+    {
+        pause();
+        LOG_EXITFN(ROK);
+    }
+
+    if (!m_measuring)
+    {
+        startMeasure();
+    }
+    else
+    {
+        endStep();
+    }
+
+    if (RATE_SEARCH_PHASE_DONE == m_phase)
+    {
+        writeReport();
+        Keyboard::key = KB_KEY_SIM_QUIT;
+        stop();
+    }
+    else
+    {
+        pause();
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+VOID RateSearch::startStep(U32 rate)
+{
+    LOG_ENTERFN();
+
+    LOG_INFO("Rate search, %s step, session-rate [%u]", s_phaseStr[m_phase],
+        rate);
+
+    m_rate      = rate;
+    m_measuring = FALSE;
+    m_wakeTime  = getMilliSeconds() + m_warmupTime;
+    Config::getInstance()->setCallRate(rate);
+
+    LOG_EXITVOID();
+}
+
+VOID RateSearch::startMeasure()
+{
+    LOG_ENTERFN();
+
+    m_created    = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED);
+    m_completed  = Stats::getStats(GSIM_STAT_NUM_SESSIONS_SUCC);
+    m_failed     = Stats::getStats(GSIM_STAT_NUM_SESSIONS_FAIL);
+    m_unexpected = Stats::getStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+    Stats::getHist(GSIM_HIST_SSN_LATENCY_INTVL)->reset();
+
+    m_measuring = TRUE;
+    m_wakeTime  = getMilliSeconds() + m_stepTime;
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Checks the measured step against the SLOs and selects the rate of
+ *    the next step. A step without any session completed or failed does
+ *    not pass
+ */
+VOID RateSearch::endStep()
+{
+    LOG_ENTERFN();
+
+    Config    *pCfg  = Config::getInstance();
+    Histogram *pHist = Stats::getHist(GSIM_HIST_SSN_LATENCY_INTVL);
+    RateStep  step;
+
+    step.rate       = m_rate;
+    step.phase      = m_phase;
+    step.created    = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED) - \
+                      m_created;
+    step.completed  = Stats::getStats(GSIM_STAT_NUM_SESSIONS_SUCC) - \
+                      m_completed;
+    step.failed     = Stats::getStats(GSIM_STAT_NUM_SESSIONS_FAIL) - m_failed;
+    step.unexpected = Stats::getStats(GSIM_STAT_UNEXCEPTED_MSG_RECD) - \
+                      m_unexpected;
+    step.p50        = pHist->percentile(50);
+    step.p90        = pHist->percentile(90);
+    step.p99        = pHist->percentile(99);
+    step.p999       = pHist->percentile(99.9);
+    step.max        = pHist->max();
+
+    Counter ended  = step.completed + step.failed;
+    step.failRatio = ended ? (100.0 * step.failed) / ended : 100.0;
+    step.pass      = (0 != ended) &&
+                     (step.failRatio <= pCfg->getSearchMaxFailRatio()) &&
+                     (step.p99 <= (U64)pCfg->getSearchMaxP99() * 1000) &&
+                     (step.unexpected <= pCfg->getSearchMaxUnexp());
+
+    m_steps.push_back(step);
+
+    LOG_INFO("Rate search, session-rate [%u] %s, completed [%u] failed [%u] "
+        "unexpected [%u] p99 [%llu]us", m_rate, step.pass ? "passed" :
+        "failed", step.completed, step.failed, step.unexpected,
+        (unsigned long long)step.p99);
+
+    if (step.pass)
+    {
+        m_passRate = m_rate;
+    }
+    else
+    {
+        m_failRate = m_rate;
+        m_phase    = RATE_SEARCH_PHASE_BINARY;
+    }
+
+    if (RATE_SEARCH_PHASE_RAMP == m_phase)
+    {
+        if (m_rate >= DFLT_MAX_SESSION_RATE)
+        {
+            m_phase = RATE_SEARCH_PHASE_DONE;
+            LOG_EXITVOID();
+        }
+
+        U32 next = m_rate * GSIM_RATE_SEARCH_RAMP_FACTOR;
+        startStep(next < DFLT_MAX_SESSION_RATE ? next : DFLT_MAX_SESSION_RATE);
+        LOG_EXITVOID();
+    }
+
+    U32 resolution = m_passRate / GSIM_RATE_SEARCH_RESOLUTION;
+    if (resolution < 1)
+    {
+        resolution = 1;
+    }
+
+    if (m_failRate - m_passRate <= resolution)
+    {
+        m_phase = RATE_SEARCH_PHASE_DONE;
+        LOG_EXITVOID();
+    }
+
+    startStep(m_passRate + (m_failRate - m_passRate) / 2);
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Writes the knee point and the rate/latency curve of all the steps
+ *    in JSON format
+ */
+VOID RateSearch::writeReport()
+{
+    LOG_ENTERFN();
+
+    Config *pCfg       = Config::getInstance();
+    string  reportFile = pCfg->getSearchReportFile();
+    Time_t  ratePeriod = pCfg->getSessionRatePeriod();
+
+    LOG_INFO("Rate search complete, maximum session-rate [%u]", m_passRate);
+
+    FILE *fp = fopen(reportFile.c_str(), "w");
+    if (NULL == fp)
+    {
+        LOG_ERROR("Opening rate search report file [%s]", reportFile.c_str());
+        LOG_EXITVOID();
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"max_rate\": %u,\n", m_passRate);
+    fprintf(fp, "  \"max_sessions_per_sec\": %.2f,\n",
+        (m_passRate * 1000.0) / ratePeriod);
+    fprintf(fp, "  \"rate_period_ms\": %llu,\n",
+        (unsigned long long)ratePeriod);
+    fprintf(fp, "  \"warmup_ms\": %llu,\n", (unsigned long long)m_warmupTime);
+    fprintf(fp, "  \"step_time_ms\": %llu,\n", (unsigned long long)m_stepTime);
+    fprintf(fp, "  \"slo\": {\"max_fail_percent\": %g, \"max_p99_ms\": %u, "
+        "\"max_unexpected\": %u},\n", pCfg->getSearchMaxFailRatio(),
+        pCfg->getSearchMaxP99(), pCfg->getSearchMaxUnexp());
+    fprintf(fp, "  \"steps\": [\n");
+
+    for (U32 i = 0; i < m_steps.size(); i++)
+    {
+        RateStep *pStep = &m_steps[i];
+        fprintf(fp, "    {\"rate\": %u, \"phase\": \"%s\", \"pass\": %s, "
+            "\"created\": %u, \"completed\": %u, \"failed\": %u, "
+            "\"fail_percent\": %.3f, \"unexpected\": %u, "
+            "\"latency_us\": {\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, "
+            "\"p999\": %llu, \"max\": %llu}}%s\n",
+            pStep->rate, s_phaseStr[pStep->phase],
+            pStep->pass ? "true" : "false", pStep->created, pStep->completed,
+            pStep->failed, pStep->failRatio, pStep->unexpected,
+            (unsigned long long)pStep->p50, (unsigned long long)pStep->p90,
+            (unsigned long long)pStep->p99, (unsigned long long)pStep->p999,
+            (unsigned long long)pStep->max,
+            (i + 1 < m_steps.size()) ? "," : "");
+    }
+
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+    fclose(fp);
+
+    LOG_EXITVOID();
+}
@@ -0,0 +1,87 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RATE_SEARCH_HPP__
+#define __RATE_SEARCH_HPP__
+
+/* search stops when the gap between the passed and failed rate is within
+ * 1/GSIM_RATE_SEARCH_RESOLUTION of the passed rate
+ */
+#define GSIM_RATE_SEARCH_RESOLUTION    50
+#define GSIM_RATE_SEARCH_RAMP_FACTOR   2
+
+typedef enum
+{
+   RATE_SEARCH_PHASE_RAMP,
+   RATE_SEARCH_PHASE_BINARY,
+   RATE_SEARCH_PHASE_DONE
+} RateSearchPhase_t;
+
+/* Result of one session-rate step of the search */
+typedef struct
+{
+   U32               rate;
+   RateSearchPhase_t phase;
+   Counter           created;
+   Counter           completed;
+   Counter           failed;
+   Counter           unexpected;
+   double            failRatio;     /* percent */
+   U64               p50;           /* corrected latency, micro-seconds */
+   U64               p90;
+   U64               p99;
+   U64               p999;
+   U64               max;
+   BOOL              pass;
+} RateStep;
+
+/* Benchmark task searching the maximum session-rate meeting the SLOs.
+ * The rate is doubled until a step fails the SLOs, then binary searched
+ * between the last passed and the first failed rate. Every step is run
+ * for a warmup time, so that the sessions of the previous step are over,
+ * and then measured for the step time
+ */
+class RateSearch: public Task
+{
+   public:
+      RateSearch();
+      ~RateSearch() {}
+
+      RETVAL            run(VOID *arg = NULL);
+      inline Time_t     wake() { return m_wakeTime; }
+
+   private:
+      VOID              startStep(U32 rate);
+      VOID              startMeasure();
+      VOID              endStep();
+      VOID              writeReport();
+
+      RateSearchPhase_t m_phase;
+      BOOL              m_measuring;
+      Time_t            m_wakeTime;
+      Time_t            m_warmupTime;
+      Time_t            m_stepTime;
+      U32               m_rate;
+      U32               m_passRate;     /* highest rate passed the SLOs */
+      U32               m_failRate;     /* lowest rate failed the SLOs */
+      Counter           m_created;      /* counters at start of measure */
+      Counter           m_completed;
+      Counter           m_failed;
+      Counter           m_unexpected;
+      std::vector<RateStep> m_steps;
+};
+
+#endif
@@ -0,0 +1,341 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "scenario.hpp"
+#include "responder.hpp"
+
+Responder *Responder::m_pResponder = NULL;
+
+Responder *Responder::getInstance()
+{
+    try
+    {
+        if (NULL == m_pResponder)
+        {
+            m_pResponder = new Responder;
+        }
+    }
+    catch (std::exception &e)
+    {
+        LOG_FATAL("Memory allocation failure, Responder");
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    return m_pResponder;
+}
+
+Responder::Responder()
+{
+    for (U32 i = 0; i < GSIM_RSP_TMPL_TBL_SIZE; i++)
+    {
+        m_rspTmpl[i] = NULL;
+    }
+}
+
+Responder::~Responder()
+{
+    for (U32 i = 0; i < GSIM_RSP_TMPL_TBL_SIZE; i++)
+    {
+        delete m_rspTmpl[i];
+    }
+
+    m_pResponder = NULL;
+}
+
+/**
+ * @brief
+ *    Precompiles the response message of every request-response procedure
+ *    in the scenario. Wait procedures are not applicable to a responder
+ *    and are ignored
+ *
+ * @param pScn
+ */
+VOID Responder::init(Scenario *pScn)
+{
+    LOG_ENTERFN();
+
+    U32 numProcs = pScn->m_procSeq.size();
+    for (U32 i = 0; i < numProcs; i++)
+    {
+        Procedure *pProc = pScn->m_procSeq[i];
+        if ((PROC_TYPE_WAIT == pProc->type()) ||
+            (NULL == pProc->m_initial) || (NULL == pProc->m_trigMsg) ||
+            (JOB_TYPE_RECV != pProc->m_initial->type()))
+        {
+            continue;
+        }
+
+        compileTemplate(pProc, (0 == i), (numProcs - 1 == i));
+    }
+
+    LOG_EXITVOID();
+}
+
+VOID Responder::compileTemplate(Procedure *pProc, BOOL isScnStart,\
+      BOOL isScnEnd)
+{
+    LOG_ENTERFN();
+
+    GtpMsg       *pReq    = pProc->m_initial->getGtpMsg();
+    GtpMsg       *pRsp    = pProc->m_trigMsg->getGtpMsg();
+    GtpMsgType_t reqType  = pReq->type();
+
+    if (NULL != m_rspTmpl[reqType])
+    {
+        LOG_ERROR("Request [%s] repeated in scenario, only the first "
+            "response is used in responder mode", gtpGetMsgName(reqType));
+        LOG_EXITVOID();
+    }
+
+    RspTemplate *pTmpl = new RspTemplate;
+    MEMSET(pTmpl, 0, sizeof(RspTemplate));
+    pTmpl->pProc      = pProc;
+    pTmpl->isScnStart = isScnStart;
+    pTmpl->isScnEnd   = isScnEnd;
+
+    /* header teid and sequence number are patched per request */
+    GtpMsgHdr msgHdr;
+    msgHdr.teid = 0;
+    msgHdr.seqN = 0;
+    GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_TEID_PRES);
+    GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_SEQ_PRES);
+    pRsp->setMsgHdr(&msgHdr);
+
+    if (GTPC_MSG_CS_RSP == pRsp->type())
+    {
+        RETVAL ret = pRsp->setSenderFteid(0,
+            Config::getInstance()->getLocalIpAddr());
+        if (ROK != ret)
+        {
+            LOG_ERROR("Encoding of sender Fteid Failed");
+            delete pTmpl;
+            throw ret;
+        }
+    }
+
+    pRsp->encode(pTmpl->buf, &pTmpl->len);
+
+    U8  *pIes   = pTmpl->buf + GTP_MSG_HDR_LEN;
+    U32 iesLen  = pTmpl->len - GTP_MSG_HDR_LEN;
+
+    if (GTPC_MSG_CS_RSP == pRsp->type())
+    {
+        U8 *pFteid = gtpFindIe(pIes, iesLen, GTP_IE_FTEID, 0, 1);
+        if (NULL != pFteid)
+        {
+            pTmpl->senderTeidOff = (pFteid - pTmpl->buf) + GTP_IE_HDR_LEN + 1;
+        }
+    }
+
+    /* GTP-U teid of instance 0 fteid in each bearer context */
+    for (U32 i = 1; i <= GTP_MAX_BEARERS; i++)
+    {
+        U8 *pBc = gtpFindIe(pIes, iesLen, GTP_IE_BEARER_CNTXT, 0, i);
+        if (NULL == pBc)
+        {
+            break;
+        }
+
+        GtpLength_t bcLen = 0;
+        GTP_DEC_IE_LEN(pBc, bcLen);
+        U8 *pEbi   = gtpFindIe(pBc + GTP_IE_HDR_LEN, bcLen, GTP_IE_EBI, 0, 1);
+        U8 *pFteid = gtpFindIe(pBc + GTP_IE_HDR_LEN, bcLen, GTP_IE_FTEID, 0, 1);
+        if (NULL != pEbi && NULL != pFteid)
+        {
+            U32 n = pTmpl->numBearers++;
+            GTP_DEC_EBI(pEbi, pTmpl->bearerEbi[n]);
+            pTmpl->bearerTeidOff[n] = (pFteid - pTmpl->buf) + \
+                GTP_IE_HDR_LEN + 1;
+        }
+    }
+
+    m_rspTmpl[reqType] = pTmpl;
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Answers a request using the precompiled response. For the first
+ *    request of the scenario the peer TEID is taken from the sender
+ *    F-TEID, for other requests it is derived from the header TEID.
+ *    Retransmitted requests are answered the same way as new requests
+ *
+ * @param connId
+ * @param pPeerEp
+ * @param pBuf
+ *    received message, not modified
+ * @param len
+ */
+VOID Responder::procGtpcReq(TransConnId connId, IPEndPoint *pPeerEp,\
+      U8 *pBuf, U32 len)
+{
+    LOG_ENTERFN();
+
+    GtpMsgType_t   msgType   = GTPC_MSG_TYPE_INVALID;
+    GtpSeqNumber_t seqNumber = 0;
+    GtpTeid_t      remTeid   = 0;
+    GtpTeid_t      locTeid   = 0;
+    RspTemplate    *pTmpl    = NULL;
+
+    if (len >= GTP_MSG_HDR_LEN && GTP_CHK_T_BIT_PRESENT(pBuf))
+    {
+        GTP_MSG_GET_TYPE(pBuf, msgType);
+        pTmpl = m_rspTmpl[msgType];
+    }
+
+    if (NULL == pTmpl)
+    {
+        LOG_DEBUG("Unexpected GTPC Message received");
+        Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+        LOG_EXITVOID();
+    }
+
+    Procedure *pProc = pTmpl->pProc;
+    GTP_MSG_GET_SEQN(pBuf, seqNumber);
+
+    if (pTmpl->isScnStart)
+    {
+        U8 *pFteid = gtpFindIe(pBuf + GTP_MSG_HDR_LEN, len - GTP_MSG_HDR_LEN,
+            GTP_IE_FTEID, 0, 1);
+        if (NULL == pFteid)
+        {
+            LOG_DEBUG("Sender F-TEID missing");
+            pProc->m_initial->m_numUnexp++;
+            Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+            LOG_EXITVOID();
+        }
+
+        U8 *pTeid = pFteid + GTP_IE_HDR_LEN + 1;
+        GTP_DEC_TEID(pTeid, remTeid);
+        locTeid = deriveLocTeid(remTeid);
+    }
+    else
+    {
+        GTP_MSG_DEC_TEID(pBuf, locTeid);
+        remTeid = deriveRemTeid(locTeid);
+    }
+
+    MEMCPY(m_txBuf, pTmpl->buf, pTmpl->len);
+
+    U8 *pTmp = m_txBuf + 4;
+    GTP_ENC_TEID(pTmp, remTeid);
+    pTmp = m_txBuf + 8;
+    GTP_ENC_SEQN(pTmp, seqNumber);
+
+    if (0 != pTmpl->senderTeidOff)
+    {
+        pTmp = m_txBuf + pTmpl->senderTeidOff;
+        GTP_ENC_TEID(pTmp, locTeid);
+    }
+
+    for (U32 i = 0; i < pTmpl->numBearers; i++)
+    {
+        GtpTeid_t uTeid = deriveBearerTeid(locTeid, pTmpl->bearerEbi[i]);
+        pTmp = m_txBuf + pTmpl->bearerTeidOff[i];
+        GTP_ENC_TEID(pTmp, uTeid);
+    }
+
+    sendMsg(connId, pPeerEp, m_txBuf, pTmpl->len);
+
+    pProc->m_initial->m_numRcv++;
+    pProc->m_trigMsg->m_numSnd++;
+
+    if (pTmpl->isScnStart)
+    {
+        Stats::incStats(GSIM_STAT_NUM_SESSIONS_CREATED);
+    }
+
+    if (pTmpl->isScnEnd)
+    {
+        Stats::incStats(GSIM_STAT_NUM_SESSIONS_SUCC);
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Derives the local control plane TEID from the peer TEID. The mix
+ *    function is a bijection on 32 bit values, so distinct peer TEIDs
+ *    always give distinct local TEIDs and the peer TEID can be recovered
+ *    with deriveRemTeid()
+ *
+ * @param remTeid
+ *
+ * @return
+ */
+GtpTeid_t Responder::deriveLocTeid(GtpTeid_t remTeid)
+{
+    U32 v = remTeid;
+
+    v ^= v >> 16;
+    v *= 0x7feb352dU;
+    v ^= v >> 15;
+    v *= 0x846ca68bU;
+    v ^= v >> 16;
+
+    return v;
+}
+
+/**
+ * @brief
+ *    Inverse of deriveLocTeid()
+ *
+ * @param locTeid
+ *
+ * @return
+ */
+GtpTeid_t Responder::deriveRemTeid(GtpTeid_t locTeid)
+{
+    U32 v = locTeid;
+
+    v ^= v >> 16;
+    v *= 0x43021123U;
+    v ^= (v >> 15) ^ (v >> 30);
+    v *= 0x1d69e2a5U;
+    v ^= v >> 16;
+
+    return v;
+}
+
+GtpTeid_t Responder::deriveBearerTeid(GtpTeid_t locTeid, GtpEbi_t ebi)
+{
+    return deriveLocTeid(locTeid ^ ((U32)ebi << 24));
+}
+
+PUBLIC VOID procGtpcMsgStateless(TransConnId connId, IPEndPoint *pPeerEp,\
+      U8 *pBuf, U32 len)
+{
+    Responder::getInstance()->procGtpcReq(connId, pPeerEp, pBuf, len);
+}
@@ -0,0 +1,73 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RESPONDER_HPP__
+#define __RESPONDER_HPP__
+
+#define GSIM_RSP_TMPL_TBL_SIZE      256   /* one entry per msg type */
+
+/* Precompiled response message of a procedure. The response is encoded
+ * once at startup, for every request only the header fields and the
+ * TEIDs at the recorded offsets are patched
+ */
+typedef struct
+{
+   Procedure      *pProc;
+   BOOL           isScnStart;
+   BOOL           isScnEnd;
+   U8             buf[GTP_MSG_BUF_LEN];
+   U32            len;
+   U32            senderTeidOff;    /* 0 if sender fteid is not encoded */
+   U32            numBearers;
+   U32            bearerTeidOff[GTP_MAX_BEARERS];
+   GtpEbi_t       bearerEbi[GTP_MAX_BEARERS];
+} RspTemplate;
+
+/* Stateless responder for waiting scenarios. No UE session, tunnel or
+ * bearer is created, the local TEIDs are derived from the TEID of the
+ * peer using an invertible mix function. So for any subsequent request
+ * of the UE the peer TEID is recovered from the TEID in the header
+ */
+class Responder
+{
+   public:
+      static Responder* getInstance();
+      ~Responder();
+
+      VOID              init(Scenario *pScn);
+      VOID              procGtpcReq(TransConnId connId, IPEndPoint *pPeerEp,\
+                              U8 *pBuf, U32 len);
+
+      static GtpTeid_t  deriveLocTeid(GtpTeid_t remTeid);
+      static GtpTeid_t  deriveRemTeid(GtpTeid_t locTeid);
+      static GtpTeid_t  deriveBearerTeid(GtpTeid_t locTeid, GtpEbi_t ebi);
+
+   private:
+      Responder();
+
+      static Responder  *m_pResponder;
+
+      VOID              compileTemplate(Procedure *pProc, BOOL isScnStart,\
+                              BOOL isScnEnd);
+
+      RspTemplate       *m_rspTmpl[GSIM_RSP_TMPL_TBL_SIZE];
+      U8                m_txBuf[GTP_MSG_BUF_LEN];
+};
+
+EXTERN VOID procGtpcMsgStateless(TransConnId connId, IPEndPoint *pPeerEp,\
+      U8 *pBuf, U32 len);
+
+#endif
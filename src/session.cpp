@@ -17,11 +17,14 @@
 #include <list>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <new>
 
 #include "types.hpp"
 #include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "gtp_macro.hpp"
 #include "task.hpp"
 #include "timer.hpp"
@@ -39,9 +42,139 @@
 #include "tunnel.hpp"
 #include "traffic.hpp"
 #include "session.hpp"
+#include "dead_call.hpp"
+#include "gtpu_gen.hpp"
+#include "gtpu_sink.hpp"
+
+#define GSIM_UE_CTX_CHUNK_BITS  14  /* UeSessionCtx entries of a chunk */
+#define GSIM_UE_CTX_CHUNK_SIZE  (1U << GSIM_UE_CTX_CHUNK_BITS)
 
 static UeSessionMap s_ueSessionMap;
 static U32          g_sessionId = 0;
+static MemPool      s_ueSessionPool("ue-session", sizeof(UeSession));
+static MemPool      s_pdnPool("gtpc-pdn", sizeof(GtpcPdn));
+static MemPool      s_bearerPool("bearer", sizeof(GtpBearer));
+
+Scenario   *UeSession::s_pScn   = NULL;
+Time_t     UeSession::s_t3time  = 0;
+U32        UeSession::s_n3req   = 0;
+
+/* UeSessionCtx of the sessions indexed by the session id, in chunks from
+ * the memory arena. The ids of deleted sessions are reused, so the table
+ * grows only up to the maximum number of concurrent sessions
+ */
+class UeSessionCtxTable
+{
+    public:
+        UeSessionCtxTable()
+        {
+            m_pUser    = NULL;
+            m_freeId   = 0;
+        }
+
+        inline UeSessionCtx *get(U32 id)
+        {
+            return &m_chunks[id >> GSIM_UE_CTX_CHUNK_BITS]
+                [id & (GSIM_UE_CTX_CHUNK_SIZE - 1)];
+        }
+
+        U32 alloc()
+        {
+            U32 id = m_freeId;
+            if (0 != id)
+            {
+                m_freeId = get(id)->nextFree;
+                return id;
+            }
+
+            /* id 0 is not used */
+            id = ++g_sessionId;
+            if ((id >> GSIM_UE_CTX_CHUNK_BITS) >= m_chunks.size())
+            {
+                if (NULL == m_pUser)
+                {
+                    m_pUser = memRegister("ue-session-ctx");
+                }
+
+                VOID *pChunk = memAlloc(m_pUser,
+                        (U64)sizeof(UeSessionCtx) * GSIM_UE_CTX_CHUNK_SIZE);
+                if (NULL == pChunk)
+                {
+                    g_sessionId--;
+                    throw std::bad_alloc();
+                }
+                m_chunks.push_back((UeSessionCtx *)pChunk);
+            }
+
+            return id;
+        }
+
+        VOID free(U32 id)
+        {
+            get(id)->nextFree = m_freeId;
+            m_freeId = id;
+        }
+
+    private:
+        std::vector<UeSessionCtx *>   m_chunks;
+        MemUser_t                     *m_pUser;
+        U32                           m_freeId;
+};
+
+static UeSessionCtxTable s_ueSsnCtxTbl;
+
+inline UeSessionCtx *UeSession::ctx()
+{
+    return s_ueSsnCtxTbl.get(m_sessionId);
+}
+
+VOID *UeSession::operator new(size_t len)
+{
+    VOID *p = s_ueSessionPool.alloc();
+    if (NULL == p)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+VOID UeSession::operator delete(VOID *p)
+{
+    s_ueSessionPool.free(p);
+}
+
+VOID *GtpcPdn::operator new(size_t len)
+{
+    VOID *p = s_pdnPool.alloc();
+    if (NULL == p)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+VOID GtpcPdn::operator delete(VOID *p)
+{
+    s_pdnPool.free(p);
+}
+
+VOID *GtpBearer::operator new(size_t len)
+{
+    VOID *p = s_bearerPool.alloc();
+    if (NULL == p)
+    {
+        throw std::bad_alloc();
+    }
+
+    return p;
+}
+
+VOID GtpBearer::operator delete(VOID *p)
+{
+    s_bearerPool.free(p);
+}
 
 /**
  * @brief
@@ -51,24 +184,28 @@ static U32          g_sessionId = 0;
  */
 UeSession::UeSession(Scenario *pScn, GtpImsiKey imsi)
 {
-    m_pScn          = pScn;
-    m_retryCnt      = 0;
-    m_sessionId     = ++g_sessionId;
-    m_t3time        = Config::getInstance()->getT3Timer();
-    m_nodeType      = Config::getInstance()->getNodeType();
-    m_n3req         = Config::getInstance()->getN3Requests();
-    m_peerEp.ipAddr = Config::getInstance()->getRemoteIpAddr();
-    m_peerEp.port   = Config::getInstance()->getRemoteGtpcPort();
-    m_bitmask       = 0;
-    m_imsiKey       = imsi;
-    m_bearerVec.reserve(GTP_MAX_BEARERS);
-    m_currProcItr = m_pScn->getFirstProcedure();
-
-    for (U32 i = 0; i < GTP_MAX_BEARERS; i++)
+    if (NULL == s_pScn)
     {
-        m_bearerVec[i] = NULL;
+        s_pScn          = pScn;
+        s_t3time        = Config::getInstance()->getT3Timer();
+        s_n3req         = Config::getInstance()->getN3Requests();
     }
 
+    m_retryCnt    = 0;
+    m_sessionId   = s_ueSsnCtxTbl.alloc();
+    m_bitmask     = 0;
+    m_currRunTime = 0;
+    m_wakeTime    = 0;
+    m_currProcItr = s_pScn->getFirstProcedure();
+
+    UeSessionCtx *pCtx  = new (ctx()) UeSessionCtx;
+    pCtx->imsiKey       = imsi;
+    pCtx->pPdnLst       = NULL;
+    pCtx->intendedStart = 0;
+    pCtx->startTime     = 0;
+    pCtx->pPeer         = getRemotePeer(0);
+    pCtx->sndConnId     = 0;
+
     LOG_DEBUG("Creating UE Session [%d]", m_sessionId);
 }
 
@@ -78,75 +215,117 @@ UeSession::UeSession(Scenario *pScn, GtpImsiKey imsi)
  */
 UeSession::~UeSession()
 {
-    s_ueSessionMap.erase(m_imsiKey);
+    UeSessionCtx *pCtx = ctx();
 
-    if (NULL != m_currProcCache.sentMsg)
-        delete m_currProcCache.sentMsg;
+    s_ueSessionMap.erase(pCtx->imsiKey);
 
-    if (NULL != m_prevProcCache.sentMsg)
-        delete m_prevProcCache.sentMsg;
+    if (GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP))
+    {
+        delPeerTxn(pCtx->pPeer, pCtx->currProcCache.seqNumber, this);
+    }
 
-    for (GtpcPdnLstItr pPdn = m_pdnLst.begin(); pPdn != m_pdnLst.end(); pPdn++)
+    if (0 != pCtx->intendedStart)
     {
-        /* delete the c-plane tunnels */
-        GtpcTun *pCTun = (*pPdn)->pCTun;
-        if (NULL != pCTun)
-        {
-            deleteCTun(pCTun);
-            pCTun = NULL;
-        }
+        /* completed or failed, the slot is free for a new session */
+        TrafficTask::sessionEnded(getMicroSeconds());
+    }
 
-        for (U32 i = 0; i < GTP_MAX_BEARERS; i++)
+    if (NULL != pCtx->currProcCache.sentMsg)
+        delete pCtx->currProcCache.sentMsg;
+
+    if (NULL != pCtx->prevProcCache.sentMsg)
+        delete pCtx->prevProcCache.sentMsg;
+
+    /* a bearer belongs to one of the PDNs of the session */
+    for (U32 i = 0; i < pCtx->bearers.count(); i++)
+    {
+        delete pCtx->bearers.at(i);
+    }
+
+    GtpcPdn *pPdn = pCtx->pPdnLst;
+    while (NULL != pPdn)
+    {
+        /* delete the c-plane tunnels */
+        if (NULL != pPdn->pCTun)
         {
-            GtpBearer *bearer = m_bearerVec[i];
-            if (NULL != bearer)
-            {
-                if (GSIM_CHK_BEARER_MASK((*pPdn)->bearerMask, bearer->getEbi()))
-                {
-                    GSIM_UNSET_BEARER_MASK(
-                        (*pPdn)->bearerMask, bearer->getEbi());
-                    delete bearer;
-                }
-            }
+            deleteCTun(pPdn->pCTun);
         }
 
-        delete *pPdn;
+        GtpcPdn *pNext = pPdn->pNext;
+        delete pPdn;
+        pPdn = pNext;
     }
 
+    pCtx->~UeSessionCtx();
+    s_ueSsnCtxTbl.free(m_sessionId);
+
     LOG_DEBUG("Deleting UE Session [%d]", m_sessionId);
 }
 
+/**
+ * @brief
+ *    sets the time the session was intended to start
+ *
+ * @param t
+ *    micro-seconds
+ */
+VOID UeSession::setIntendedStart(Time_t t)
+{
+    ctx()->intendedStart = t;
+}
+
+/**
+ * @brief
+ *    Sets the remote peer the requests of the session are sent to, by
+ *    default the first remote peer
+ *
+ * @param pPeer
+ */
+VOID UeSession::setPeer(PeerData *pPeer)
+{
+    ctx()->pPeer = pPeer;
+}
+
+/**
+ * @brief
+ *    Sets the socket of the local endpoint the requests of the session
+ *    are sent from, by default the default send socket
+ *
+ * @param connId
+ */
+VOID UeSession::setSender(TransConnId connId)
+{
+    ctx()->sndConnId = connId;
+}
+
+const GtpImsiKey *UeSession::imsiKey()
+{
+    return &ctx()->imsiKey;
+}
+
 RETVAL UeSession::run(VOID *arg)
 {
     RETVAL ret = ROK;
 
     LOG_TRACE("Running UeSession [%d]", m_sessionId);
-    m_lastRunTime = m_currRunTime;
     m_currRunTime = getMilliSeconds();
 
-    if (GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_SCN_COMPLETE))
+    if (NULL != arg)
     {
-        ret = handleDeadCall(arg);
+        LOG_TRACE("Processing Recv() Task");
+        ret = handleRecv((UdpData_t *)arg);
     }
     else
     {
-        if (NULL != arg)
+        if (PROC_TYPE_WAIT == (*m_currProcItr)->type())
         {
-            LOG_TRACE("Processing Recv() Task");
-            ret = handleRecv((UdpData_t *)arg);
+            LOG_TRACE("Processing Wait() Task");
+            ret = handleWait();
         }
         else
         {
-            if (PROC_TYPE_WAIT == (*m_currProcItr)->type())
-            {
-                LOG_TRACE("Processing Wait() Task");
-                ret = handleWait();
-            }
-            else
-            {
-                LOG_TRACE("Processing Send() Task");
-                ret = handleSend();
-            }
+            LOG_TRACE("Processing Send() Task");
+            ret = handleSend();
         }
     }
 
@@ -167,9 +346,10 @@ RETVAL UeSession::handleSend()
         if (ERR_MAX_RETRY_EXCEEDED == ret)
         {
             currProc->m_initial->m_numTimeOut++;
+            Stats::incStats(GSIM_STAT_NUM_TIMEOUTS);
             Stats::incStats(GSIM_STAT_NUM_SESSIONS_FAIL);
-            delete m_currProcCache.sentMsg;
-            m_currProcCache.sentMsg = NULL;
+            delete ctx()->currProcCache.sentMsg;
+            ctx()->currProcCache.sentMsg = NULL;
 
             /* request retry exceeded n3-requests. terminate the
              * UE session Task
@@ -181,7 +361,7 @@ RETVAL UeSession::handleSend()
     {
         GtpMsg *gtpMsg = currProc->m_trigMsg->getGtpMsg();
         ret            = handleOutRspMsg(gtpMsg);
-        if (ROK != ret)
+        if (ROK != ret && ROK_OVER != ret)
         {
             /* sending a response message failed, terminate the Task */
             LOG_ERROR("Sending response message to peer, Error [%d]", ret);
@@ -202,7 +382,7 @@ RETVAL UeSession::handleSend()
             /* update the wakeup time and pause this task until then,
              * for retransmissing the request message
              */
-            m_wakeTime = m_currRunTime + m_t3time;
+            m_wakeTime = m_currRunTime + s_t3time;
             pause();
         }
         else
@@ -224,39 +404,48 @@ RETVAL UeSession::handleOutReqMsg(GtpMsg *gtpMsg)
     GtpcPdn *  pPdn     = NULL;
     Procedure *currProc = *m_currProcItr;
 
+    if (0 == ctx()->startTime)
+    {
+        ctx()->startTime = getMicroSeconds();
+    }
+
     if (GTPC_MSG_CS_REQ == gtpMsg->type())
     {
         LOG_DEBUG("Creating PDN Connection");
         Stats::incStats(GSIM_STAT_NUM_SESSIONS_CREATED);
         Stats::incStats(GSIM_STAT_NUM_SESSIONS);
         pPdn = createPdn();
-        m_pdnLst.push_back(pPdn);
-        m_pCurrPdn = pPdn;
     }
     else
     {
-        pPdn = m_pCurrPdn;
+        pPdn = ctx()->pPdnLst;
     }
 
     LOG_DEBUG("Storing OUT Message");
     createBearers(pPdn, gtpMsg, 0);
 
     LOG_DEBUG("Encoding OUT Message");
-    m_currProcCache.seqNumber = generateSeqNum(&m_peerEp, GTP_MSG_CAT_REQ);
-    m_currProcCache.reqType   = gtpMsg->type();
+    PeerData *pPeer = ctx()->pPeer;
+    ctx()->currProcCache.seqNumber = generateSeqNum(pPeer, GTP_MSG_CAT_REQ);
+    ctx()->currProcCache.reqType   = gtpMsg->type();
+    addPeerTxn(pPeer, ctx()->currProcCache.seqNumber, this);
     UdpData_t *pNwData        = new UdpData_t;
-    encGtpcOutMsg(pPdn, gtpMsg, &pNwData->buf, &m_peerEp);
+    encGtpcOutMsg(pPdn, gtpMsg, &pNwData->buf, &pPeer->peerEp);
 
-    /* initial message, send the message over default send socket */
+    /* initial message, send the message over the socket of the local
+     * endpoint of the session
+     */
     m_retryCnt      = 0;
-    pNwData->connId = 0;
-    pNwData->peerEp = m_peerEp;
+    pNwData->connId = ctx()->sndConnId;
+    pNwData->peerEp = pPeer->peerEp;
 
     LOG_DEBUG("Sending GTPC Message [%s]", gtpGetMsgName(msgType));
     Buffer *buf = new Buffer(pNwData->buf);
+    pNwData->tstamp = getMicroSeconds();
     sendMsg(pNwData->connId, &pNwData->peerEp, buf);
     currProc->m_initial->m_numSnd++;
-    m_currProcCache.sentMsg = pNwData;
+    pPeer->reqSent++;
+    ctx()->currProcCache.sentMsg = pNwData;
     GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP);
 
     LOG_EXITFN(ret);
@@ -279,10 +468,11 @@ RETVAL UeSession::handleOutReqTimeout()
     /* Recived task is run because GTP-C message request timedout
      * waiting for a response, retransmit the request message
      */
-    if (m_retryCnt >= m_n3req)
+    if (m_retryCnt >= s_n3req)
     {
-        delete m_currProcCache.sentMsg;
-        m_currProcCache.sentMsg = NULL;
+        delete ctx()->currProcCache.sentMsg;
+        ctx()->currProcCache.sentMsg = NULL;
+        ctx()->pPeer->timeouts++;
         LOG_DEBUG("Maximum Retries reached");
         ret = ERR_MAX_RETRY_EXCEEDED;
     }
@@ -292,16 +482,23 @@ RETVAL UeSession::handleOutReqTimeout()
          * after retransmission timeout expiry
          */
         LOG_DEBUG("Retransmissing GTP Message");
-        Buffer *buf = new Buffer(m_currProcCache.sentMsg->buf);
-        sendMsg(m_currProcCache.sentMsg->connId,
-            &m_currProcCache.sentMsg->peerEp, buf);
+        Buffer *buf = new Buffer(ctx()->currProcCache.sentMsg->buf);
+        sendMsg(ctx()->currProcCache.sentMsg->connId,
+            &ctx()->currProcCache.sentMsg->peerEp, buf);
 
         currProc->m_initial->m_numSndRetrans++;
+        Stats::incStats(GSIM_STAT_NUM_RETRANS);
+        ctx()->pPeer->retrans++;
         m_retryCnt++;
 
+        /* the response may be to any of the transmissions, so the
+         * response time of the request is not measured
+         */
+        ctx()->currProcCache.sentMsg->tstamp = 0;
+
         // if response is not received within T3 timer expiry
         // wakeup and retransmit request message
-        m_wakeTime = m_currRunTime + m_t3time;
+        m_wakeTime = m_currRunTime + s_t3time;
         pause();
     }
 
@@ -312,18 +509,19 @@ RETVAL UeSession::handleOutRspMsg(GtpMsg *gtpMsg)
 {
     LOG_ENTERFN();
 
-    GtpcPdn *  pPdn     = m_pCurrPdn;
+    GtpcPdn *  pPdn     = ctx()->pPdnLst;
     Procedure *currProc = *m_currProcItr;
 
     LOG_DEBUG("Encoding OUT Message");
     UdpData_t *pNwData = new UdpData_t;
     encGtpcOutMsg(
-        pPdn, currProc->m_trigMsg->getGtpMsg(), &pNwData->buf, &m_peerEp);
+        pPdn, currProc->m_trigMsg->getGtpMsg(), &pNwData->buf,
+        &ctx()->pPeer->peerEp);
 
     /* send the response/triggered message over the same socket
      * over which the request/command is received
      */
-    pNwData->connId = m_currProcCache.connId;
+    pNwData->connId = ctx()->currProcCache.connId;
     pNwData->peerEp = pPdn->pCTun->m_peerEp;
 
     LOG_DEBUG("Sending GTPC Message [%s]", gtpGetMsgName(msgType));
@@ -331,20 +529,20 @@ RETVAL UeSession::handleOutRspMsg(GtpMsg *gtpMsg)
     sendMsg(pNwData->connId, &pNwData->peerEp, buf);
     currProc->m_trigMsg->m_numSnd++;
 
-    delete m_prevProcCache.sentMsg;
-    m_prevProcCache.sentMsg = pNwData;
-    m_prevProcCache.rspType = gtpMsg->type();
-    m_prevProcItr           = m_currProcItr;
+    delete ctx()->prevProcCache.sentMsg;
+    ctx()->prevProcCache.sentMsg = pNwData;
+    ctx()->prevProcCache.rspType = gtpMsg->type();
+    ctx()->prevProcItr           = m_currProcItr;
     GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES);
     GSIM_UNSET_MASK(this->m_bitmask, GSIM_UE_SSN_SEND_RSP);
 
-    if (m_pScn->isScenarioEnd(m_currProcItr))
+    if (s_pScn->isScenarioEnd(m_currProcItr))
     {
         handleCompletedTask();
-        LOG_EXITFN(ROK);
+        LOG_EXITFN(ROK_OVER);
     }
 
-    m_currProcItr = m_pScn->getNextProcedure(m_currProcItr);
+    m_currProcItr = s_pScn->getNextProcedure(m_currProcItr);
     this->stop();
 
     LOG_EXITFN(ROK);
@@ -366,7 +564,7 @@ RETVAL UeSession::handleRecv(UdpData_t *data)
     {
         LOG_DEBUG("Processing Incoming Request message");
         ret = handleIncReqMsg(&gtpMsg, data);
-        if (ROK != ret)
+        if (ROK != ret && ROK_OVER != ret)
         {
             LOG_ERROR("Processing Incoming Request Message, Error [%d]", ret);
         }
@@ -375,7 +573,7 @@ RETVAL UeSession::handleRecv(UdpData_t *data)
     {
         LOG_DEBUG("Processing Incoming Response message");
         ret = handleIncRspMsg(&gtpMsg, data);
-        if (ROK != ret)
+        if (ROK != ret && ROK_OVER != ret)
         {
             LOG_ERROR("Processing Incoming Response Message, Error [%d]", ret);
         }
@@ -396,17 +594,18 @@ RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, UdpData_t *rcvdData)
     else if (isPrevProcReq(rcvdReq))
     {
         /* resend the response message */
-        Buffer *buf = new Buffer(m_prevProcCache.sentMsg->buf);
-        sendMsg(m_prevProcCache.sentMsg->connId,
-            &m_prevProcCache.sentMsg->peerEp, buf);
-        (*m_prevProcItr)->m_initial->m_numRcvRetrans++;
-        (*m_prevProcItr)->m_trigMsg->m_numSndRetrans++;
+        Buffer *buf = new Buffer(ctx()->prevProcCache.sentMsg->buf);
+        sendMsg(ctx()->prevProcCache.sentMsg->connId,
+            &ctx()->prevProcCache.sentMsg->peerEp, buf);
+        (*ctx()->prevProcItr)->m_initial->m_numRcvRetrans++;
+        (*ctx()->prevProcItr)->m_trigMsg->m_numSndRetrans++;
         this->stop();
         LOG_EXITFN(ROK);
     }
     else
     {
         (*m_currProcItr)->m_initial->m_numUnexp++;
+        Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
         this->stop();
         LOG_EXITFN(ROK);
     }
@@ -417,30 +616,29 @@ RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, UdpData_t *rcvdData)
         LOG_DEBUG("Creating PDN Connection");
         Stats::incStats(GSIM_STAT_NUM_SESSIONS_CREATED);
         Stats::incStats(GSIM_STAT_NUM_SESSIONS);
-        pdn        = createPdn();
-        m_pCurrPdn = pdn;
-        m_pdnLst.push_back(pdn);
+        pdn = createPdn();
     }
     else
     {
-        pdn = m_pCurrPdn;
+        pdn = ctx()->pPdnLst;
     }
 
-    m_currProcCache.connId    = rcvdData->connId;
-    m_currProcCache.seqNumber = rcvdReq->seqNumber();
-    m_currProcCache.reqType   = rcvdReq->type();
-    m_prevProcCache.connId    = m_currProcCache.connId;
-    m_prevProcCache.seqNumber = m_currProcCache.seqNumber;
-    m_prevProcCache.reqType   = m_currProcCache.reqType;
+    ctx()->currProcCache.connId    = rcvdData->connId;
+    ctx()->currProcCache.seqNumber = rcvdReq->seqNumber();
+    ctx()->currProcCache.reqType   = rcvdReq->type();
+    ctx()->prevProcCache.connId    = ctx()->currProcCache.connId;
+    ctx()->prevProcCache.seqNumber = ctx()->currProcCache.seqNumber;
+    ctx()->prevProcCache.reqType   = ctx()->currProcCache.reqType;
 
-    updatePeerSeqNumber(&rcvdData->peerEp, m_currProcCache.seqNumber);
     decAndStoreGtpcIncMsg(pdn, rcvdReq, &rcvdData->peerEp);
 
-    /* run the procedure again to send the response */
+    /* run the procedure again to send the response, the session is over
+     * if sending the response failed or completed the scenario
+     */
     GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_SEND_RSP);
-    this->run();
+    RETVAL ret = this->run();
 
-    LOG_EXITFN(ROK);
+    LOG_EXITFN(ret);
 }
 
 BOOL UeSession::isExpectedRsp(GtpMsg *rspMsg)
@@ -452,7 +650,7 @@ BOOL UeSession::isExpectedRsp(GtpMsg *rspMsg)
     GtpMsg *   expectedRspMsg = currProc->m_trigMsg->getGtpMsg();
 
     if ((expectedRspMsg->type() == rspMsg->type()) &&
-        (m_currProcCache.seqNumber == rspMsg->seqNumber()))
+        (ctx()->currProcCache.seqNumber == rspMsg->seqNumber()))
     {
         expected = TRUE;
     }
@@ -467,9 +665,12 @@ BOOL UeSession::isExpectedReq(GtpMsg *reqMsg)
     BOOL       expected = FALSE;
     Procedure *currProc = *m_currProcItr;
 
+    /* the sequence numbers of the requests of a session are not ordered
+     * against the requests sent by the session, so a retransmission is
+     * only told by the sequence number of the previous request
+     */
     GtpMsg *expectedReqMsg = currProc->m_initial->getGtpMsg();
-    if ((expectedReqMsg->type() == reqMsg->type()) &&
-        (m_currProcCache.seqNumber < reqMsg->seqNumber()))
+    if ((expectedReqMsg->type() == reqMsg->type()) && !isPrevProcReq(reqMsg))
     {
         expected = TRUE;
     }
@@ -484,8 +685,8 @@ BOOL UeSession::isPrevProcRsp(GtpMsg *rspMsg)
     BOOL prevProcRsp = FALSE;
 
     if ((GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES)) &&
-        (m_prevProcCache.rspType == rspMsg->type()) &&
-        (m_prevProcCache.seqNumber == rspMsg->seqNumber()))
+        (ctx()->prevProcCache.rspType == rspMsg->type()) &&
+        (ctx()->prevProcCache.seqNumber == rspMsg->seqNumber()))
     {
         prevProcRsp = TRUE;
     }
@@ -500,8 +701,8 @@ BOOL UeSession::isPrevProcReq(GtpMsg *reqMsg)
     BOOL prevProcReq = FALSE;
 
     if ((GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES)) &&
-        (m_prevProcCache.reqType == reqMsg->type()) &&
-        (m_prevProcCache.seqNumber == reqMsg->seqNumber()))
+        (ctx()->prevProcCache.reqType == reqMsg->type()) &&
+        (ctx()->prevProcCache.seqNumber == reqMsg->seqNumber()))
     {
         prevProcReq = TRUE;
     }
@@ -513,50 +714,83 @@ PUBLIC RETVAL UeSession::handleIncRspMsg(GtpMsg *rspMsg, UdpData_t *rcvdData)
 {
     LOG_ENTERFN();
 
+    RETVAL     ret      = ROK;
     Procedure *currProc = *m_currProcItr;
 
     if (isExpectedRsp(rspMsg))
     {
         LOG_DEBUG("Expected response message received");
 
+        PeerData *pPeer = ctx()->pPeer;
         currProc->m_trigMsg->m_numRcv++;
+        pPeer->rspRcvd++;
+        delPeerTxn(pPeer, ctx()->currProcCache.seqNumber, this);
 
-        m_prevProcCache.connId    = rcvdData->connId;
-        m_prevProcCache.seqNumber = m_currProcCache.seqNumber;
-        m_prevProcCache.reqType   = m_currProcCache.reqType;
-        m_prevProcCache.rspType   = rspMsg->type();
+        U8 *pCause = gtpFindIe(rcvdData->buf.pVal + GTP_MSG_HDR_LEN,
+            rcvdData->buf.len - GTP_MSG_HDR_LEN, GTP_IE_CAUSE, 0, 1);
+        if (NULL != pCause)
+        {
+            GtpCause_t cause = pCause[GTP_IE_HDR_LEN];
+            if (GTP_CAUSE_NO_RESOURCES_AVAILABLE == cause ||
+                GTP_CAUSE_APN_CONGESTION == cause)
+            {
+                Stats::incStats(GSIM_STAT_NUM_OVERLOAD_RSP);
+            }
+
+            if (cause >= GTP_CAUSE_REJECTION_MIN)
+            {
+                pPeer->rejected++;
+            }
+        }
+
+        ctx()->prevProcCache.connId    = rcvdData->connId;
+        ctx()->prevProcCache.seqNumber = ctx()->currProcCache.seqNumber;
+        ctx()->prevProcCache.reqType   = ctx()->currProcCache.reqType;
+        ctx()->prevProcCache.rspType   = rspMsg->type();
         GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES);
-        m_prevProcItr = m_currProcItr;
+        ctx()->prevProcItr = m_currProcItr;
 
-        decAndStoreGtpcIncMsg(m_pCurrPdn, rspMsg, &rcvdData->peerEp);
+        decAndStoreGtpcIncMsg(ctx()->pPdnLst, rspMsg, &rcvdData->peerEp);
         GSIM_UNSET_MASK(this->m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP);
 
-        delete m_currProcCache.sentMsg;
-        m_currProcCache.sentMsg = NULL;
+        UdpData_t *pSentMsg = ctx()->currProcCache.sentMsg;
+        if (NULL != pSentMsg && 0 != pSentMsg->tstamp &&
+            rcvdData->tstamp > pSentMsg->tstamp)
+        {
+            Stats::recordLatency(GSIM_HIST_RSP_LATENCY,
+                rcvdData->tstamp - pSentMsg->tstamp);
+            pPeer->rspTimed++;
+            pPeer->rspLatencySum += rcvdData->tstamp - pSentMsg->tstamp;
+        }
+
+        delete ctx()->currProcCache.sentMsg;
+        ctx()->currProcCache.sentMsg = NULL;
 
-        if (m_pScn->isScenarioEnd(m_currProcItr))
+        if (s_pScn->isScenarioEnd(m_currProcItr))
         {
             handleCompletedTask();
+            ret = ROK_OVER;
         }
         else
         {
-            m_currProcItr = m_pScn->getNextProcedure(m_currProcItr);
+            m_currProcItr = s_pScn->getNextProcedure(m_currProcItr);
         }
     }
     else if (isPrevProcRsp(rspMsg))
     {
         /* may be a retransmitted response for previous procedure */
         LOG_DEBUG("Response Message for previous procedure received");
-        (*m_prevProcItr)->m_trigMsg->m_numRcvRetrans++;
+        (*ctx()->prevProcItr)->m_trigMsg->m_numRcvRetrans++;
     }
     else
     {
         /* unexpecte response message received */
         LOG_DEBUG("Unexpected response Message received");
         currProc->m_trigMsg->m_numUnexp++;
+        Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
     }
 
-    LOG_EXITFN(ROK);
+    LOG_EXITFN(ret);
 }
 
 RETVAL UeSession::handleWait()
@@ -569,8 +803,8 @@ RETVAL UeSession::handleWait()
     m_wakeTime = m_currRunTime + currProc->m_wait->wait();
     pause();
 
-    m_prevProcItr = m_currProcItr;
-    m_currProcItr = m_pScn->getNextProcedure(m_currProcItr);
+    ctx()->prevProcItr = m_currProcItr;
+    m_currProcItr = s_pScn->getNextProcedure(m_currProcItr);
 
     LOG_EXITFN(ROK);
 }
@@ -650,6 +884,10 @@ GtpcPdn *UeSession::createPdn()
 
         LOG_DEBUG("Creating GTP-C Tunnel");
         pPdn->pCTun = createCTun(pPdn);
+
+        /* latest PDN at the head, it is the current PDN */
+        pPdn->pNext    = ctx()->pPdnLst;
+        ctx()->pPdnLst = pPdn;
     }
     catch (std::exception &e)
     {
@@ -679,14 +917,19 @@ VOID UeSession::createBearers(
         U32 bearerCnt = pGtpMsg->getBearersToCreate();
         for (U32 i = 1; i <= bearerCnt; i++)
         {
-            GtpIe *pIe = pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, instance, i);
             GtpBearerContext *bearerCntxt =
-                dynamic_cast<GtpBearerContext *>(pIe);
+                pGtpMsg->getIe<GtpBearerContext>(instance, i);
             GtpEbi_t ebi = bearerCntxt->getEbi();
 
+            if (GTP_BEARER_INDEX(ebi) >= GTP_MAX_BEARERS)
+            {
+                LOG_ERROR("Invalid EBI [%d] in Bearer Context", ebi);
+                continue;
+            }
+
             GtpBearer *pBearer = new GtpBearer(pPdn, ebi);
             GSIM_SET_BEARER_MASK(pPdn->bearerMask, ebi);
-            m_bearerVec[GTP_BEARER_INDEX(ebi)] = pBearer;
+            ctx()->bearers.add(pBearer);
         }
     }
 
@@ -704,8 +947,7 @@ VOID UeSession::decAndStoreGtpcIncMsg(
         GtpMsgType_t rcvdMsgTye = pGtpMsg->type();
         if (rcvdMsgTye == GTPC_MSG_CS_REQ || rcvdMsgTye == GTPC_MSG_CS_RSP)
         {
-            GtpFteid *pFteid =
-                dynamic_cast<GtpFteid *>(pGtpMsg->getIe(GTP_IE_FTEID, 0, 1));
+            GtpFteid *pFteid = pGtpMsg->getIe<GtpFteid>(0, 1);
             pPdn->pCTun->m_remTeid = pFteid->getTeid();
         }
 
@@ -717,6 +959,8 @@ VOID UeSession::decAndStoreGtpcIncMsg(
         {
             createBearers(pPdn, pGtpMsg, 0);
         }
+
+        storeRemoteGtpuTeids(pGtpMsg);
     }
     catch (ErrCodeEn &e)
     {
@@ -726,6 +970,35 @@ VOID UeSession::decAndStoreGtpcIncMsg(
     LOG_EXITVOID();
 }
 
+/**
+ * @brief
+ *    Stores the peer GTP-U TEID of the bearers from the instance 0 F-TEID
+ *    in the bearer contexts of a received message
+ *
+ * @param pGtpMsg
+ */
+VOID UeSession::storeRemoteGtpuTeids(GtpMsg *pGtpMsg)
+{
+    LOG_ENTERFN();
+
+    U32 bearerCnt = pGtpMsg->getIeCount(GTP_IE_BEARER_CNTXT, 0);
+    for (U32 i = 1; i <= bearerCnt; i++)
+    {
+        GtpBearerContext *bearerCntxt =
+            pGtpMsg->getIe<GtpBearerContext>(0, i);
+        GtpBearer *       pBearer = this->getBearer(bearerCntxt->getEbi());
+        GtpTeid_t         teid    = 0;
+
+        if (NULL != pBearer && bearerCntxt->getGtpuTeid(&teid, 0) &&
+            0 != teid)
+        {
+            pBearer->setRemoteTeid(teid);
+        }
+    }
+
+    LOG_EXITVOID();
+}
+
 VOID UeSession::encGtpcOutMsg(
     GtpcPdn *pPdn, GtpMsg *pGtpMsg, Buffer *pGtpBuf, IPEndPoint *peerEp)
 {
@@ -737,7 +1010,7 @@ VOID UeSession::encGtpcOutMsg(
     /* Modify the header parameters dynamically */
     GtpMsgHdr msgHdr;
     msgHdr.teid = pPdn->pCTun->m_remTeid;
-    msgHdr.seqN = m_currProcCache.seqNumber;
+    msgHdr.seqN = ctx()->currProcCache.seqNumber;
     GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_TEID_PRES);
     GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_SEQ_PRES);
     pGtpMsg->setMsgHdr(&msgHdr);
@@ -745,7 +1018,7 @@ VOID UeSession::encGtpcOutMsg(
     GtpMsgType_t msgType = pGtpMsg->type();
     if (GTPC_MSG_CS_REQ == msgType)
     {
-        pGtpMsg->setImsi(&m_imsiKey);
+        pGtpMsg->setImsi(&ctx()->imsiKey);
 
         RETVAL ret = pGtpMsg->setSenderFteid(
             pPdn->pCTun->m_locTeid, &pPdn->pCTun->m_localEp.ipAddr);
@@ -770,8 +1043,8 @@ VOID UeSession::encGtpcOutMsg(
     U32 bearerCnt = pGtpMsg->getIeCount(GTP_IE_BEARER_CNTXT, 0);
     for (U32 i = 1; i <= bearerCnt; i++)
     {
-        GtpIe *           pIe = pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, 0, i);
-        GtpBearerContext *bearerCntxt = dynamic_cast<GtpBearerContext *>(pIe);
+        GtpBearerContext *bearerCntxt =
+            pGtpMsg->getIe<GtpBearerContext>(0, i);
         GtpBearer *       pBearer     = this->getBearer(bearerCntxt->getEbi());
         bearerCntxt->setGtpuTeid(pBearer->localTeid(), 0);
     }
@@ -784,65 +1057,69 @@ VOID UeSession::encGtpcOutMsg(
     LOG_EXITVOID();
 }
 
-RETVAL UeSession::handleDeadCall(VOID *arg)
+GtpBearer *UeSession::getBearer(GtpEbi_t ebi)
 {
     LOG_ENTERFN();
 
-    RETVAL ret = ROK;
+    GtpBearer *pBearer = ctx()->bearers.find(ebi);
 
-    if (NULL == arg)
-    {
-        /* Session run invoked because of deadcall timer expiry */
-        if (m_currRunTime >= m_wakeTime)
-        {
-            ret = ROK_OVER;
-            Stats::decStats(GSIM_STAT_NUM_DEADCALLS);
-        }
-    }
-    else
-    {
-        /* A retransmitted message is received for a session whose scenario
-         * is already completed
-         */
-        UdpData_t *data = (UdpData_t *)arg;
-        GtpMsg     rcvdMsg(&data->buf);
+    LOG_EXITFN(pBearer);
+}
 
-        if (isPrevProcReq(&rcvdMsg))
-        {
-            /* resend the request response */
-            Buffer *buf = new Buffer(m_prevProcCache.sentMsg->buf);
-            sendMsg(m_prevProcCache.sentMsg->connId,
-                &m_prevProcCache.sentMsg->peerEp, buf);
-            (*m_prevProcItr)->m_initial->m_numRcvRetrans++;
-            (*m_prevProcItr)->m_trigMsg->m_numSndRetrans++;
-        }
-        else if (isPrevProcRsp(&rcvdMsg))
-        {
-            (*m_prevProcItr)->m_trigMsg->m_numRcvRetrans++;
-        }
-        else
-        {
-            (*m_prevProcItr)->m_initial->m_numUnexp++;
-        }
+GtpcPdn *UeSession::getPdnList()
+{
+    return ctx()->pPdnLst;
+}
 
-        delete data;
-    }
+GtpBearerSet::GtpBearerSet()
+{
+    m_count = 0;
+    m_pMore = NULL;
+    MEMSET(m_inline, 0, sizeof(m_inline));
+}
 
-    LOG_EXITFN(ret);
+GtpBearerSet::~GtpBearerSet()
+{
+    delete [] m_pMore;
 }
 
-GtpBearer *UeSession::getBearer(GtpEbi_t ebi)
+/**
+ * @brief
+ *    adds a bearer, a bearer with the same EBI is replaced and deleted
+ *
+ * @param pBearer
+ */
+VOID GtpBearerSet::add(GtpBearer *pBearer)
 {
-    LOG_ENTERFN();
+    for (U32 i = 0; i < m_count; i++)
+    {
+        if (at(i)->getEbi() == pBearer->getEbi())
+        {
+            delete at(i);
+            at(i) = pBearer;
+            return;
+        }
+    }
 
-    GtpBearer *pBearer = m_bearerVec[GTP_BEARER_INDEX(ebi)];
+    if (m_count == GSIM_UE_INLINE_BEARERS && NULL == m_pMore)
+    {
+        m_pMore = new GtpBearer*[GTP_MAX_BEARERS - GSIM_UE_INLINE_BEARERS];
+    }
 
-    LOG_EXITFN(pBearer);
+    at(m_count++) = pBearer;
 }
 
-GtpcPdnLst *UeSession::getPdnList()
+GtpBearer *GtpBearerSet::find(GtpEbi_t ebi)
 {
-    return &m_pdnLst;
+    for (U32 i = 0; i < m_count; i++)
+    {
+        if (at(i)->getEbi() == ebi)
+        {
+            return at(i);
+        }
+    }
+
+    return NULL;
 }
 
 /**
@@ -856,6 +1133,11 @@ GtpBearer::GtpBearer(GtpcPdn *pPdn, GtpEbi_t ebi)
     m_pPdn  = pPdn;
     m_ebi   = ebi;
     m_pUTun = new GtpuTun;
+
+    if (Config::getInstance()->getGtpuSink())
+    {
+        GtpuSink::getInstance()->addBearer(m_pUTun->localTeid());
+    }
 }
 
 /**
@@ -863,9 +1145,36 @@ GtpBearer::GtpBearer(GtpcPdn *pPdn, GtpEbi_t ebi)
  */
 GtpBearer::~GtpBearer()
 {
+    if (GSIM_GTPU_INV_INDX != m_pUTun->genIndx())
+    {
+        GtpuGen::getInstance()->delBearer(m_pUTun);
+    }
+
+    if (Config::getInstance()->getGtpuSink())
+    {
+        GtpuSink::getInstance()->delBearer(m_pUTun->localTeid());
+    }
+
     delete m_pUTun;
 }
 
+/**
+ * @brief
+ *    Stores the peer GTP-U TEID, user plane traffic is generated on the
+ *    bearer from now on if GTP-U traffic is enabled
+ *
+ * @param teid
+ */
+VOID GtpBearer::setRemoteTeid(GtpTeid_t teid)
+{
+    m_pUTun->setRemoteTeid(teid);
+
+    if (0 != Config::getInstance()->getGtpuRate())
+    {
+        GtpuGen::getInstance()->addBearer(m_pUTun);
+    }
+}
+
 PUBLIC VOID cleanupUeSessions()
 {
     UeSessionMapItr ueItr = s_ueSessionMap.begin();
@@ -879,12 +1188,13 @@ PUBLIC GtpcTun *getS11S4CTun(UeSession *pUeSession)
 {
     LOG_ENTERFN();
 
-    GtpcPdnLst *pPdnLst = pUeSession->getPdnList();
-    GtpcTun *   pCTun   = NULL;
+    GtpcPdn *pPdn  = pUeSession->getPdnList();
+    GtpcTun *pCTun = NULL;
 
-    for (GtpcPdnLstItr b = pPdnLst->begin(); b != pPdnLst->end(); b++)
+    /* the tunnel of the latest PDN */
+    if (NULL != pPdn)
     {
-        pCTun = (*b)->pCTun;
+        pCTun = pPdn->pCTun;
     }
 
     LOG_EXITFN(pCTun);
@@ -898,7 +1208,7 @@ GtpcTun *UeSession::createCTun(GtpcPdn *pPdn)
 
     try
     {
-        GtpIfType_t ifType = m_pScn->ifType();
+        GtpIfType_t ifType = s_pScn->ifType();
         if (GTP_IF_S11_C_MME == ifType)
         {
             pCTun = getS11S4CTun(pPdn->pUeSession);
@@ -937,21 +1247,61 @@ VOID UeSession::handleCompletedTask()
     LOG_ENTERFN();
 
     /* finished processing all messages in the scenario, delete task */
-    LOG_DEBUG("Scenario end for UE, IMSI [%x%x%x%x%x%x%x%x]", m_imsiKey.val[0],
-        m_imsiKey.val[1], m_imsiKey.val[2], m_imsiKey.val[3], m_imsiKey.val[4],
-        m_imsiKey.val[5], m_imsiKey.val[6], m_imsiKey.val[7]);
+    LOG_DEBUG("Scenario end for UE, IMSI [%x%x%x%x%x%x%x%x]", ctx()->imsiKey.val[0],
+        ctx()->imsiKey.val[1], ctx()->imsiKey.val[2], ctx()->imsiKey.val[3], ctx()->imsiKey.val[4],
+        ctx()->imsiKey.val[5], ctx()->imsiKey.val[6], ctx()->imsiKey.val[7]);
 
     Stats::incStats(GSIM_STAT_NUM_SESSIONS_SUCC);
     Stats::decStats(GSIM_STAT_NUM_SESSIONS);
 
-    /* the scenario for this UE session is complete, wait for deal-call
-     * timer expiry to cleanup the sessions. This is required to handle
-     * any delayed or retransmitted response or request messages
+    if (0 != ctx()->startTime)
+    {
+        /* observed latency is from the first message sent, corrected
+         * latency is from the time the session was intended to start, so
+         * the delays in starting the session are not hidden
+         */
+        Time_t currTime = getMicroSeconds();
+        Time_t startTime = ctx()->startTime;
+        if (0 != ctx()->intendedStart && ctx()->intendedStart < startTime)
+        {
+            startTime = ctx()->intendedStart;
+        }
+
+        Stats::recordLatency(GSIM_HIST_SSN_LATENCY, currTime - ctx()->startTime);
+        Stats::recordLatency(GSIM_HIST_SSN_LATENCY_CORRECTED,
+            currTime - startTime);
+        Stats::recordLatency(GSIM_HIST_SSN_LATENCY_INTVL,
+            currTime - startTime);
+    }
+
+    /* the scenario for this UE session is complete, the session is deleted
+     * by the caller. Only a dead-call is kept until the dead-call timer
+     * expiry, to handle any delayed or retransmitted response or request
+     * messages of the last procedure
      */
-    Stats::incStats(GSIM_STAT_NUM_DEADCALLS);
-    GSIM_SET_MASK(m_bitmask, GSIM_UE_SSN_SCN_COMPLETE);
-    m_wakeTime = m_lastRunTime + Config::getInstance()->getDeadCallWait();
-    pause();
+    DeadCall *pDeadCall  = new DeadCall;
+    pDeadCall->teid      = ctx()->pPdnLst->pCTun->m_locTeid;
+    pDeadCall->seqNumber = ctx()->prevProcCache.seqNumber;
+    pDeadCall->reqType   = ctx()->prevProcCache.reqType;
+    pDeadCall->rspType   = ctx()->prevProcCache.rspType;
+    pDeadCall->connId    = ctx()->prevProcCache.connId;
+    pDeadCall->peerEp    = ctx()->pPdnLst->pCTun->m_peerEp;
+    pDeadCall->pProc     = *ctx()->prevProcItr;
+    pDeadCall->pRsp      = NULL;
+    pDeadCall->rspLen    = 0;
+
+    UdpData_t *sentMsg = ctx()->prevProcCache.sentMsg;
+    if (NULL != sentMsg)
+    {
+        /* take over the encoded response instead of copying it */
+        pDeadCall->pRsp   = sentMsg->buf.pVal;
+        pDeadCall->rspLen = sentMsg->buf.len;
+        pDeadCall->peerEp = sentMsg->peerEp;
+        sentMsg->buf.pVal = NULL;
+        sentMsg->buf.len  = 0;
+    }
+
+    DeadCallTable::getInstance()->addDeadCall(pDeadCall);
 
     LOG_EXITVOID();
 }
@@ -32,17 +32,22 @@ struct CompareImsiKey
    }
 };
 
-typedef std::map<GtpImsiKey, UeSession*, CompareImsiKey> UeSessionMap;
+typedef std::map<GtpImsiKey, UeSession*, CompareImsiKey,
+      MemAllocator<std::pair<const GtpImsiKey, UeSession*> > > UeSessionMap;
 typedef std::pair<GtpImsiKey, UeSession*>                UeSessionMapPair;
 typedef UeSessionMap::iterator                           UeSessionMapItr;
 
 class GtpcPdn
 {
    public:
+      static VOID *operator new(size_t len);
+      static VOID operator delete(VOID *p);
+
       GtpcPdn()
       {
          pCTun      = NULL;
          pUeSession = NULL;
+         pNext      = NULL;
          bearerMask = 0;
       }
 
@@ -52,6 +57,7 @@ class GtpcPdn
                             */
 
       UeSession   *pUeSession;
+      GtpcPdn     *pNext;     /* PDN created before this one */
 
       U32         bearerMask; /* bitmask represents a bearer
                                * for e.g. bearer-id = 6, 6th lsb will be
@@ -71,16 +77,41 @@ class GtpBearer
       ~GtpBearer();
       GtpBearer(GtpcPdn*, GtpEbi_t);
 
+      static VOID *operator new(size_t len);
+      static VOID operator delete(VOID *p);
+
       GtpEbi_t  getEbi() {return m_ebi;}
       GtpTeid_t localTeid() {return m_pUTun->localTeid();}
       VOID      setDfltBearer(BOOL b) {m_isDefBearer = b;}
+      VOID      setRemoteTeid(GtpTeid_t teid);
 
 };
 
-typedef std::list<GtpcPdn *>        GtpcPdnLst;
-typedef GtpcPdnLst::iterator        GtpcPdnLstItr;
+/* bearers of a UE session, a UE usually has one or two bearers so the
+ * first GSIM_UE_INLINE_BEARERS are kept inline, an array for the rest is
+ * allocated only when needed
+ */
+#define GSIM_UE_INLINE_BEARERS   2
+class GtpBearerSet
+{
+   public:
+      GtpBearerSet();
+      ~GtpBearerSet();
 
-typedef std::vector<GtpBearer*>     GtpBearerVec;
+      VOID              add(GtpBearer *pBearer);
+      GtpBearer         *find(GtpEbi_t ebi);
+      U32               count() {return m_count;}
+      GtpBearer         *&at(U32 indx)
+      {
+         return (indx < GSIM_UE_INLINE_BEARERS) ? m_inline[indx] :\
+            m_pMore[indx - GSIM_UE_INLINE_BEARERS];
+      }
+
+   private:
+      U32               m_count;
+      GtpBearer         *m_inline[GSIM_UE_INLINE_BEARERS];
+      GtpBearer         **m_pMore;
+};
 
 typedef struct
 {
@@ -92,9 +123,9 @@ typedef struct
 typedef struct _ProcCache_t_
 {
    GtpSeqNumber_t    seqNumber;
+   TransConnId       connId;
    GtpMsgType_t      reqType;
    GtpMsgType_t      rspType;
-   TransConnId       connId;
    UdpData_t         *sentMsg;
 
    _ProcCache_t_()
@@ -104,12 +135,41 @@ typedef struct _ProcCache_t_
    }
 } ProcCache_t;
 
+/* state of a UE session which is not needed for scheduling the session,
+ * kept apart from the UeSession in a table indexed by the session id
+ */
+struct UeSessionCtx
+{
+   GtpImsiKey        imsiKey;
+   U32               nextFree;      /* next free entry of the table */
+   ProcCache_t       prevProcCache;
+   ProcCache_t       currProcCache;
+   ProcedureItr      prevProcItr;
+   GtpcPdn           *pPdnLst;      /* latest PDN first, the current PDN */
+   GtpBearerSet      bearers;
+   Time_t            intendedStart; /* micro-seconds, 0 if the session is
+                                     * not started by traffic task
+                                     */
+   Time_t            startTime;     /* micro-seconds, first msg sent */
+   PeerData          *pPeer;        /* requests are sent to */
+   TransConnId       sndConnId;     /* local endpoint requests are sent
+                                     * from
+                                     */
+};
+
+/* A UE session is a Task, the object holds only the state used when the
+ * session is run, the rest is in the UeSessionCtx of the session id. The
+ * values common to all the sessions are class members
+ */
 class UeSession: public Task
 {
    public:
       UeSession(Scenario *pScn, GtpImsiKey);
       ~UeSession();
 
+      static VOID       *operator new(size_t len);
+      static VOID       operator delete(VOID *p);
+
       RETVAL            run(VOID *arg = NULL);  
       static UeSession  *createUeSession(GtpImsiKey);
       static UeSession  *getUeSession(GtpTeid_t);
@@ -118,35 +178,30 @@ class UeSession: public Task
       VOID              deleteTunnel(GtpTeid_t teid);
       GtpcPdn           *createPdn();
       VOID              deletePdn();
-      GtpcPdnLst        *getPdnList();
-      GtpImsiKey        m_imsiKey;
+      GtpcPdn           *getPdnList();
+      const GtpImsiKey  *imsiKey();
 
       inline Time_t     wake() { return m_wakeTime; }
+      VOID              setIntendedStart(Time_t t);
+      VOID              setPeer(PeerData *pPeer);
+      VOID              setSender(TransConnId connId);
 
    private:
 #define GSIM_UE_SSN_WAITING_FOR_RSP       (1 << 0)
-#define GSIM_UE_SSN_SCN_COMPLETE          (1 << 1)
 #define GSIM_UE_SSN_SEND_RSP              (1 << 2)
 #define GSIM_UE_SSN_PREV_PROC_PRES        (1 << 3)
-      U32               m_bitmask;
-      U32               m_n3req;
-      Time_t            m_t3time;
-      Time_t            m_lastRunTime;
-      Time_t            m_currRunTime;
-      U32               m_retryCnt;
       U32               m_sessionId;
-      IPEndPoint        m_peerEp;
-      EpcNodeType_t     m_nodeType; 
-      GtpcPdnLst        m_pdnLst;     
-      GtpBearerVec      m_bearerVec;
+      U16               m_bitmask;
+      U16               m_retryCnt;
+      Time_t            m_currRunTime;
       Time_t            m_wakeTime;
-      GtpcPdn           *m_pCurrPdn;
-      Scenario          *m_pScn;
-      ProcCache_t       m_prevProcCache;
-      ProcCache_t       m_currProcCache;
       ProcedureItr      m_currProcItr;
-      ProcedureItr      m_prevProcItr;
 
+      static Scenario   *s_pScn;
+      static Time_t     s_t3time;
+      static U32        s_n3req;
+
+      UeSessionCtx      *ctx();
       BOOL              isExpectedRsp(GtpMsg *rspMsg);
       BOOL              isExpectedReq(GtpMsg *rspMsg);
       BOOL              isPrevProcRsp(GtpMsg *rspMsg);
@@ -157,6 +212,7 @@ class UeSession: public Task
                               Buffer *pBuf, IPEndPoint *ep);
       VOID              decAndStoreGtpcIncMsg(GtpcPdn*, GtpMsg*,\
                               const IPEndPoint*);
+      VOID              storeRemoteGtpuTeids(GtpMsg *pGtpMsg);
       GtpBearer*        getBearer(GtpEbi_t ebi);
       GtpcTun*          createCTun(GtpcPdn *pPdn);
       RETVAL            handleSend();
@@ -167,7 +223,6 @@ class UeSession: public Task
       RETVAL            handleOutRspMsg(GtpMsg *gtpMsg);
       RETVAL            handleOutReqMsg(GtpMsg *gtpMsg);
       RETVAL            handleOutReqTimeout();
-      RETVAL            handleDeadCall(VOID *arg);
       VOID              handleCompletedTask();
 };
 
@@ -16,6 +16,13 @@
 
 #include <iostream>
 #include <vector>
+#include <list>
+#include <unordered_map>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <string.h>
+#include <errno.h>
 
 using std::vector;
 
@@ -23,6 +30,7 @@ using std::vector;
 #include "logger.hpp"
 #include "macros.hpp"
 #include "timer.hpp"
+#include "mem.hpp"
 #include "gtp_types.hpp"
 #include "gtp_util.hpp"
 #include "gtp_types.hpp"
@@ -39,6 +47,13 @@ using std::vector;
 #include "display.hpp"
 #include "scenario.hpp"
 #include "gtp_peer.hpp"
+#include "dead_call.hpp"
+#include "responder.hpp"
+#include "rate_search.hpp"
+#include "rate_ctrl.hpp"
+#include "tunnel.hpp"
+#include "gtpu_gen.hpp"
+#include "gtpu_sink.hpp"
 #include "sim.hpp"
 
 EXTERN VOID      cleanupUeSessions();
@@ -80,9 +95,35 @@ VOID Simulator::run(VOID *arg)
 {
     LOG_ENTERFN();
 
+    initLowLatency();
+
+    /* pools and tables are allocated on the node of the pinned cores */
+    initMemArena(Config::getInstance()->getHugePageSize());
+    TaskMgr::init();
+
     m_pScn = Scenario::getInstance();
     m_pScn->init(Config::getInstance()->getScnFile());
 
+    if (Config::getInstance()->getResponderMode())
+    {
+        if (SCN_TYPE_WAITING != m_pScn->getScnType())
+        {
+            LOG_FATAL("Responder mode requires a waiting scenario");
+            LOG_EXITVOID();
+        }
+
+        Responder::getInstance()->init(m_pScn);
+    }
+
+    if ((Config::getInstance()->getFindMaxRate() ||
+         Config::getInstance()->getAdaptiveRate()) &&
+        (SCN_TYPE_INITIATING != m_pScn->getScnType()))
+    {
+        LOG_FATAL("Rate search and adaptive rate require an initiating "
+            "scenario");
+        LOG_EXITVOID();
+    }
+
     /* Creates UDP sockets for listing of gtp messages */
     LOG_DEBUG("Initializing Transport connections");
     if (ROK != initTransport())
@@ -99,6 +140,20 @@ VOID Simulator::run(VOID *arg)
     Display *pDisp = Display::getInstance();
     pDisp->init();
 
+    // Initialing the dead-call table task to expire completed sessions
+    DeadCallTable::getInstance();
+
+    // Initialing the GTP-U generator to send G-PDUs on the bearers
+    if (0 != Config::getInstance()->getGtpuRate())
+    {
+        GtpuGen::getInstance();
+    }
+
+    /* peer information is maintianed to managing sequence numbers
+     * and ordering of message, the remote peers are the first peers
+     */
+    initRemotePeers();
+
     if (SCN_TYPE_INITIATING == m_pScn->getScnType())
     {
         TrafficTask *pTTask = new TrafficTask;
@@ -107,15 +162,20 @@ VOID Simulator::run(VOID *arg)
             LOG_ERROR("Traffic Task Init");
         }
 
-        /* peer information is maintianed to managing sequence numbers
-         * and ordering of message
-         */
-        IPEndPoint peer;
-        peer.ipAddr = Config::getInstance()->getRemoteIpAddr();
-        peer.port   = Config::getInstance()->getRemoteGtpcPort();
-        addPeerData(peer);
+
+        if (Config::getInstance()->getFindMaxRate())
+        {
+            new RateSearch;
+        }
+
+        if (Config::getInstance()->getAdaptiveRate())
+        {
+            RateController::getInstance();
+        }
     }
 
+    memReport();
+
     LOG_DEBUG("Generating Signalling traffic");
     startScheduler();
 
@@ -123,17 +183,98 @@ VOID Simulator::run(VOID *arg)
     TaskMgr::deleteAllTasks();
     deletePeerTable();
 
+    if (Config::getInstance()->getResponderMode())
+    {
+        delete Responder::getInstance();
+    }
+
+    if (Config::getInstance()->getGtpuSink())
+    {
+        delete GtpuSink::getInstance();
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Sets up the scheduler thread for latency measurements, pinned to the
+ *    configured cores, with realtime priority and the TSC clock. This is
+ *    done before the sockets and the sessions are allocated, so that the
+ *    memory is allocated on the node of the cores
+ */
+VOID Simulator::initLowLatency()
+{
+    LOG_ENTERFN();
+
+    Config *pCfg = Config::getInstance();
+
+    const std::vector<U32> &cpus = pCfg->getCpuAffinity();
+    if (!cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (U32 i = 0; i < cpus.size(); i++)
+        {
+            CPU_SET(cpus[i], &cpuSet);
+        }
+
+        S32 ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet),
+            &cpuSet);
+        if (0 != ret)
+        {
+            LOG_ERROR("CPU affinity not set, [%s]", strerror(ret));
+        }
+    }
+
+    if (0 != pCfg->getRtPrio())
+    {
+        struct sched_param param;
+        MEMSET(&param, 0, sizeof(param));
+        param.sched_priority = pCfg->getRtPrio();
+
+        S32 ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (0 != ret)
+        {
+            LOG_ERROR("SCHED_FIFO not set, [%s]", strerror(ret));
+        }
+
+        /* no page faults once running */
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0)
+        {
+            LOG_ERROR("mlockall() failed, [%s]", strerror(errno));
+        }
+    }
+
+    if (pCfg->getBusyPoll() && ROK != initTscClock())
+    {
+        LOG_ERROR("No invariant TSC, using the monotonic clock");
+    }
+
     LOG_EXITVOID();
 }
 
+/**
+ * @brief
+ *    Runs the tasks and reads the sockets, until quit from keyboard. The
+ *    time of the loops which found nothing to do is the idle time of the
+ *    scheduler, it is the headroom left at the current load
+ */
 VOID Simulator::startScheduler()
 {
     bool updateDisplayOnce = true;
 
     LOG_ENTERFN();
 
+    S32    pollWait  = Config::getInstance()->getBusyPoll() ? 0 : 1;
+    Time_t idleStart = getMicroSeconds();
+    Time_t idleTime  = 0;
+
     for (;;)
     {
+        Time_t loopStart = getMicroSeconds();
+        U32    numRun    = 0;
+
         getMilliSeconds();
         if (KB_KEY_SIM_QUIT == Keyboard::key)
         {
@@ -168,6 +309,7 @@ VOID Simulator::startScheduler()
             // it will be paused state which will move the task from running
             // task list to paused task list.
             itr++;
+            numRun++;
             if (ROK != t->run())
             {
                 t->abort();
@@ -177,7 +319,20 @@ VOID Simulator::startScheduler()
         getMilliSeconds();
 
         // read the sockets for keyboard events and gtp messages
-        socketPoll(1);
+        U32    numEvents = socketPoll(pollWait);
+        Time_t loopEnd   = getMicroSeconds();
+        if (0 == numRun && 0 == numEvents)
+        {
+            idleTime += loopEnd - loopStart;
+        }
+
+        if (loopEnd - idleStart >= GSIM_IDLE_SAMPLE_US)
+        {
+            Stats::setStats(GSIM_STAT_SCHED_IDLE_PCT,
+                idleTime * 100 / (loopEnd - idleStart));
+            idleStart = loopEnd;
+            idleTime  = 0;
+        }
     }
 
     LOG_EXITVOID();
@@ -22,6 +22,8 @@ using namespace std;
 #include <cstdio>
 #include <list>
 
+#define GSIM_IDLE_SAMPLE_US      1000000 /* idle ratio sampling period */
+
 class Simulator
 {
    public:
@@ -34,6 +36,7 @@ class Simulator
    private:
       Simulator();
       VOID startScheduler();
+      VOID initLowLatency();
 
       static class Simulator  *pSim;
       class Scenario          *m_pScn;
@@ -27,11 +27,13 @@
 #include <errno.h>
 #include <netdb.h>
 #include <fstream>
+#include <sstream>
 
 #include "types.hpp"
 #include "logger.hpp"
 #include "error.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "help.hpp"
 #include "gtp_types.hpp"
 #include "sim_cfg.hpp"
@@ -68,6 +70,7 @@ Config::Config()
 {
     MEMSET((VOID *)&(locIpAddr), 0, sizeof(IpAddr));
     MEMSET((VOID *)&(remIpAddr), 0, sizeof(IpAddr));
+    MEMSET((VOID *)&(m_gtpuRemIpAddr), 0, sizeof(IpAddr));
     m_imsiStr.assign(DFLT_IMSI, STRLEN(DFLT_IMSI));
     S8 tmp[DFLT_TRACE_MSG_FILE_NAME_LEN] = {'\0'};
     m_maxSessions                        = 0;
@@ -78,8 +81,41 @@ Config::Config()
     dispTimer                            = DFLT_DISP_REFRESH_TIMER;
     dispTarget                           = DISP_TARGET_SCREEN;
     m_dispSummary                        = FALSE;
+    m_responderMode                      = FALSE;
     m_ssnRatePeriod                      = DFLT_SESSION_RATE_PERIOD;
     m_ssnRate                            = DFLT_SESSION_RATE;
+    m_concurrency                        = 0;
+    m_findMaxRate                        = FALSE;
+    m_searchStepTime                     = DFLT_SEARCH_STEP_TIME;
+    m_searchMaxFailRatio                 = DFLT_SEARCH_MAX_FAIL_RATIO;
+    m_searchMaxP99                       = DFLT_SEARCH_MAX_P99;
+    m_searchMaxUnexp                     = DFLT_SEARCH_MAX_UNEXP;
+    m_searchReportFile                   = DFLT_SEARCH_REPORT_FILE;
+    m_adaptiveRate                       = FALSE;
+    m_adaptiveMaxLatency                 = DFLT_ADAPTIVE_MAX_LATENCY;
+    m_gtpuRate                           = 0;
+    m_gtpuPktSize                        = DFLT_GTPU_PKT_SIZE;
+    m_gtpuFlows                          = 1;
+    m_gtpuLocPort                        = DFLT_GTPU_PORT;
+    m_gtpuRemPort                        = DFLT_GTPU_PORT;
+    m_gtpuSink                           = FALSE;
+    m_gtpuOffload                        = FALSE;
+    MEMSET(m_gtpuPeerMac, 0xFF, sizeof(m_gtpuPeerMac));
+    m_transportType                      = TRANSPORT_TYPE_POLL;
+    m_sockRcvBuf                         = DFLT_SOCK_RCVBUF;
+    m_sockSndBuf                         = DFLT_SOCK_SNDBUF;
+    m_timestamps                         = FALSE;
+    m_busyPoll                           = FALSE;
+    m_rtPrio                             = 0;
+    m_hugePageSize                       = GSIM_MEM_PAGE_2M;
+    m_imsiStride                         = 1;
+    m_imsiPartIndx                       = 0;
+    m_imsiPartCnt                        = 1;
+    m_imsiRandom                         = FALSE;
+    m_teidShard                          = 0;
+    m_teidShardCnt                       = 1;
+    m_teidQuarantine                     = DFLT_TEID_QUARANTINE;
+    m_peerSelect                         = PEER_SELECT_RR;
     m_deadCallWait                       = DFLT_DEAD_CALL_WAIT;
     m_scnRunIntvl                        = 1000;
     m_logLevel                           = LOG_LVL_ERROR;
@@ -159,6 +195,12 @@ VOID Config::setConfig(cxxopts::ParseResult options)
         setLocalGtpcPort(value);
     }
 
+    if (options.count("local-endpoints"))
+    {
+        auto value = options["local-endpoints"].as<std::string>();
+        setLocalEndpoints(value);
+    }
+
     if (options.count("remote-ip"))
     {
         auto value = options["remote-ip"].as<std::string>();
@@ -171,6 +213,18 @@ VOID Config::setConfig(cxxopts::ParseResult options)
         setRemoteGtpcPort(value);
     }
 
+    if (options.count("remote-peers"))
+    {
+        auto value = options["remote-peers"].as<std::string>();
+        setRemotePeers(value);
+    }
+
+    if (options.count("peer-select"))
+    {
+        auto value = options["peer-select"].as<std::string>();
+        setPeerSelect(value);
+    }
+
     if (options.count("num-sessions"))
     {
         auto value = options["num-sessions"].as<std::uint32_t>();
@@ -189,90 +243,821 @@ VOID Config::setConfig(cxxopts::ParseResult options)
         setRatePeriod(value);
     }
 
-    if (options.count("t3-timer"))
-    {
-        auto value = options["t3-timer"].as<std::uint32_t>();
-        setT3TimerSeconds(value);
+    if (options.count("concurrency"))
+    {
+        auto value = options["concurrency"].as<std::uint32_t>();
+        setConcurrency(value);
+    }
+
+    if (options.count("find-max-rate"))
+    {
+        setFindMaxRate(TRUE);
+    }
+
+    if (options.count("search-step-time"))
+    {
+        auto value = options["search-step-time"].as<std::uint32_t>();
+        setSearchStepTime(value);
+    }
+
+    if (options.count("search-max-fail"))
+    {
+        auto value = options["search-max-fail"].as<double>();
+        setSearchMaxFailRatio(value);
+    }
+
+    if (options.count("search-max-p99"))
+    {
+        auto value = options["search-max-p99"].as<std::uint32_t>();
+        setSearchMaxP99(value);
+    }
+
+    if (options.count("search-max-unexp"))
+    {
+        auto value = options["search-max-unexp"].as<std::uint32_t>();
+        setSearchMaxUnexp(value);
+    }
+
+    if (options.count("search-report"))
+    {
+        auto value = options["search-report"].as<std::string>();
+        setSearchReportFile(value);
+    }
+
+    if (getFindMaxRate() && (0 != getConcurrency() || 0 != getNumSessions()))
+    {
+        throw GsimError("Argument 'find-max-rate' can not be used with "
+            "'concurrency' or 'num-sessions'");
+    }
+
+    if (options.count("adaptive-rate"))
+    {
+        setAdaptiveRate(TRUE);
+    }
+
+    if (options.count("adaptive-max-latency"))
+    {
+        auto value = options["adaptive-max-latency"].as<std::uint32_t>();
+        setAdaptiveMaxLatency(value);
+    }
+
+    if (getAdaptiveRate() && (0 != getConcurrency() || getFindMaxRate()))
+    {
+        throw GsimError("Argument 'adaptive-rate' can not be used with "
+            "'concurrency' or 'find-max-rate'");
+    }
+
+    if (options.count("gtpu-rate"))
+    {
+        auto value = options["gtpu-rate"].as<std::uint32_t>();
+        setGtpuRate(value);
+    }
+
+    if (options.count("gtpu-size"))
+    {
+        auto value = options["gtpu-size"].as<std::string>();
+        setGtpuPktSize(value);
+    }
+
+    if (options.count("gtpu-flows"))
+    {
+        auto value = options["gtpu-flows"].as<std::uint32_t>();
+        setGtpuFlows(value);
+    }
+
+    if (options.count("gtpu-local-port"))
+    {
+        auto value = options["gtpu-local-port"].as<std::uint16_t>();
+        setGtpuLocalPort(value);
+    }
+
+    if (options.count("gtpu-remote-port"))
+    {
+        auto value = options["gtpu-remote-port"].as<std::uint16_t>();
+        setGtpuRemotePort(value);
+    }
+
+    if (options.count("gtpu-remote-ip"))
+    {
+        auto value = options["gtpu-remote-ip"].as<std::string>();
+        setGtpuRemoteIpAddr(value);
+    }
+
+    if (options.count("gtpu-sink"))
+    {
+        setGtpuSink(TRUE);
+    }
+
+    if (options.count("gtpu-iface"))
+    {
+        auto value = options["gtpu-iface"].as<std::string>();
+        setGtpuIface(value);
+    }
+
+    if (options.count("gtpu-peer-mac"))
+    {
+        auto value = options["gtpu-peer-mac"].as<std::string>();
+        setGtpuPeerMac(value);
+    }
+
+    if (options.count("gtpu-offload"))
+    {
+        setGtpuOffload(TRUE);
+    }
+
+    if (options.count("transport"))
+    {
+        auto value = options["transport"].as<std::string>();
+        setTransportType(value);
+    }
+
+    if (options.count("sock-rcvbuf"))
+    {
+        auto value = options["sock-rcvbuf"].as<std::uint32_t>();
+        setSockRcvBuf(value);
+    }
+
+    if (options.count("sock-sndbuf"))
+    {
+        auto value = options["sock-sndbuf"].as<std::uint32_t>();
+        setSockSndBuf(value);
+    }
+
+    if (options.count("timestamps"))
+    {
+        setTimestamps(TRUE);
+    }
+
+    if (options.count("busy-poll"))
+    {
+        setBusyPoll(TRUE);
+    }
+
+    if (options.count("cpu-affinity"))
+    {
+        auto value = options["cpu-affinity"].as<std::string>();
+        setCpuAffinity(value);
+    }
+
+    if (options.count("rt-prio"))
+    {
+        auto value = options["rt-prio"].as<std::uint32_t>();
+        setRtPrio(value);
+    }
+
+    if (options.count("hugepages"))
+    {
+        auto value = options["hugepages"].as<std::string>();
+        setHugePages(value);
+    }
+
+    if (options.count("imsi"))
+    {
+        auto value = options["imsi"].as<std::string>();
+        setImsi(value.c_str(), value.size());
+    }
+
+    if (options.count("imsi-stride"))
+    {
+        auto value = options["imsi-stride"].as<std::uint32_t>();
+        setImsiStride(value);
+    }
+
+    if (options.count("imsi-partition"))
+    {
+        auto value = options["imsi-partition"].as<std::string>();
+        setImsiPartition(value);
+    }
+
+    if (options.count("imsi-order"))
+    {
+        auto value = options["imsi-order"].as<std::string>();
+        setImsiOrder(value);
+    }
+
+    if (options.count("teid-shard"))
+    {
+        auto value = options["teid-shard"].as<std::string>();
+        setTeidShard(value);
+    }
+
+    if (options.count("teid-quarantine"))
+    {
+        auto value = options["teid-quarantine"].as<std::uint32_t>();
+        setTeidQuarantine(value);
+    }
+
+    if (options.count("t3-timer"))
+    {
+        auto value = options["t3-timer"].as<std::uint32_t>();
+        setT3TimerSeconds(value);
+    }
+
+    if (options.count("n3-requests"))
+    {
+        auto value = options["n3-requests"].as<std::uint32_t>();
+        setN3Requests(value);
+    }
+
+    if (options.count("disp-timer"))
+    {
+        auto value = options["disp-timer"].as<std::uint32_t>();
+        setDisplayRefreshTimer(value);
+    }
+
+    if (options.count("disp-target"))
+    {
+        auto value = options["disp-target"].as<std::uint32_t>();
+        setDisplayTarget((DisplayTargetEn)value);
+    }
+
+    if (options.count("disp-target-file"))
+    {
+        auto value = options["disp-target-file"].as<std::string>();
+        setDisplayTargetFile(value);
+    }
+
+    if ((getDisplayTarget() == DISP_TARGET_FILE) && getDisplayTargetFile().empty())
+    {
+        throw GsimError("Must specify argument 'disp-target-file' when 'disp-target' is file");
+    }
+
+    if (options.count("disp-summary"))
+    {
+        setDisplaySummary(TRUE);
+    }
+
+    if (options.count("responder"))
+    {
+        setResponderMode(TRUE);
+    }
+
+    if (options.count("error-file"))
+    {
+        auto value = options["error-file"].as<std::string>();
+        setErrorFile(value);
+    }
+
+    if (options.count("log-file"))
+    {
+        auto value = options["log-file"].as<std::string>();
+        setLogFile(value);
+    }
+
+    if (options.count("log-level"))
+    {
+        auto value = options["log-level"].as<std::uint32_t>();
+        setLogLevel(value);
+    }
+
+    if (options.count("pid-file"))
+    {
+        auto value = options["pid-file"].as<std::string>();
+        setPidFile(value);
+    }
+
+    if (options.count("timeout"))
+    {
+        auto value = options["timeout"].as<std::uint32_t>();
+        setTimeout(value);
+    }
+}
+
+VOID Config::setNoOfCalls(U32 n)
+{
+    pCfg->m_maxSessions = n;
+}
+
+VOID Config::setCallRate(U32 n)
+{
+    pCfg->m_ssnRate = n;
+}
+
+VOID Config::setRatePeriod(U32 n)
+{
+    pCfg->m_ssnRatePeriod = n;
+}
+
+VOID Config::setConcurrency(U32 n)
+{
+    m_concurrency = n;
+}
+
+VOID Config::setFindMaxRate(BOOL val)
+{
+    m_findMaxRate = val;
+}
+
+VOID Config::setSearchStepTime(U32 n)
+{
+    m_searchStepTime = n;
+}
+
+VOID Config::setSearchMaxFailRatio(double val)
+{
+    m_searchMaxFailRatio = val;
+}
+
+VOID Config::setSearchMaxP99(U32 n)
+{
+    m_searchMaxP99 = n;
+}
+
+VOID Config::setSearchMaxUnexp(U32 n)
+{
+    m_searchMaxUnexp = n;
+}
+
+VOID Config::setSearchReportFile(string filename)
+{
+    m_searchReportFile = filename;
+}
+
+VOID Config::setAdaptiveRate(BOOL val)
+{
+    m_adaptiveRate = val;
+}
+
+VOID Config::setAdaptiveMaxLatency(U32 n)
+{
+    m_adaptiveMaxLatency = n;
+}
+
+VOID Config::setGtpuRate(U32 n)
+{
+    m_gtpuRate = n;
+}
+
+/**
+ * @brief
+ *    inner IP packet length of G-PDUs, a fixed length in bytes or "imix"
+ *
+ * @param size
+ */
+VOID Config::setGtpuPktSize(string size)
+{
+    if (0 == STRCASECMP(size.c_str(), "imix"))
+    {
+        m_gtpuPktSize = DFLT_GTPU_PKT_SIZE_IMIX;
+        return;
+    }
+
+    U32 len = (U32)atoi(size.c_str());
+    if (len < DFLT_GTPU_MIN_PKT_SIZE || len > DFLT_GTPU_MAX_PKT_SIZE)
+    {
+        throw GsimError("Invalid GTP-U packet size, must be imix or "
+            "between " + std::to_string(DFLT_GTPU_MIN_PKT_SIZE) + " and " +
+            std::to_string(DFLT_GTPU_MAX_PKT_SIZE));
+    }
+
+    m_gtpuPktSize = len;
+}
+
+VOID Config::setGtpuFlows(U32 n)
+{
+    if (0 == n)
+    {
+        throw GsimError("Invalid GTP-U flows, must be at least 1");
+    }
+
+    m_gtpuFlows = n;
+}
+
+VOID Config::setGtpuLocalPort(U16 port)
+{
+    m_gtpuLocPort = port;
+}
+
+VOID Config::setGtpuRemotePort(U16 port)
+{
+    m_gtpuRemPort = port;
+}
+
+VOID Config::setGtpuRemoteIpAddr(string ip)
+{
+    if (RFAILED == saveIp(ip, &m_gtpuRemIpAddr))
+    {
+        throw GsimError("Invalid GTP-U Remote IP Address");
+    }
+}
+
+VOID Config::setGtpuSink(BOOL val)
+{
+    m_gtpuSink = val;
+}
+
+VOID Config::setGtpuOffload(BOOL val)
+{
+    m_gtpuOffload = val;
+}
+
+VOID Config::setGtpuIface(string ifName)
+{
+    m_gtpuIface = ifName;
+}
+
+VOID Config::setGtpuPeerMac(string mac)
+{
+    U32 b[DFLT_MAC_ADDR_LEN];
+    S8  extra;
+
+    if (DFLT_MAC_ADDR_LEN != sscanf(mac.c_str(), "%x:%x:%x:%x:%x:%x%c",
+            &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &extra))
+    {
+        throw GsimError("Invalid GTP-U peer MAC address " + mac);
+    }
+
+    for (U32 i = 0; i < DFLT_MAC_ADDR_LEN; i++)
+    {
+        if (b[i] > 0xFF)
+        {
+            throw GsimError("Invalid GTP-U peer MAC address " + mac);
+        }
+        m_gtpuPeerMac[i] = b[i];
+    }
+}
+
+VOID Config::setTransportType(string type)
+{
+    if (0 == STRCASECMP(type.c_str(), "poll"))
+    {
+        m_transportType = TRANSPORT_TYPE_POLL;
+    }
+    else if (0 == STRCASECMP(type.c_str(), "mmsg"))
+    {
+        m_transportType = TRANSPORT_TYPE_MMSG;
+    }
+    else if (0 == STRCASECMP(type.c_str(), "uring"))
+    {
+        m_transportType = TRANSPORT_TYPE_URING;
+    }
+    else
+    {
+        throw GsimError("Invalid transport " + type + ", must be poll, "
+            "mmsg or uring");
+    }
+}
+
+VOID Config::setHugePages(string size)
+{
+    if (0 == STRCASECMP(size.c_str(), "off"))
+    {
+        m_hugePageSize = 0;
+    }
+    else if (0 == STRCASECMP(size.c_str(), "2M"))
+    {
+        m_hugePageSize = GSIM_MEM_PAGE_2M;
+    }
+    else if (0 == STRCASECMP(size.c_str(), "1G"))
+    {
+        m_hugePageSize = GSIM_MEM_PAGE_1G;
+    }
+    else
+    {
+        throw GsimError("Invalid hugepages " + size + ", must be off, 2M "
+            "or 1G");
+    }
+}
+
+VOID Config::setImsiStride(U32 n)
+{
+    if (0 == n)
+    {
+        throw GsimError("Invalid IMSI stride 0");
+    }
+
+    m_imsiStride = n;
+}
+
+/**
+ * @brief
+ *    Sets the IMSI range of this instance as i/n, the i-th (from 0) of n
+ *    equal ranges, so that n simulator instances use distinct IMSIs
+ *
+ * @param part
+ */
+VOID Config::setImsiPartition(string part)
+{
+    U32 indx  = 0;
+    U32 cnt   = 0;
+    S8  extra = 0;
+
+    if (2 != sscanf(part.c_str(), "%u/%u%c", &indx, &cnt, &extra) ||
+        0 == cnt || indx >= cnt)
+    {
+        throw GsimError("Invalid IMSI partition " + part + ", must be i/n "
+            "with i less than n");
+    }
+
+    m_imsiPartIndx = indx;
+    m_imsiPartCnt  = cnt;
+}
+
+VOID Config::setImsiOrder(string order)
+{
+    if (0 == STRCASECMP(order.c_str(), "seq"))
+    {
+        m_imsiRandom = FALSE;
+    }
+    else if (0 == STRCASECMP(order.c_str(), "random"))
+    {
+        m_imsiRandom = TRUE;
+    }
+    else
+    {
+        throw GsimError("Invalid IMSI order " + order + ", must be seq or "
+            "random");
+    }
+}
+
+/**
+ * @brief
+ *    Sets the TEID shard of this instance as i/n, the TEIDs have the
+ *    shard id i in the top bits, so that n simulator instances or workers
+ *    use distinct TEIDs
+ *
+ * @param shard
+ */
+VOID Config::setTeidShard(string shard)
+{
+    U32 indx  = 0;
+    U32 cnt   = 0;
+    S8  extra = 0;
+
+    if (2 != sscanf(shard.c_str(), "%u/%u%c", &indx, &cnt, &extra) ||
+        0 == cnt || indx >= cnt || cnt > 65536)
+    {
+        throw GsimError("Invalid TEID shard " + shard + ", must be i/n "
+            "with i less than n and n at most 65536");
+    }
+
+    m_teidShard    = indx;
+    m_teidShardCnt = cnt;
+}
+
+VOID Config::setTeidQuarantine(U32 seconds)
+{
+    m_teidQuarantine = seconds;
+}
+
+/**
+ * @brief
+ *    Sets the pool of remote peers the sessions are distributed across,
+ *    a comma separated list of ip[-ip][/port][*weight]. An IPv4 range
+ *    adds a peer for each address of the range, the port is remote-port
+ *    and the weight is 1 if not given
+ *
+ * @param peers
+ */
+VOID Config::setRemotePeers(string peers)
+{
+    std::stringstream ss(peers);
+    string            item;
+
+    m_remotePeers.clear();
+    while (std::getline(ss, item, ','))
+    {
+        string        addr   = item;
+        RemotePeerCfg peer;
+        MEMSET(&peer, 0, sizeof(peer));
+        peer.weight = 1;
+
+        size_t pos = addr.find('*');
+        if (string::npos != pos)
+        {
+            S8 extra = 0;
+            if (1 != sscanf(addr.c_str() + pos + 1, "%u%c", &peer.weight,
+                    &extra) || 0 == peer.weight ||
+                    peer.weight > DFLT_MAX_PEER_WEIGHT)
+            {
+                throw GsimError("Invalid weight of remote peer " + item);
+            }
+            addr.erase(pos);
+        }
+
+        pos = addr.find('/');
+        if (string::npos != pos)
+        {
+            U32 port  = 0;
+            S8  extra = 0;
+            if (1 != sscanf(addr.c_str() + pos + 1, "%u%c", &port, &extra) ||
+                0 == port || port > 0xFFFF)
+            {
+                throw GsimError("Invalid port of remote peer " + item);
+            }
+            peer.ep.port = (U16)port;
+            addr.erase(pos);
+        }
+
+        IpAddr lastIp;
+        saveIpRange(item, addr, &peer.ep.ipAddr, &lastIp);
+
+        while (TRUE)
+        {
+            if (m_remotePeers.size() >= DFLT_MAX_REMOTE_PEERS)
+            {
+                throw GsimError("Too many remote peers, at most " +
+                    std::to_string(DFLT_MAX_REMOTE_PEERS));
+            }
+
+            m_remotePeers.push_back(peer);
+            if (IP_ADDR_TYPE_V6 == lastIp.ipAddrType ||
+                peer.ep.ipAddr.u.ipv4Addr.addr == lastIp.u.ipv4Addr.addr)
+            {
+                break;
+            }
+            peer.ep.ipAddr.u.ipv4Addr.addr++;
+        }
     }
 
-    if (options.count("n3-requests"))
+    if (m_remotePeers.empty())
     {
-        auto value = options["n3-requests"].as<std::uint32_t>();
-        setN3Requests(value);
+        throw GsimError("Invalid remote peers " + peers);
     }
+}
 
-    if (options.count("disp-timer"))
-    {
-        auto value = options["disp-timer"].as<std::uint32_t>();
-        setDisplayRefreshTimer(value);
-    }
+/**
+ * @brief
+ *    Sets the local endpoints the initiated sessions are sent from, a
+ *    comma separated list of ip[-ip][/port[-port]]. An endpoint is added
+ *    for each IPv4 address and port of the ranges, an ephemeral port is
+ *    used if the port is not given
+ *
+ * @param eps
+ */
+VOID Config::setLocalEndpoints(string eps)
+{
+    std::stringstream ss(eps);
+    string            item;
 
-    if (options.count("disp-target"))
+    m_localEps.clear();
+    while (std::getline(ss, item, ','))
     {
-        auto value = options["disp-target"].as<std::uint32_t>();
-        setDisplayTarget((DisplayTargetEn)value);
-    }
+        string     addr      = item;
+        U32        firstPort = 0;
+        U32        lastPort  = 0;
+        IPEndPoint ep;
+        MEMSET(&ep, 0, sizeof(ep));
+
+        size_t pos = addr.find('/');
+        if (string::npos != pos)
+        {
+            S8  extra = 0;
+            S32 cnt   = sscanf(addr.c_str() + pos + 1, "%u-%u%c", &firstPort,
+                &lastPort, &extra);
+            if (1 == cnt)
+            {
+                lastPort = firstPort;
+            }
+
+            if ((1 != cnt && 2 != cnt) || 0 == firstPort ||
+                lastPort > 0xFFFF || lastPort < firstPort)
+            {
+                throw GsimError("Invalid port of local endpoint " + item);
+            }
+            addr.erase(pos);
+        }
 
-    if (options.count("disp-target-file"))
-    {
-        auto value = options["disp-target-file"].as<std::string>();
-        setDisplayTargetFile(value);
+        IpAddr lastIp;
+        saveIpRange(item, addr, &ep.ipAddr, &lastIp);
+
+        while (TRUE)
+        {
+            for (U32 port = firstPort; port <= lastPort; port++)
+            {
+                if (m_localEps.size() >= DFLT_MAX_LOCAL_EPS)
+                {
+                    throw GsimError("Too many local endpoints, at most " +
+                        std::to_string(DFLT_MAX_LOCAL_EPS));
+                }
+
+                ep.port = (U16)port;
+                m_localEps.push_back(ep);
+            }
+
+            if (IP_ADDR_TYPE_V6 == lastIp.ipAddrType ||
+                ep.ipAddr.u.ipv4Addr.addr == lastIp.u.ipv4Addr.addr)
+            {
+                break;
+            }
+            ep.ipAddr.u.ipv4Addr.addr++;
+        }
     }
 
-    if ((getDisplayTarget() == DISP_TARGET_FILE) && getDisplayTargetFile().empty())
+    if (m_localEps.empty())
     {
-        throw GsimError("Must specify argument 'disp-target-file' when 'disp-target' is file");
+        throw GsimError("Invalid local endpoints " + eps);
     }
+}
 
-    if (options.count("disp-summary"))
+VOID Config::setPeerSelect(string mode)
+{
+    if (0 == STRCASECMP(mode.c_str(), "rr"))
     {
-        setDisplaySummary(TRUE);
+        m_peerSelect = PEER_SELECT_RR;
     }
-
-    if (options.count("error-file"))
+    else if (0 == STRCASECMP(mode.c_str(), "weighted"))
     {
-        auto value = options["error-file"].as<std::string>();
-        setErrorFile(value);
+        m_peerSelect = PEER_SELECT_WEIGHTED;
     }
-
-    if (options.count("log-file"))
+    else if (0 == STRCASECMP(mode.c_str(), "imsi-hash"))
     {
-        auto value = options["log-file"].as<std::string>();
-        setLogFile(value);
+        m_peerSelect = PEER_SELECT_IMSI_HASH;
     }
-
-    if (options.count("log-level"))
+    else
     {
-        auto value = options["log-level"].as<std::uint32_t>();
-        setLogLevel(value);
+        throw GsimError("Invalid peer selection " + mode + ", must be rr, "
+            "weighted or imsi-hash");
     }
+}
 
-    if (options.count("pid-file"))
+VOID Config::setSockRcvBuf(U32 n)
+{
+    if (0 == n)
     {
-        auto value = options["pid-file"].as<std::string>();
-        setPidFile(value);
+        throw GsimError("Invalid socket receive buffer size 0");
     }
 
-    if (options.count("timeout"))
+    m_sockRcvBuf = n;
+}
+
+VOID Config::setSockSndBuf(U32 n)
+{
+    if (0 == n)
     {
-        auto value = options["timeout"].as<std::uint32_t>();
-        setTimeout(value);
+        throw GsimError("Invalid socket send buffer size 0");
     }
+
+    m_sockSndBuf = n;
 }
 
-VOID Config::setNoOfCalls(U32 n)
+VOID Config::setTimestamps(BOOL val)
 {
-    pCfg->m_maxSessions = n;
+    m_timestamps = val;
 }
 
-VOID Config::setCallRate(U32 n)
+VOID Config::setBusyPoll(BOOL val)
 {
-    pCfg->m_ssnRate = n;
+    m_busyPoll = val;
 }
 
-VOID Config::setRatePeriod(U32 n)
+/**
+ * @brief
+ *    Sets the cores of the scheduler thread, a comma separated list of
+ *    cores and core ranges, e.g. 2,4-5
+ *
+ * @param cpus
+ */
+VOID Config::setCpuAffinity(string cpus)
 {
-    pCfg->m_ssnRatePeriod = n;
+    const S8 *p = cpus.c_str();
+
+    m_cpuAffinity.clear();
+    while ('\0' != *p)
+    {
+        S8  *pEnd  = NULL;
+        U32  first = strtoul(p, &pEnd, 10);
+        U32  last  = first;
+        if (pEnd == p)
+        {
+            throw GsimError("Invalid CPU affinity " + cpus);
+        }
+
+        p = pEnd;
+        if ('-' == *p)
+        {
+            last = strtoul(p + 1, &pEnd, 10);
+            if (pEnd == p + 1 || last < first)
+            {
+                throw GsimError("Invalid CPU affinity " + cpus);
+            }
+            p = pEnd;
+        }
+
+        for (U32 cpu = first; cpu <= last; cpu++)
+        {
+            m_cpuAffinity.push_back(cpu);
+        }
+
+        if (',' == *p)
+        {
+            p++;
+        }
+        else if ('\0' != *p)
+        {
+            throw GsimError("Invalid CPU affinity " + cpus);
+        }
+    }
+}
+
+VOID Config::setRtPrio(U32 prio)
+{
+    if (0 == prio || prio > DFLT_MAX_RT_PRIO)
+    {
+        throw GsimError("Invalid realtime priority, must be 1 to 99");
+    }
+
+    m_rtPrio = prio;
 }
 
 VOID Config::setLocalIpAddr(string ip)
@@ -443,6 +1228,16 @@ BOOL Config::getDisplaySummary()
     return m_dispSummary;
 }
 
+VOID Config::setResponderMode(BOOL val)
+{
+    m_responderMode = val;
+}
+
+BOOL Config::getResponderMode()
+{
+    return m_responderMode;
+}
+
 VOID Config::setDisplayTargetFile(string filename)
 {
     if (filename.size() == 0)
@@ -492,6 +1287,39 @@ VOID Config::writePidFile()
    pidf.close();
 }
 
+/**
+ * @brief
+ *    Saves the first and the last address of ip[-ip], a range is allowed
+ *    only for IPv4
+ *
+ * @param item
+ *    the option value, for the error
+ * @param addr
+ * @param pFirst
+ * @param pLast
+ */
+VOID Config::saveIpRange(string &item, string addr, IpAddr *pFirst,
+    IpAddr *pLast)
+{
+    string last = addr;
+    size_t pos  = addr.find('-');
+    if (string::npos != pos)
+    {
+        last = addr.substr(pos + 1);
+        addr.erase(pos);
+    }
+
+    saveIp(addr, pFirst);
+    saveIp(last, pLast);
+    if (pFirst->ipAddrType != pLast->ipAddrType ||
+        (IP_ADDR_TYPE_V6 == pLast->ipAddrType && last != addr) ||
+        (IP_ADDR_TYPE_V4 == pLast->ipAddrType &&
+         pLast->u.ipv4Addr.addr < pFirst->u.ipv4Addr.addr))
+    {
+        throw GsimError("Invalid address range " + item);
+    }
+}
+
 RETVAL Config::saveIp(string &ipStr, IpAddr *pIp)
 {
     RETVAL ret = ROK;
@@ -563,6 +1391,231 @@ U32 Config::getCallRate()
     return m_ssnRate;
 }
 
+U32 Config::getConcurrency()
+{
+    return m_concurrency;
+}
+
+BOOL Config::getFindMaxRate()
+{
+    return m_findMaxRate;
+}
+
+Time_t Config::getSearchStepTime()
+{
+    return m_searchStepTime;
+}
+
+double Config::getSearchMaxFailRatio()
+{
+    return m_searchMaxFailRatio;
+}
+
+U32 Config::getSearchMaxP99()
+{
+    return m_searchMaxP99;
+}
+
+Counter Config::getSearchMaxUnexp()
+{
+    return m_searchMaxUnexp;
+}
+
+string Config::getSearchReportFile()
+{
+    return m_searchReportFile;
+}
+
+BOOL Config::getAdaptiveRate()
+{
+    return m_adaptiveRate;
+}
+
+U32 Config::getAdaptiveMaxLatency()
+{
+    return m_adaptiveMaxLatency;
+}
+
+U32 Config::getGtpuRate()
+{
+    return m_gtpuRate;
+}
+
+U32 Config::getGtpuPktSize()
+{
+    return m_gtpuPktSize;
+}
+
+U32 Config::getGtpuFlows()
+{
+    return m_gtpuFlows;
+}
+
+U16 Config::getGtpuLocalPort()
+{
+    return m_gtpuLocPort;
+}
+
+U16 Config::getGtpuRemotePort()
+{
+    return m_gtpuRemPort;
+}
+
+IpAddr Config::getGtpuRemoteIpAddr()
+{
+    if (IP_ADDR_TYPE_INV == m_gtpuRemIpAddr.ipAddrType)
+    {
+        return remIpAddr;
+    }
+
+    return m_gtpuRemIpAddr;
+}
+
+BOOL Config::getGtpuSink()
+{
+    return m_gtpuSink;
+}
+
+BOOL Config::getGtpuOffload()
+{
+    return m_gtpuOffload;
+}
+
+string Config::getGtpuIface()
+{
+    return m_gtpuIface;
+}
+
+const U8 *Config::getGtpuPeerMac()
+{
+    return m_gtpuPeerMac;
+}
+
+TransportTypeEn Config::getTransportType()
+{
+    return m_transportType;
+}
+
+U32 Config::getSockRcvBuf()
+{
+    return m_sockRcvBuf;
+}
+
+U32 Config::getSockSndBuf()
+{
+    return m_sockSndBuf;
+}
+
+BOOL Config::getTimestamps()
+{
+    return m_timestamps;
+}
+
+BOOL Config::getBusyPoll()
+{
+    return m_busyPoll;
+}
+
+const std::vector<U32>& Config::getCpuAffinity()
+{
+    return m_cpuAffinity;
+}
+
+U32 Config::getRtPrio()
+{
+    return m_rtPrio;
+}
+
+U64 Config::getHugePageSize()
+{
+    return m_hugePageSize;
+}
+
+U32 Config::getImsiStride()
+{
+    return m_imsiStride;
+}
+
+U32 Config::getImsiPartIndx()
+{
+    return m_imsiPartIndx;
+}
+
+U32 Config::getImsiPartCnt()
+{
+    return m_imsiPartCnt;
+}
+
+BOOL Config::getImsiRandomOrder()
+{
+    return m_imsiRandom;
+}
+
+/**
+ * @brief
+ *    remote peers of the sessions, remote-ip and remote-port if no pool
+ *    of peers is set
+ */
+std::vector<RemotePeerCfg> Config::getRemotePeers()
+{
+    std::vector<RemotePeerCfg> peers = m_remotePeers;
+
+    if (peers.empty())
+    {
+        RemotePeerCfg peer;
+        MEMSET(&peer, 0, sizeof(peer));
+        peer.ep.ipAddr = getRemoteIpAddr();
+        peer.weight    = 1;
+        peers.push_back(peer);
+    }
+
+    for (U32 i = 0; i < peers.size(); i++)
+    {
+        if (0 == peers[i].ep.port)
+        {
+            peers[i].ep.port = getRemoteGtpcPort();
+        }
+    }
+
+    return peers;
+}
+
+const std::vector<IPEndPoint> &Config::getLocalEndpoints()
+{
+    return m_localEps;
+}
+
+PeerSelectEn Config::getPeerSelect()
+{
+    return m_peerSelect;
+}
+
+U32 Config::getTeidShard()
+{
+    return m_teidShard;
+}
+
+U32 Config::getTeidShardCnt()
+{
+    return m_teidShardCnt;
+}
+
+/**
+ * @brief
+ *    seconds a freed TEID is not reused, by default the time the peer
+ *    may retransmit a request to the TEID
+ */
+U32 Config::getTeidQuarantine()
+{
+    if (DFLT_TEID_QUARANTINE == m_teidQuarantine)
+    {
+        /* t3-timer is in milli seconds, rounded up to seconds */
+        return ((getN3Requests() + 1) * getT3Timer() + 999) / 1000;
+    }
+
+    return m_teidQuarantine;
+}
+
 Time_t Config::getSessionRatePeriod()
 {
     return m_ssnRatePeriod;
@@ -633,8 +1686,23 @@ string Config::getImsi()
     return m_imsiStr;
 }
 
-VOID Config::setImsi(S8 *pVal, U32 len)
+VOID Config::setImsi(const S8 *pVal, U32 len)
 {
+    if (0 == len || len > DFLT_MAX_IMSI_DIGITS)
+    {
+        throw GsimError("Invalid IMSI " + string(pVal, len) + ", must be "
+            "1 to 15 digits");
+    }
+
+    for (U32 i = 0; i < len; i++)
+    {
+        if (pVal[i] < '0' || pVal[i] > '9')
+        {
+            throw GsimError("Invalid IMSI " + string(pVal, len) + ", must "
+                "be 1 to 15 digits");
+        }
+    }
+
     m_imsiStr.assign(pVal, len);
 }
 
@@ -36,6 +36,26 @@ using namespace std;
 #define DFLT_TRACE_MSG_FILE_NAME_LEN 64
 #define DFLT_DEAD_CALL_WAIT 20000 // milli seconds
 #define DFLT_TIMEOUT 0
+#define DFLT_SEARCH_STEP_TIME 10000      // milli seconds
+#define DFLT_SEARCH_MAX_FAIL_RATIO 0.1   // percent of sessions timed out
+#define DFLT_SEARCH_MAX_P99 1000         // milli seconds
+#define DFLT_SEARCH_MAX_UNEXP 0
+#define DFLT_SEARCH_REPORT_FILE "rate_search.json"
+#define DFLT_ADAPTIVE_MAX_LATENCY 1000 // milli seconds
+#define DFLT_GTPU_PORT 2152
+#define DFLT_GTPU_PKT_SIZE 64      // inner IP packet length
+#define DFLT_GTPU_MIN_PKT_SIZE 44  // inner IP, UDP and gsim payload header
+#define DFLT_GTPU_MAX_PKT_SIZE 9000
+#define DFLT_GTPU_PKT_SIZE_IMIX 0
+#define DFLT_MAC_ADDR_LEN 6
+#define DFLT_SOCK_RCVBUF (1 << 20) // bytes
+#define DFLT_SOCK_SNDBUF (1 << 20) // bytes
+#define DFLT_MAX_RT_PRIO 99
+#define DFLT_MAX_IMSI_DIGITS 15
+#define DFLT_TEID_QUARANTINE 0xFFFFFFFF // (n3-requests + 1) * t3-timer, in s
+#define DFLT_MAX_REMOTE_PEERS 4096
+#define DFLT_MAX_PEER_WEIGHT  100
+#define DFLT_MAX_LOCAL_EPS    1000
 
 typedef enum {
     DISP_TARGET_NONE,
@@ -44,6 +64,25 @@ typedef enum {
     DISP_TARGET_MAX
 } DisplayTargetEn;
 
+typedef enum {
+    TRANSPORT_TYPE_POLL,  // poll() and one system call per message
+    TRANSPORT_TYPE_MMSG,  // recvmmsg() and sendmmsg() batches
+    TRANSPORT_TYPE_URING, // io_uring, multishot receive
+    TRANSPORT_TYPE_MAX
+} TransportTypeEn;
+
+typedef enum {
+    PEER_SELECT_RR,        // round-robin
+    PEER_SELECT_WEIGHTED,  // round-robin in proportion to the weights
+    PEER_SELECT_IMSI_HASH, // weighted, by the hash of the IMSI
+    PEER_SELECT_MAX
+} PeerSelectEn;
+
+typedef struct {
+    IPEndPoint ep;        // port 0 for remote-port
+    U32        weight;
+} RemotePeerCfg;
+
 // Config will be a singleton object, accessed using getInstance
 class Config
 {
@@ -65,12 +104,48 @@ public:
     VOID setDisplayRefreshTimer(U32 n);
     VOID setDisplayTarget(DisplayTargetEn target);
     VOID setDisplaySummary(BOOL val);
+    VOID setResponderMode(BOOL val);
     VOID setErrorFile(string filename) throw(ErrCodeEn);
     VOID setScenarioFile(std::string filename) throw(ErrCodeEn);
     VOID setLogFile(string filename) throw(ErrCodeEn);
     VOID setDisplayTargetFile(string filename);
     VOID setCallRate(U32 n);
     VOID setRatePeriod(U32 n);
+    VOID setConcurrency(U32 n);
+    VOID setFindMaxRate(BOOL val);
+    VOID setSearchStepTime(U32 n);
+    VOID setSearchMaxFailRatio(double val);
+    VOID setSearchMaxP99(U32 n);
+    VOID setSearchMaxUnexp(U32 n);
+    VOID setSearchReportFile(string filename);
+    VOID setAdaptiveRate(BOOL val);
+    VOID setAdaptiveMaxLatency(U32 n);
+    VOID setGtpuRate(U32 n);
+    VOID setGtpuPktSize(string size);
+    VOID setGtpuFlows(U32 n);
+    VOID setGtpuLocalPort(U16 port);
+    VOID setGtpuRemotePort(U16 port);
+    VOID setGtpuRemoteIpAddr(string ip);
+    VOID setGtpuSink(BOOL val);
+    VOID setGtpuOffload(BOOL val);
+    VOID setGtpuIface(string ifName);
+    VOID setGtpuPeerMac(string mac);
+    VOID setTransportType(string type);
+    VOID setSockRcvBuf(U32 n);
+    VOID setSockSndBuf(U32 n);
+    VOID setTimestamps(BOOL val);
+    VOID setBusyPoll(BOOL val);
+    VOID setCpuAffinity(string cpus);
+    VOID setRtPrio(U32 prio);
+    VOID setHugePages(string size);
+    VOID setImsiStride(U32 n);
+    VOID setImsiPartition(string part);
+    VOID setImsiOrder(string order);
+    VOID setTeidShard(string shard);
+    VOID setTeidQuarantine(U32 seconds);
+    VOID setRemotePeers(string peers);
+    VOID setPeerSelect(string mode);
+    VOID setLocalEndpoints(string eps);
     VOID setLogLevel(std::uint32_t logLvl);
     VOID setTraceMsg(BOOL);
     VOID setTraceMsgFile(string);
@@ -89,10 +164,48 @@ public:
     DisplayTargetEn getDisplayTarget();
     string        getDisplayTargetFile();
     BOOL          getDisplaySummary();
+    BOOL          getResponderMode();
     U32           getT3Timer();
     U32           getScnRunInterval();
     const S8 *    getScnFile();
     U32           getCallRate();
+    U32           getConcurrency();
+    BOOL          getFindMaxRate();
+    Time_t        getSearchStepTime();
+    double        getSearchMaxFailRatio();
+    U32           getSearchMaxP99();
+    Counter       getSearchMaxUnexp();
+    string        getSearchReportFile();
+    BOOL          getAdaptiveRate();
+    U32           getAdaptiveMaxLatency();
+    U32           getGtpuRate();
+    U32           getGtpuPktSize();
+    U32           getGtpuFlows();
+    U16           getGtpuLocalPort();
+    U16           getGtpuRemotePort();
+    IpAddr        getGtpuRemoteIpAddr();
+    BOOL          getGtpuSink();
+    BOOL          getGtpuOffload();
+    string        getGtpuIface();
+    const U8*     getGtpuPeerMac();
+    TransportTypeEn getTransportType();
+    U32           getSockRcvBuf();
+    U32           getSockSndBuf();
+    BOOL          getTimestamps();
+    BOOL          getBusyPoll();
+    const std::vector<U32>& getCpuAffinity();
+    U32           getRtPrio();
+    U64           getHugePageSize();
+    U32           getImsiStride();
+    U32           getImsiPartIndx();
+    U32           getImsiPartCnt();
+    BOOL          getImsiRandomOrder();
+    U32           getTeidShard();
+    U32           getTeidShardCnt();
+    U32           getTeidQuarantine();
+    std::vector<RemotePeerCfg> getRemotePeers();
+    PeerSelectEn  getPeerSelect();
+    const std::vector<IPEndPoint> &getLocalEndpoints();
     U32           getLogLevel();
     U32           getTimeout();
     VOID          setConfig(cxxopts::ParseResult options);
@@ -104,7 +217,7 @@ public:
     BOOL          getTraceMsg();
     string        getTraceMsgFile();
     string        getImsi();
-    VOID          setImsi(S8 *pVal, U32 len);
+    VOID          setImsi(const S8 *pVal, U32 len);
     VOID          incrRate(U32 value);
     VOID          decrRate(U32 value);
     Time_t        getDeadCallWait();
@@ -117,6 +230,8 @@ public:
 private:
     Config();
     RETVAL saveIp(string &ipStr, IpAddr *pIp);
+    VOID   saveIpRange(string &item, string addr, IpAddr *pFirst,
+               IpAddr *pLast);
     void   setIfType(std::string ifType);
 
     U32             m_ssnRate; // no.of calls per sec
@@ -133,8 +248,46 @@ private:
     string          m_logFile;      // log file path
     string          dispTargetFile; // display redirected to this file
     BOOL            m_dispSummary;
+    BOOL            m_responderMode;
     U32             m_scnRunIntvl;
     Time_t          m_ssnRatePeriod;
+    U32             m_concurrency; // sessions in flight, closed-loop mode
+    BOOL            m_findMaxRate;
+    Time_t          m_searchStepTime;     // measurement time of a rate step
+    double          m_searchMaxFailRatio; // SLO, percent of sessions
+    U32             m_searchMaxP99;       // SLO, milli seconds
+    Counter         m_searchMaxUnexp;     // SLO, messages per rate step
+    string          m_searchReportFile;
+    BOOL            m_adaptiveRate;
+    U32             m_adaptiveMaxLatency; // p99, milli seconds
+    U32             m_gtpuRate;     // G-PDUs per second per bearer
+    U32             m_gtpuPktSize;  // inner packet length, 0 for IMIX
+    U32             m_gtpuFlows;    // inner UDP flows per bearer
+    U16             m_gtpuLocPort;
+    U16             m_gtpuRemPort;
+    IpAddr          m_gtpuRemIpAddr; // remote-ip is used if not set
+    BOOL            m_gtpuSink;     // measure the received G-PDUs
+    BOOL            m_gtpuOffload;  // UDP GSO and GRO, if supported
+    string          m_gtpuIface;    // AF_PACKET rings used if set
+    U8              m_gtpuPeerMac[DFLT_MAC_ADDR_LEN];
+    TransportTypeEn m_transportType; // GTP-C socket I/O
+    U32             m_sockRcvBuf;   // SO_RCVBUF of the UDP sockets, bytes
+    U32             m_sockSndBuf;   // SO_SNDBUF of the UDP sockets, bytes
+    BOOL            m_timestamps;   // kernel receive timestamps, GTP-C
+    BOOL            m_busyPoll;     // spin on the sockets, TSC clock
+    std::vector<U32> m_cpuAffinity; // cores of the scheduler thread
+    U32             m_rtPrio;       // SCHED_FIFO priority, 0 if not set
+    U64             m_hugePageSize; // page size of the pools, 0 if off
+    U32             m_imsiStride;   // difference of consecutive IMSIs
+    U32             m_imsiPartIndx; // IMSI range of this instance out of
+    U32             m_imsiPartCnt;  // m_imsiPartCnt equal ranges
+    BOOL            m_imsiRandom;   // IMSIs of the range in random order
+    U32             m_teidShard;    // TEIDs with the shard id in the top
+    U32             m_teidShardCnt; // bits, out of m_teidShardCnt shards
+    U32             m_teidQuarantine; // seconds a freed TEID is not reused
+    std::vector<RemotePeerCfg> m_remotePeers; // pool of remote-ip if empty
+    PeerSelectEn    m_peerSelect;   // remote peer of a new session
+    std::vector<IPEndPoint> m_localEps; // local-ip, ephemeral port if empty
     std::uint32_t   m_logLevel;
     std::uint32_t   m_timeout;
     EpcNodeType_t   m_nodeType;
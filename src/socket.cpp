@@ -23,34 +23,103 @@
 #include <sys/select.h>
 #include <string.h>
 #include <list>
+#include <vector>
+#include <deque>
+#include <linux/io_uring.h>
+#include <linux/sock_diag.h>
+#include <linux/net_tstamp.h>
 
 #include "types.hpp"
 #include "macros.hpp"
 #include "logger.hpp"
 #include "error.hpp"
 #include "thread.hpp"
+#include "timer.hpp"
 #include "transport.hpp"
 #include "keyboard.hpp"
 #include "gtp_types.hpp"
 #include "socket.hpp"
 #include "sim_cfg.hpp"
 #include "gtp_macro.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "packet_ring.hpp"
+#include "uring.hpp"
 
 /******************* Function Declarations ***********************************/
 EXTERN VOID procGtpcMsg(UdpData_t *data);
-PRIVATE RETVAL sendMsgV4(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data);
-PRIVATE RETVAL sendMsgV6(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data);
+EXTERN VOID procGtpcMsgStateless(TransConnId connId, IPEndPoint *pPeerEp,
+    U8 *pBuf, U32 len);
+EXTERN VOID procGtpuMsgBatch(RecvVec_t *pMsgs, U32 cnt);
+PRIVATE RETVAL sendBufV4(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len);
+PRIVATE RETVAL sendBufV6(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len);
+PRIVATE RETVAL sendBuf(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len);
+PRIVATE RETVAL sendOrPark(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data,
+    const U8 *pBuf, U32 len);
 PRIVATE RETVAL handleGtpcSock(GSimSocket *pSock);
+PRIVATE RETVAL handleGtpcSockStateless(GSimSocket *pSock);
 PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock);
+PRIVATE RETVAL handleGtpuSockGro(GSimSocket *pSock);
+PRIVATE RETVAL handleGtpuRing(GSimSocket *pSock);
+PRIVATE RETVAL initGtpuRing();
+PRIVATE VOID   probeGtpuOffload(GSimSocket *pSock);
 PRIVATE VOID handleStdinSock(GSimSocket *pSock);
+PRIVATE VOID handleSockEvent(GSimSocket *pSock);
+PRIVATE RETVAL handleGtpcSockBatch(GSimSocket *pSock);
+PRIVATE VOID procGtpcBuf(GSimSocket *pSock, IPEndPoint *pPeerEp, U8 *pBuf,
+    U32 len, Time_t tstamp);
+PRIVATE VOID sockAddrToEp(struct sockaddr_storage *pAddr, IPEndPoint *pEp);
+PRIVATE socklen_t epToSockAddr(IPEndPoint *pEp, struct sockaddr_storage *pAddr);
+PRIVATE RETVAL queueMsg(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data,
+    const U8 *pBuf, U32 len);
+PRIVATE VOID flushSendQueue();
+PRIVATE VOID sampleSockets();
+PRIVATE Time_t cmsgToTstamp(struct cmsghdr *pCmsg);
+PRIVATE Time_t getRxTstamp(struct msghdr *pHdr);
+PRIVATE VOID recordRxDelay(Time_t tstamp);
+PRIVATE RETVAL initUring();
+PRIVATE U32 uringPoll(S32 wait);
+PRIVATE VOID uringArm(GSimSocket *pSock);
+PRIVATE VOID uringRecvDone(U32 indx, S32 res, U32 flags);
+PRIVATE VOID uringPollDone(U32 indx, S32 res, U32 flags, U64 udata);
+PRIVATE VOID uringSendDone(U32 indx, S32 res);
 /******************* Function Declarations ***********************************/
 
 GSimSocket *       g_gsimSockArr[GSIM_MAX_SOCK_CNT];
 GSimPollFd         s_pollFdArr[GSIM_MAX_POLL_FDS];
 static U32         s_pollFdCnt = 0;
 static GSimSocket *s_pListener = NULL;
-static GSimSocket *s_pSender   = NULL;
+static std::vector<GSimSocket *> s_senders; /* initiated sessions */
+static GSimSocket *s_pGtpuSock = NULL;
 static U8          s_recvBuf[GSIM_UDP_READ_LEN];
+static U8          s_gtpuRecvBufs[GSIM_MAX_RECV_BATCH][GSIM_GTPU_PEEK_LEN];
+static RecvVec_t   s_gtpuRecvVecs[GSIM_MAX_RECV_BATCH];
+static U8          s_groRecvBufs[GSIM_GRO_RECV_BATCH][GSIM_GRO_BUF_LEN];
+static RecvVec_t   s_groSegVecs[GSIM_GRO_RECV_BATCH * GSIM_GRO_MAX_SEGS];
+static U32         s_gtpuOffload = 0;
+static PacketRing *s_pGtpuRing   = NULL;
+static BOOL        s_responderMode = FALSE;
+static U8          s_gtpcRecvBufs[GSIM_MAX_RECV_BATCH][GSIM_UDP_READ_LEN];
+static RecvVec_t   s_gtpcRecvVecs[GSIM_MAX_RECV_BATCH];
+static IPEndPoint  s_gtpcPeerEps[GSIM_MAX_RECV_BATCH];
+static TransportTypeEn s_transportType = TRANSPORT_TYPE_POLL;
+static SendSlot_t *s_pSendSlots  = NULL;
+static U32         s_sendQCnt    = 0;     /* mmsg, slots in the batch */
+static IoUring    *s_pUring      = NULL;
+static std::vector<U32> s_uringFreeSlots;
+static struct msghdr    s_uringRecvHdr;
+static BOOL        s_uringArmed[GSIM_MAX_SOCK_CNT];
+static U32         s_txParked    = 0;     /* messages in all tx queues */
+static BOOL        s_txCongested = FALSE;
+static Time_t      s_nextSockSample = 0;
+static BOOL        s_timestamps  = FALSE; /* GTP-C kernel rx timestamps */
 
 /**
  * @brief
@@ -91,7 +160,7 @@ RETVAL GSimSocket::recvMsgV4(UdpData_t **msg)
 RETVAL GSimSocket::recvMsgV6(UdpData_t **msg)
 {
     struct sockaddr_in6 fromAddr;
-    socklen_t           fromLen = 0;
+    socklen_t           fromLen = sizeof(sockaddr_in6);
 
     U32 recvLen = recvfrom(m_fd, s_recvBuf, GSIM_UDP_READ_LEN, MSG_DONTWAIT,
         (struct sockaddr *)&fromAddr, &fromLen);
@@ -100,7 +169,8 @@ RETVAL GSimSocket::recvMsgV6(UdpData_t **msg)
         *msg = new UdpData_t;
         BUFFER_CPY(&(*msg)->buf, s_recvBuf, recvLen);
         (*msg)->connId                   = m_pollFdIndex;
-        (*msg)->peerEp.ipAddr.ipAddrType = IP_ADDR_TYPE_V4;
+        (*msg)->peerEp.ipAddr.ipAddrType = IP_ADDR_TYPE_V6;
+        (*msg)->peerEp.ipAddr.u.ipv6Addr.len = IPV6_ADDR_MAX_LEN;
         MEMCPY((*msg)->peerEp.ipAddr.u.ipv6Addr.addr,
             fromAddr.sin6_addr.s6_addr, IPV6_ADDR_MAX_LEN);
         (*msg)->peerEp.port = ntohs(fromAddr.sin6_port);
@@ -110,12 +180,189 @@ RETVAL GSimSocket::recvMsgV6(UdpData_t **msg)
     return RFAILED;
 }
 
+/**
+ * @brief
+ *    Reads the UDP socket without allocating a socket buffer, the message
+ *    is valid only until the next read from any socket
+ *
+ * @param ppBuf
+ *    points to the received message
+ * @param pLen
+ * @param pPeerEp
+ *
+ * @return
+ */
+RETVAL GSimSocket::recvMsg(U8 **ppBuf, U32 *pLen, IPEndPoint *pPeerEp)
+{
+    struct sockaddr_storage fromAddr;
+    socklen_t               fromLen = sizeof(fromAddr);
+
+    S32 recvLen = recvfrom(m_fd, s_recvBuf, GSIM_UDP_READ_LEN, MSG_DONTWAIT,
+        (struct sockaddr *)&fromAddr, &fromLen);
+    if (recvLen <= 0)
+    {
+        return RFAILED;
+    }
+
+    sockAddrToEp(&fromAddr, pPeerEp);
+
+    *ppBuf = s_recvBuf;
+    *pLen  = recvLen;
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Reads the UDP socket without allocating a socket buffer, along with
+ *    the kernel receive timestamp of the message
+ *
+ * @param ppBuf
+ *    points to the received message
+ * @param pLen
+ * @param pPeerEp
+ * @param pTstamp
+ *    receive time in micro-seconds, 0 if the kernel did not stamp it
+ *
+ * @return
+ */
+RETVAL GSimSocket::recvMsg(U8 **ppBuf, U32 *pLen, IPEndPoint *pPeerEp,
+    Time_t *pTstamp)
+{
+    struct sockaddr_storage fromAddr;
+    struct iovec            iov;
+    struct msghdr           hdr;
+    U8                      ctrl[GSIM_RECV_CTRL_LEN];
+
+    iov.iov_base = s_recvBuf;
+    iov.iov_len  = GSIM_UDP_READ_LEN;
+
+    MEMSET(&hdr, 0, sizeof(hdr));
+    hdr.msg_name       = &fromAddr;
+    hdr.msg_namelen    = sizeof(fromAddr);
+    hdr.msg_iov        = &iov;
+    hdr.msg_iovlen     = 1;
+    hdr.msg_control    = ctrl;
+    hdr.msg_controllen = sizeof(ctrl);
+
+    S32 recvLen = recvmsg(m_fd, &hdr, MSG_DONTWAIT);
+    if (recvLen <= 0)
+    {
+        return RFAILED;
+    }
+
+    sockAddrToEp(&fromAddr, pPeerEp);
+
+    *ppBuf   = s_recvBuf;
+    *pLen    = recvLen;
+    *pTstamp = getRxTstamp(&hdr);
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Reads upto cnt messages from the socket with a single system call.
+ *    The messages longer than the buffer are truncated, the actual length
+ *    is returned in the len of each message
+ *
+ * @param pMsgs
+ * @param cnt
+ *    not more than GSIM_MAX_RECV_BATCH
+ * @param pPeerEps
+ *    filled with the sender of each message, if not NULL
+ *
+ * @return
+ *    number of messages read
+ */
+U32 GSimSocket::recvMsgBatch(RecvVec_t *pMsgs, U32 cnt, IPEndPoint *pPeerEps)
+{
+    static struct mmsghdr s_mmsgs[GSIM_MAX_RECV_BATCH];
+    static struct iovec   s_iovs[GSIM_MAX_RECV_BATCH];
+    static U8             s_ctrl[GSIM_MAX_RECV_BATCH][GSIM_RECV_CTRL_LEN];
+    static struct sockaddr_storage s_names[GSIM_MAX_RECV_BATCH];
+
+    for (U32 i = 0; i < cnt; i++)
+    {
+        s_iovs[i].iov_base = pMsgs[i].pBuf;
+        s_iovs[i].iov_len  = pMsgs[i].bufLen;
+
+        MEMSET(&s_mmsgs[i], 0, sizeof(struct mmsghdr));
+        s_mmsgs[i].msg_hdr.msg_iov        = &s_iovs[i];
+        s_mmsgs[i].msg_hdr.msg_iovlen     = 1;
+        s_mmsgs[i].msg_hdr.msg_control    = s_ctrl[i];
+        s_mmsgs[i].msg_hdr.msg_controllen = sizeof(s_ctrl[i]);
+        if (NULL != pPeerEps)
+        {
+            s_mmsgs[i].msg_hdr.msg_name    = &s_names[i];
+            s_mmsgs[i].msg_hdr.msg_namelen = sizeof(s_names[i]);
+        }
+    }
+
+    S32 numRecv = recvmmsg(m_fd, s_mmsgs, cnt, MSG_DONTWAIT | MSG_TRUNC,
+        NULL);
+    if (numRecv <= 0)
+    {
+        return 0;
+    }
+
+    for (S32 i = 0; i < numRecv; i++)
+    {
+        struct msghdr  *pHdr  = &s_mmsgs[i].msg_hdr;
+        struct cmsghdr *pCmsg = NULL;
+
+        pMsgs[i].len    = s_mmsgs[i].msg_len;
+        pMsgs[i].segLen = 0;
+        pMsgs[i].tstamp = 0;
+        if (NULL != pPeerEps)
+        {
+            sockAddrToEp(&s_names[i], &pPeerEps[i]);
+        }
+
+        for (pCmsg = CMSG_FIRSTHDR(pHdr); NULL != pCmsg;
+             pCmsg = CMSG_NXTHDR(pHdr, pCmsg))
+        {
+            if (SOL_UDP == pCmsg->cmsg_level && UDP_GRO == pCmsg->cmsg_type)
+            {
+                S32 segLen = 0;
+                MEMCPY(&segLen, CMSG_DATA(pCmsg), sizeof(segLen));
+                pMsgs[i].segLen = segLen;
+            }
+            else if (SOL_SOCKET == pCmsg->cmsg_level)
+            {
+                pMsgs[i].tstamp = cmsgToTstamp(pCmsg);
+            }
+        }
+    }
+
+    return numRecv;
+}
+
 RETVAL GSimSocket::recvMsg(UdpData_t **msg)
 {
     LOG_ENTERFN();
 
     RETVAL ret = ROK;
 
+    if (s_timestamps)
+    {
+        U8        *pBuf   = NULL;
+        U32        len    = 0;
+        Time_t     tstamp = 0;
+        IPEndPoint peerEp;
+
+        ret = recvMsg(&pBuf, &len, &peerEp, &tstamp);
+        if (ROK == ret)
+        {
+            recordRxDelay(tstamp);
+            *msg = new UdpData_t;
+            BUFFER_CPY(&(*msg)->buf, pBuf, len);
+            (*msg)->connId = m_pollFdIndex;
+            (*msg)->peerEp = peerEp;
+            (*msg)->tstamp = (0 != tstamp) ? tstamp : getMicroSeconds();
+        }
+
+        LOG_EXITFN(ret);
+    }
+
     if (IP_ADDR_TYPE_V4 == m_ep.ipAddr.ipAddrType)
     {
         ret = recvMsgV4(msg);
@@ -125,10 +372,16 @@ RETVAL GSimSocket::recvMsg(UdpData_t **msg)
         ret = recvMsgV6(msg);
     }
 
+    if (ROK == ret)
+    {
+        (*msg)->tstamp = getMicroSeconds();
+    }
+
     LOG_EXITFN(ret);
 }
 
-PRIVATE RETVAL sendMsgV4(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
+PRIVATE RETVAL sendBufV4(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len)
 {
     LOG_ENTERFN();
 
@@ -139,417 +392,1974 @@ PRIVATE RETVAL sendMsgV4(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
     destAddr.sin_port        = htons(pDst->port);
     MEMSET(destAddr.sin_zero, '\0', sizeof(destAddr.sin_zero));
 
-    S32 ret = sendto(pSock->fd(), (VOID *)data->pVal, (size_t)data->len,
+    S32 ret = sendto(pSock->fd(), (const VOID *)pBuf, (size_t)len,
         MSG_DONTWAIT, (struct sockaddr *)&destAddr, sizeof(destAddr));
     if (ret < 0)
     {
+        if (EAGAIN == errno || EWOULDBLOCK == errno)
+        {
+            LOG_EXITFN(ERR_SYS_SOCK_SEND_AGAIN);
+        }
+
         LOG_FATAL("Socket sendto() failed, [%s]", strerror(errno));
         LOG_EXITFN(ERR_SYS_SOCK_SEND);
     }
 
-    delete data;
     LOG_EXITFN(ROK);
 }
 
-PRIVATE RETVAL sendMsgV6(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
+PRIVATE RETVAL sendBufV6(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len)
 {
     struct sockaddr_in6 destAddr;
 
+    MEMSET(&destAddr, 0, sizeof(destAddr));
     MEMCPY(destAddr.sin6_addr.s6_addr, pDst->ipAddr.u.ipv6Addr.addr,
         pDst->ipAddr.u.ipv6Addr.len);
     destAddr.sin6_family = AF_INET6;
     destAddr.sin6_port   = htons(pDst->port);
 
-    if (sendto(pSock->fd(), data->pVal, data->len, MSG_DONTWAIT,
+    if (sendto(pSock->fd(), pBuf, len, MSG_DONTWAIT,
             (struct sockaddr *)&destAddr, sizeof(destAddr)) > 0)
     {
         return ROK;
     }
 
-    delete data;
-    return RFAILED;
+    if (EAGAIN == errno || EWOULDBLOCK == errno)
+    {
+        return ERR_SYS_SOCK_SEND_AGAIN;
+    }
+
+    LOG_FATAL("Socket sendto() failed, [%s]", strerror(errno));
+    return ERR_SYS_SOCK_SEND;
 }
 
-PUBLIC VOID socketPoll(S32 wait)
+PRIVATE RETVAL sendBuf(
+    GSimSocket *pSock, IPEndPoint *pDst, const U8 *pBuf, U32 len)
 {
-    S32 rs; /* Number of times to execute recv().
-             * For TCP with 1 socket per call: no. of events returned by poll
-             * For UDP and TCP with 1 global socket:recv_count is a flag that
-             * stays up as long as there's data to read
-             */
-
-    /* Get socket events. */
-    rs = poll(s_pollFdArr, s_pollFdCnt, wait);
-    if ((rs < 0) && (errno == EINTR))
+    if (IP_ADDR_TYPE_V4 == pDst->ipAddr.ipAddrType)
     {
-        LOG_ERROR("poll() error, [%s]", strerror(errno));
-        return;
+        return sendBufV4(pSock, pDst, pBuf, len);
     }
 
-    for (U32 pollIndx = 0; rs > 0 && pollIndx < s_pollFdCnt; pollIndx++)
+    return sendBufV6(pSock, pDst, pBuf, len);
+}
+
+/**
+ * @brief
+ *    Sends the message, or parks it in the transmit queue of the socket
+ *    when the socket send buffer is full. A message is never sent ahead
+ *    of the messages already parked on the socket
+ *
+ * @param pSock
+ * @param pDst
+ * @param data
+ *    freed by this function if not NULL, otherwise pBuf is copied when
+ *    the message has to be parked
+ * @param pBuf
+ * @param len
+ *
+ * @return
+ *    ROK if the message is sent or parked
+ */
+PRIVATE RETVAL sendOrPark(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data,
+    const U8 *pBuf, U32 len)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret = ERR_SYS_SOCK_SEND_AGAIN;
+
+    if (0 == pSock->txQueueLen())
     {
-        GSimSocket *pSock = g_gsimSockArr[pollIndx];
+        ret = sendBuf(pSock, pDst, pBuf, len);
+    }
 
-        if (NULL == pSock)
+    if (ERR_SYS_SOCK_SEND_AGAIN == ret)
+    {
+        if (NULL == data)
         {
-            LOG_FATAL("Null Socket, Sock Array. Index [%d]", pollIndx);
-            continue;
+            data = new Buffer;
+            BUFFER_CPY(data, pBuf, len);
         }
 
-        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLOUT))
-        {
-            GSIM_UNSET_MASK(s_pollFdArr[pollIndx].events, POLLOUT);
-        }
+        LOG_EXITFN(pSock->parkMsg(pDst, data));
+    }
 
-        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLIN))
-        {
-            rs--;
+    delete data;
+    LOG_EXITFN(ret);
+}
 
-            switch (pSock->type())
-            {
-            case SOCK_TYPE_GTPC:
-            {
-                LOG_DEBUG("Reading GTP-C socket");
-                RETVAL ret = handleGtpcSock(pSock);
-                if (ROK != ret)
-                {
-                    LOG_ERROR("Reading GTP-C socket");
-                }
+/**
+ * @brief
+ *    Parks a message until the socket is writable, POLLOUT is watched as
+ *    long as the queue is not empty. The message is dropped if the queue
+ *    is full
+ *
+ * @param pDst
+ * @param data
+ *    owned by the queue from here on
+ *
+ * @return
+ */
+RETVAL GSimSocket::parkMsg(IPEndPoint *pDst, Buffer *data)
+{
+    if (m_txQueue.size() >= GSIM_MAX_TX_QUEUE_LEN)
+    {
+        LOG_ERROR("Transmit queue full, message dropped, FD [%d]", m_fd);
+        Stats::incStats(GSIM_STAT_TX_QUEUE_DROPS);
+        delete data;
+        return ERR_SYS_SOCK_SEND;
+    }
 
-                break;
-            }
+    if (m_txQueue.empty())
+    {
+        m_stallStart = getMilliSeconds();
+        GSIM_SET_MASK(s_pollFdArr[m_pollFdIndex].events, POLLOUT);
+    }
 
-            case SOCK_TYPE_GTPU:
-            {
-                LOG_DEBUG("Reading GTP-U socket");
-                RETVAL ret = handleGtpuSock(pSock);
-                if (ROK != ret)
-                {
-                    LOG_ERROR("Reading GTP-U socket");
-                }
+    TxMsg_t msg;
+    msg.pData = data;
+    msg.dst   = *pDst;
+    m_txQueue.push_back(msg);
 
-                break;
-            }
+    s_txParked++;
+    Stats::incStats(GSIM_STAT_TX_QUEUE_DEPTH);
 
-            case SOCK_TYPE_STDIN:
-            {
-                LOG_DEBUG("Reading Keyboard Event");
-                handleStdinSock(pSock);
-                break;
-            }
+    return ROK;
+}
 
-            default:
-            {
-                break;
-            }
-            }
-        }
-        else if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLERR))
+/**
+ * @brief
+ *    Sends the parked messages once the socket is writable, stops at the
+ *    first message the socket does not accept
+ */
+VOID GSimSocket::drainTxQueue()
+{
+    while (!m_txQueue.empty())
+    {
+        TxMsg_t *pMsg = &m_txQueue.front();
+        if (ERR_SYS_SOCK_SEND_AGAIN ==
+            sendBuf(this, &pMsg->dst, pMsg->pData->pVal, pMsg->pData->len))
         {
-            LOG_FATAL("Socket Error, FD [%d]", pSock->fd());
-            delete pSock;
+            return;
         }
 
-        s_pollFdArr[pollIndx].revents = 0;
+        delete pMsg->pData;
+        m_txQueue.pop_front();
+
+        s_txParked--;
+        Stats::decStats(GSIM_STAT_TX_QUEUE_DEPTH);
+    }
+
+    GSIM_UNSET_MASK(s_pollFdArr[m_pollFdIndex].events, POLLOUT);
+    if (0 != m_stallStart)
+    {
+        Stats::addStats(GSIM_STAT_TX_STALL_MS,
+            getMilliSeconds() - m_stallStart);
+        m_stallStart = 0;
     }
 }
 
 /**
  * @brief
- *    Handles keyboard event
+ *    Converts a SO_TIMESTAMPING or SO_TIMESTAMPNS control message into
+ *    the time base of getMicroSeconds()
  *
- * @param pSock
+ * @param pCmsg
+ *
+ * @return
+ *    0 if the control message is not a timestamp
  */
-PRIVATE VOID handleStdinSock(GSimSocket *pSock)
+PRIVATE Time_t cmsgToTstamp(struct cmsghdr *pCmsg)
 {
-    LOG_ENTERFN();
+    struct timespec ts;
 
-    if (feof(stdin))
+    if (SO_TIMESTAMPING != pCmsg->cmsg_type &&
+        SO_TIMESTAMPNS != pCmsg->cmsg_type)
     {
-        delete pSock;
+        return 0;
     }
 
-    S32 input = getchar();
-    if (input == EOF)
+    /* software timestamp is the first of the three of SO_TIMESTAMPING */
+    MEMCPY(&ts, CMSG_DATA(pCmsg), sizeof(ts));
+
+    if (0 == ts.tv_sec && 0 == ts.tv_nsec)
     {
-        LOG_EXITVOID();
+        return 0;
     }
-    else
+
+    return wallToMicroSeconds(
+        (Time_t)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000LL);
+}
+
+PRIVATE Time_t getRxTstamp(struct msghdr *pHdr)
+{
+    for (struct cmsghdr *pCmsg = CMSG_FIRSTHDR(pHdr); NULL != pCmsg;
+         pCmsg = CMSG_NXTHDR(pHdr, pCmsg))
     {
-        Keyboard::getInstance()->processKey(input);
+        if (SOL_SOCKET == pCmsg->cmsg_level)
+        {
+            return cmsgToTstamp(pCmsg);
+        }
     }
 
-    LOG_EXITVOID();
+    return 0;
 }
 
 /**
  * @brief
- *    Hanldes GTP-C socket, reads GTP-C messages
- *
- * @param pSock
+ *    Records the time a received message waited in gsim, from the kernel
+ *    receive timestamp till the message is processed
  *
- * @return
+ * @param tstamp
+ *    kernel receive time, nothing is recorded if 0
  */
-PRIVATE RETVAL handleGtpcSock(GSimSocket *pSock)
+PRIVATE VOID recordRxDelay(Time_t tstamp)
 {
-    LOG_ENTERFN();
+    if (0 == tstamp)
+    {
+        return;
+    }
 
-    RETVAL ret   = ROK;
-    U32    loops = GSIM_MAX_RECV_LOOPS;
+    Time_t now = getMicroSeconds();
+    Stats::recordLatency(GSIM_HIST_RX_DELAY, (now > tstamp) ? now - tstamp : 0);
+}
 
-    while (loops && (ROK == ret))
+/**
+ * @brief
+ *    Samples the memory of the GTP-C and GTP-U sockets once every
+ *    GSIM_SOCK_SAMPLE_MS. The fill level is the highest of all sockets,
+ *    the datagrams dropped by the kernel are accounted separately from
+ *    the requests the peer did not answer
+ */
+PRIVATE VOID sampleSockets()
+{
+    Time_t currTime = getMilliSeconds();
+    if (currTime < s_nextSockSample)
     {
-        UdpData_t *msg = NULL;
-        ret            = pSock->recvMsg(&msg);
-        if (ROK == ret)
+        return;
+    }
+    s_nextSockSample = currTime + GSIM_SOCK_SAMPLE_MS;
+
+    U32     rxFill  = 0;
+    U32     txFill  = 0;
+    Counter rxDrops = 0;
+    for (U32 i = 0; i < GSIM_MAX_SOCK_CNT; i++)
+    {
+        GSimSocket *pSock = g_gsimSockArr[i];
+        if (NULL == pSock || (SOCK_TYPE_GTPC != pSock->type() &&
+                SOCK_TYPE_GTPU != pSock->type()))
         {
-            LOG_DEBUG("Process the Received messages", pSock->fd());
-            procGtpcMsg(msg);
+            continue;
         }
 
-        loops--;
-    };
+        U32     sockRxFill  = 0;
+        U32     sockTxFill  = 0;
+        Counter sockRxDrops = 0;
+        if (ROK == pSock->sampleMemInfo(&sockRxFill, &sockTxFill,
+                &sockRxDrops))
+        {
+            rxFill   = (sockRxFill > rxFill) ? sockRxFill : rxFill;
+            txFill   = (sockTxFill > txFill) ? sockTxFill : txFill;
+            rxDrops += sockRxDrops;
+        }
+    }
 
-    LOG_EXITFN(ROK);
+    Stats::addStats(GSIM_STAT_SOCK_RX_DROPS, rxDrops);
+    Stats::setStats(GSIM_STAT_SOCK_RX_FILL, rxFill);
+    Stats::setStats(GSIM_STAT_SOCK_TX_FILL, txFill);
+    if (rxFill > Stats::getStats(GSIM_STAT_SOCK_RX_FILL_PEAK))
+    {
+        Stats::setStats(GSIM_STAT_SOCK_RX_FILL_PEAK, rxFill);
+    }
+    if (txFill > Stats::getStats(GSIM_STAT_SOCK_TX_FILL_PEAK))
+    {
+        Stats::setStats(GSIM_STAT_SOCK_TX_FILL_PEAK, txFill);
+    }
 }
 
 /**
  * @brief
- *    Hanldes GTP-U socket, reads GTP-U Process control messages
- *
- * @param pSock
+ *    Checks if the transmit queues are above the high-water mark. Once
+ *    congested, the queues must drain below the low-water mark before new
+ *    sessions are started again
  *
  * @return
  */
-PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock)
+PUBLIC BOOL isTxCongested()
 {
-    LOG_ENTERFN();
-
-    RETVAL ret = ROK;
+    if (s_txParked >= GSIM_TX_QUEUE_HIGH_WATER)
+    {
+        s_txCongested = TRUE;
+    }
+    else if (s_txParked <= GSIM_TX_QUEUE_LOW_WATER)
+    {
+        s_txCongested = FALSE;
+    }
 
-    LOG_EXITFN(ret);
+    return s_txCongested;
 }
 
-PUBLIC RETVAL initTransport()
+/**
+ * @brief
+ *    Reads the sockets which are ready, waiting upto wait milli seconds
+ *    for an event. A wait of 0 spins on the sockets in busy-poll mode
+ *
+ * @param wait
+ *
+ * @return
+ *    number of socket events processed
+ */
+PUBLIC U32 socketPoll(S32 wait)
 {
-    LOG_ENTERFN();
-
-    S16        ret = ROK;
-    IPEndPoint locListnerEp;
-    IPEndPoint locSenderEp;
+    S32 rs; /* Number of times to execute recv().
+             * For TCP with 1 socket per call: no. of events returned by poll
+             * For UDP and TCP with 1 global socket:recv_count is a flag that
+             * stays up as long as there's data to read
+             */
 
-    Config *pCfg = Config::getInstance();
+    sampleSockets();
 
-    for (U32 i = 0; i < GSIM_MAX_POLL_FDS; i++)
+    if (TRANSPORT_TYPE_URING == s_transportType)
     {
-        s_pollFdArr[i].fd = -1;
+        return uringPoll(wait);
     }
 
-    /* Simulator sends all GTP messages with source udp port number as
-     * Default GTP port + 1, using this socket
-     */
-    locSenderEp.port   = 0;
-    locSenderEp.ipAddr = *pCfg->getLocalIpAddr();
-    s_pSender          = new GSimSocket(SOCK_TYPE_GTPC, locSenderEp);
-    ret                = s_pSender->bindSocket();
-    if (ROK != ret)
+    if (TRANSPORT_TYPE_MMSG == s_transportType)
     {
-        LOG_FATAL("Binding to GTP local sending Socket");
-        LOG_EXITFN(ret);
+        flushSendQueue();
     }
 
-    /* This is the default GTPC socket, where the simlator listens
-     * for initiating messages
-     */
-    locListnerEp.port   = pCfg->getLocalGtpcPort();
-    locListnerEp.ipAddr = *pCfg->getLocalIpAddr();
-    s_pListener         = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp);
-    ret                 = s_pListener->bindSocket();
-    if (ROK != ret)
+    /* Get socket events. */
+    rs = poll(s_pollFdArr, s_pollFdCnt, wait);
+    if ((rs < 0) && (errno == EINTR))
     {
-        LOG_FATAL("Binding to GTP Listener Socket");
-        LOG_EXITFN(ret);
+        LOG_ERROR("poll() error, [%s]", strerror(errno));
+        return 0;
+    }
+
+    U32 numEvents = (rs > 0) ? rs : 0;
+
+    for (U32 pollIndx = 0; rs > 0 && pollIndx < s_pollFdCnt; pollIndx++)
+    {
+        GSimSocket *pSock = g_gsimSockArr[pollIndx];
+
+        if (NULL == pSock)
+        {
+            LOG_FATAL("Null Socket, Sock Array. Index [%d]", pollIndx);
+            continue;
+        }
+
+        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLOUT))
+        {
+            pSock->drainTxQueue();
+        }
+
+        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLIN))
+        {
+            rs--;
+            handleSockEvent(pSock);
+        }
+        else if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLERR))
+        {
+            LOG_FATAL("Socket Error, FD [%d]", pSock->fd());
+            delete pSock;
+        }
+
+        s_pollFdArr[pollIndx].revents = 0;
+    }
+
+    return numEvents;
+}
+
+/**
+ * @brief
+ *    Reads the socket which is ready for reading
+ *
+ * @param pSock
+ */
+PRIVATE VOID handleSockEvent(GSimSocket *pSock)
+{
+    switch (pSock->type())
+    {
+    case SOCK_TYPE_GTPC:
+    {
+        LOG_DEBUG("Reading GTP-C socket");
+        RETVAL ret = handleGtpcSock(pSock);
+        if (ROK != ret)
+        {
+            LOG_ERROR("Reading GTP-C socket");
+        }
+
+        break;
+    }
+
+    case SOCK_TYPE_GTPU:
+    {
+        LOG_DEBUG("Reading GTP-U socket");
+        RETVAL ret = handleGtpuSock(pSock);
+        if (ROK != ret)
+        {
+            LOG_ERROR("Reading GTP-U socket");
+        }
+
+        break;
+    }
+
+    case SOCK_TYPE_GTPU_RING:
+    {
+        LOG_DEBUG("Reading GTP-U ring");
+        RETVAL ret = handleGtpuRing(pSock);
+        if (ROK != ret)
+        {
+            LOG_ERROR("Reading GTP-U ring");
+        }
+
+        break;
+    }
+
+    case SOCK_TYPE_STDIN:
+    {
+        LOG_DEBUG("Reading Keyboard Event");
+        handleStdinSock(pSock);
+        break;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+}
+
+/**
+ * @brief
+ *    Handles keyboard event
+ *
+ * @param pSock
+ */
+PRIVATE VOID handleStdinSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    if (feof(stdin))
+    {
+        delete pSock;
+    }
+
+    S32 input = getchar();
+    if (input == EOF)
+    {
+        LOG_EXITVOID();
+    }
+    else
+    {
+        Keyboard::getInstance()->processKey(input);
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-C socket, reads GTP-C messages
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpcSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret   = ROK;
+    U32    loops = GSIM_MAX_RECV_LOOPS;
+
+    if (TRANSPORT_TYPE_MMSG == s_transportType)
+    {
+        LOG_EXITFN(handleGtpcSockBatch(pSock));
+    }
+
+    if (s_responderMode)
+    {
+        LOG_EXITFN(handleGtpcSockStateless(pSock));
+    }
+
+    while (loops && (ROK == ret))
+    {
+        UdpData_t *msg = NULL;
+        ret            = pSock->recvMsg(&msg);
+        if (ROK == ret)
+        {
+            LOG_DEBUG("Process the Received messages", pSock->fd());
+            pSock->countRx();
+            procGtpcMsg(msg);
+        }
+
+        loops--;
+    };
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-C socket in responder mode, the requests are processed
+ *    from the socket read buffer without any allocation
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpcSockStateless(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    U32        loops  = GSIM_MAX_RECV_LOOPS;
+    U8        *pBuf   = NULL;
+    U32        len    = 0;
+    Time_t     tstamp = 0;
+    IPEndPoint peerEp;
+
+    while (loops)
+    {
+        RETVAL ret = ROK;
+        if (s_timestamps)
+        {
+            ret = pSock->recvMsg(&pBuf, &len, &peerEp, &tstamp);
+            recordRxDelay(tstamp);
+        }
+        else
+        {
+            ret = pSock->recvMsg(&pBuf, &len, &peerEp);
+        }
+
+        if (ROK != ret)
+        {
+            break;
+        }
+
+        pSock->countRx();
+        procGtpcMsgStateless(pSock->connId(), &peerEp, pBuf, len);
+        loops--;
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-C socket of mmsg transport, the messages are read in
+ *    batches of GSIM_MAX_RECV_BATCH with a single system call
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpcSockBatch(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    U32 loops   = GSIM_MAX_RECV_LOOPS;
+    U32 numRecv = GSIM_MAX_RECV_BATCH;
+
+    while (loops && (GSIM_MAX_RECV_BATCH == numRecv))
+    {
+        for (U32 i = 0; i < GSIM_MAX_RECV_BATCH; i++)
+        {
+            s_gtpcRecvVecs[i].pBuf   = s_gtpcRecvBufs[i];
+            s_gtpcRecvVecs[i].bufLen = GSIM_UDP_READ_LEN;
+        }
+
+        numRecv = pSock->recvMsgBatch(s_gtpcRecvVecs, GSIM_MAX_RECV_BATCH,
+            s_gtpcPeerEps);
+        for (U32 i = 0; i < numRecv; i++)
+        {
+            if (s_gtpcRecvVecs[i].len > GSIM_UDP_READ_LEN)
+            {
+                LOG_ERROR("Truncated GTP-C message dropped");
+                continue;
+            }
+
+            procGtpcBuf(pSock, &s_gtpcPeerEps[i], s_gtpcRecvVecs[i].pBuf,
+                s_gtpcRecvVecs[i].len, s_gtpcRecvVecs[i].tstamp);
+        }
+
+        loops--;
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Processes a GTP-C message read by mmsg or uring transport. The
+ *    message is copied into a socket buffer unless the responder answers
+ *    it in place
+ *
+ * @param pSock
+ * @param pPeerEp
+ * @param pBuf
+ * @param len
+ * @param tstamp
+ *    kernel receive time, 0 if not known
+ */
+PRIVATE VOID procGtpcBuf(GSimSocket *pSock, IPEndPoint *pPeerEp, U8 *pBuf,
+    U32 len, Time_t tstamp)
+{
+    recordRxDelay(tstamp);
+    pSock->countRx();
+
+    if (s_responderMode)
+    {
+        procGtpcMsgStateless(pSock->connId(), pPeerEp, pBuf, len);
+        return;
+    }
+
+    UdpData_t *msg = new UdpData_t;
+    BUFFER_CPY(&msg->buf, pBuf, len);
+    msg->connId = pSock->connId();
+    msg->peerEp = *pPeerEp;
+    msg->tstamp = (0 != tstamp) ? tstamp : getMicroSeconds();
+    procGtpcMsg(msg);
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-U socket with GRO, the coalesced messages are read
+ *    completely and split into the G-PDUs
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpuSockGro(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    U32 loops   = GSIM_MAX_RECV_LOOPS;
+    U32 numRecv = GSIM_GRO_RECV_BATCH;
+
+    while (loops && (GSIM_GRO_RECV_BATCH == numRecv))
+    {
+        for (U32 i = 0; i < GSIM_GRO_RECV_BATCH; i++)
+        {
+            s_gtpuRecvVecs[i].pBuf   = s_groRecvBufs[i];
+            s_gtpuRecvVecs[i].bufLen = GSIM_GRO_BUF_LEN;
+        }
+
+        numRecv = pSock->recvMsgBatch(s_gtpuRecvVecs, GSIM_GRO_RECV_BATCH);
+
+        U32 numSegs = 0;
+        for (U32 i = 0; i < numRecv; i++)
+        {
+            RecvVec_t *pMsg   = &s_gtpuRecvVecs[i];
+            U32        segLen = pMsg->segLen;
+            U32        len    = (pMsg->len < pMsg->bufLen) ? \
+                                pMsg->len : pMsg->bufLen;
+
+            if (0 == segLen || segLen >= len)
+            {
+                segLen = len;
+            }
+
+            for (U32 off = 0; off < len && numSegs < \
+                 GSIM_GRO_RECV_BATCH * GSIM_GRO_MAX_SEGS; off += segLen)
+            {
+                RecvVec_t *pSeg = &s_groSegVecs[numSegs++];
+                pSeg->pBuf   = pMsg->pBuf + off;
+                pSeg->len    = (len - off < segLen) ? len - off : segLen;
+                pSeg->bufLen = pSeg->len;
+                pSeg->segLen = 0;
+            }
+        }
+
+        procGtpuMsgBatch(s_groSegVecs, numSegs);
+        loops--;
     }
 
     LOG_EXITFN(ROK);
 }
 
-GSimSocket::GSimSocket(SockType_t sockType)
+/**
+ * @brief
+ *    Hanldes GTP-U socket, the G-PDUs are read in batches and only the
+ *    headers of each G-PDU are read out of the socket
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    U32 loops   = GSIM_MAX_RECV_LOOPS;
+    U32 numRecv = GSIM_MAX_RECV_BATCH;
+
+    if (GSIM_CHK_MASK(s_gtpuOffload, GSIM_GTPU_OFFLOAD_GRO))
+    {
+        LOG_EXITFN(handleGtpuSockGro(pSock));
+    }
+
+    while (loops && (GSIM_MAX_RECV_BATCH == numRecv))
+    {
+        for (U32 i = 0; i < GSIM_MAX_RECV_BATCH; i++)
+        {
+            s_gtpuRecvVecs[i].pBuf   = s_gtpuRecvBufs[i];
+            s_gtpuRecvVecs[i].bufLen = GSIM_GTPU_PEEK_LEN;
+        }
+
+        numRecv = pSock->recvMsgBatch(s_gtpuRecvVecs, GSIM_MAX_RECV_BATCH);
+        procGtpuMsgBatch(s_gtpuRecvVecs, numRecv);
+        loops--;
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Hanldes the rx ring of GTP-U interface, the datagrams are read in
+ *    place from the ring blocks
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpuRing(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    U32 loops   = GSIM_MAX_RECV_LOOPS;
+    U32 numRecv = 0;
+
+    do
+    {
+        numRecv = s_pGtpuRing->recvMsgBatch(s_gtpuRecvVecs,
+            GSIM_MAX_RECV_BATCH);
+        procGtpuMsgBatch(s_gtpuRecvVecs, numRecv);
+        loops--;
+    } while (loops && (0 != numRecv));
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Opens the packet rings on the GTP-U interface, the rx ring is polled
+ *    with the sockets. The tx frames are large enough for the configured
+ *    G-PDU size
+ *
+ * @return
+ */
+PRIVATE RETVAL initGtpuRing()
+{
+    LOG_ENTERFN();
+
+    Config *pCfg    = Config::getInstance();
+    U32     pktSize = pCfg->getGtpuPktSize();
+
+    if (IP_ADDR_TYPE_V4 != pCfg->getLocalIpAddr()->ipAddrType)
+    {
+        LOG_FATAL("GTP-U interface supports only IPv4");
+        LOG_EXITFN(ERR_SYS_SOCKET_CREATE);
+    }
+
+    if (DFLT_GTPU_PKT_SIZE_IMIX == pktSize)
+    {
+        pktSize = 1500;
+    }
+
+    s_pGtpuRing = new PacketRing;
+    RETVAL ret  = s_pGtpuRing->open(pCfg->getGtpuIface().c_str(),
+        pCfg->getGtpuLocalPort(), GSIM_RING_GTPU_OVERHEAD + pktSize);
+    if (ROK != ret)
+    {
+        LOG_FATAL("Opening packet ring on [%s]", pCfg->getGtpuIface().c_str());
+        LOG_EXITFN(ret);
+    }
+
+    s_pGtpuSock = new GSimSocket(SOCK_TYPE_GTPU_RING, s_pGtpuRing->rxFd());
+
+    LOG_EXITFN(ROK);
+}
+
+PUBLIC RETVAL initTransport()
+{
+    LOG_ENTERFN();
+
+    S16        ret = ROK;
+    IPEndPoint locListnerEp;
+    IPEndPoint locSenderEp;
+
+    Config *pCfg = Config::getInstance();
+
+    s_responderMode = pCfg->getResponderMode();
+    s_transportType = pCfg->getTransportType();
+    s_timestamps    = pCfg->getTimestamps();
+
+    for (U32 i = 0; i < GSIM_MAX_POLL_FDS; i++)
+    {
+        s_pollFdArr[i].fd = -1;
+    }
+
+    if (TRANSPORT_TYPE_URING == s_transportType && ROK != initUring())
+    {
+        LOG_ERROR("io_uring not available, using poll transport");
+        s_transportType = TRANSPORT_TYPE_POLL;
+    }
+    else if (TRANSPORT_TYPE_MMSG == s_transportType)
+    {
+        s_pSendSlots = new SendSlot_t[GSIM_MAX_SEND_BATCH];
+    }
+
+    /* Simulator sends the initiating GTP messages from an ephemeral port
+     * of local-ip, or from each of the local endpoints configured
+     */
+    std::vector<IPEndPoint> localEps = pCfg->getLocalEndpoints();
+    if (localEps.empty())
+    {
+        locSenderEp.port   = 0;
+        locSenderEp.ipAddr = *pCfg->getLocalIpAddr();
+        localEps.push_back(locSenderEp);
+    }
+
+    for (U32 i = 0; i < localEps.size(); i++)
+    {
+        GSimSocket *pSender = new GSimSocket(SOCK_TYPE_GTPC, localEps[i]);
+        ret                 = pSender->bindSocket();
+        if (ROK != ret)
+        {
+            LOG_FATAL("Binding to GTP local sending Socket");
+            LOG_EXITFN(ret);
+        }
+        s_senders.push_back(pSender);
+    }
+
+    /* This is the default GTPC socket, where the simlator listens
+     * for initiating messages
+     */
+    locListnerEp.port   = pCfg->getLocalGtpcPort();
+    locListnerEp.ipAddr = *pCfg->getLocalIpAddr();
+    s_pListener         = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp);
+    ret                 = s_pListener->bindSocket();
+    if (ROK != ret)
+    {
+        LOG_FATAL("Binding to GTP Listener Socket");
+        LOG_EXITFN(ret);
+    }
+
+    /* GTP-U socket for user plane traffic on the bearers */
+    if (((0 != pCfg->getGtpuRate()) || pCfg->getGtpuSink()) &&
+        !pCfg->getGtpuIface().empty())
+    {
+        LOG_EXITFN(initGtpuRing());
+    }
+    else if ((0 != pCfg->getGtpuRate()) || pCfg->getGtpuSink())
+    {
+        IPEndPoint locGtpuEp;
+        locGtpuEp.port   = pCfg->getGtpuLocalPort();
+        locGtpuEp.ipAddr = *pCfg->getLocalIpAddr();
+        s_pGtpuSock      = new GSimSocket(SOCK_TYPE_GTPU, locGtpuEp);
+        ret              = s_pGtpuSock->bindSocket();
+        if (ROK != ret)
+        {
+            LOG_FATAL("Binding to GTP-U Socket");
+            LOG_EXITFN(ret);
+        }
+
+        if (pCfg->getGtpuOffload())
+        {
+            probeGtpuOffload(s_pGtpuSock);
+        }
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Enables GRO on the GTP-U socket and checks if GSO is supported, the
+ *    socket options are not known to kernels older than 4.18 (GSO) and
+ *    5.0 (GRO). An offload not supported is not used
+ *
+ * @param pSock
+ */
+PRIVATE VOID probeGtpuOffload(GSimSocket *pSock)
+{
+    S32 val = 0;
+
+    /* segment size is given per message, only support is checked here */
+    if (0 == setsockopt(pSock->fd(), SOL_UDP, UDP_SEGMENT, &val, sizeof(val)))
+    {
+        GSIM_SET_MASK(s_gtpuOffload, GSIM_GTPU_OFFLOAD_GSO);
+    }
+    else
+    {
+        LOG_INFO("UDP GSO not supported, [%s]", strerror(errno));
+    }
+
+    val = 1;
+    if (0 == setsockopt(pSock->fd(), SOL_UDP, UDP_GRO, &val, sizeof(val)))
+    {
+        GSIM_SET_MASK(s_gtpuOffload, GSIM_GTPU_OFFLOAD_GRO);
+    }
+    else
+    {
+        LOG_INFO("UDP GRO not supported, [%s]", strerror(errno));
+    }
+}
+
+PUBLIC U32 numSenders()
+{
+    return s_senders.size();
+}
+
+PUBLIC TransConnId getSenderConnId(U32 indx)
+{
+    return s_senders[indx]->connId();
+}
+
+PUBLIC VOID getSenderStats(U32 indx, LocalEpStats_t *pStats)
+{
+    GSimSocket *pSock = s_senders[indx];
+    pStats->ep        = *pSock->localEp();
+    pStats->txMsgs    = pSock->txMsgs();
+    pStats->rxMsgs    = pSock->rxMsgs();
+}
+
+PUBLIC TransConnId getGtpuConnId()
+{
+    return s_pGtpuSock->connId();
+}
+
+PUBLIC U32 getGtpuOffload()
+{
+    return s_gtpuOffload;
+}
+
+PUBLIC PacketRing *getGtpuRing()
+{
+    return s_pGtpuRing;
+}
+
+GSimSocket::GSimSocket(SockType_t sockType)
+{
+    if (SOCK_TYPE_STDIN == sockType)
+    {
+        m_fd                               = fileno(stdin);
+        m_type                             = sockType;
+        m_stallStart                       = 0;
+        m_rxDrops                          = 0;
+        m_txMsgs                           = 0;
+        m_rxMsgs                           = 0;
+        m_pollFdIndex                      = s_pollFdCnt++;
+        g_gsimSockArr[m_pollFdIndex]       = this;
+        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
+        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
+        s_pollFdArr[m_pollFdIndex].revents = 0;
+    }
+    else
+    {
+        throw ERR_INV_SOCKET_TYPE;
+    }
+}
+
+/**
+ * @brief
+ *    Polls a file descriptor opened outside, e.g. of a packet ring. The
+ *    descriptor is closed by its owner
+ *
+ * @param sockType
+ * @param fd
+ */
+GSimSocket::GSimSocket(SockType_t sockType, S32 fd)
+{
+    if (SOCK_TYPE_GTPU_RING == sockType)
+    {
+        m_fd                               = fd;
+        m_type                             = sockType;
+        m_stallStart                       = 0;
+        m_rxDrops                          = 0;
+        m_txMsgs                           = 0;
+        m_rxMsgs                           = 0;
+        m_pollFdIndex                      = s_pollFdCnt++;
+        g_gsimSockArr[m_pollFdIndex]       = this;
+        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
+        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
+        s_pollFdArr[m_pollFdIndex].revents = 0;
+    }
+    else
+    {
+        throw ERR_INV_SOCKET_TYPE;
+    }
+}
+
+GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep)
+{
+    if (SOCK_TYPE_STDIN != sockType)
+    {
+        if (IP_ADDR_TYPE_V4 == ep.ipAddr.ipAddrType)
+        {
+            m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+        }
+        else
+        {
+            m_fd = socket(AF_INET6, SOCK_DGRAM, 0);
+        }
+
+        if (m_fd < 0)
+        {
+            LOG_FATAL("socket system call, [%s]", strerror(errno));
+            throw ERR_SYS_SOCKET_CREATE;
+        }
+
+        if (fcntl(m_fd, F_SETFL, O_NONBLOCK) < 0)
+        {
+            LOG_FATAL("socket system call, [%s]", strerror(errno));
+            throw ERR_SYS_SOCK_CNTRL;
+        }
+
+        m_type                             = sockType;
+        m_pollFdIndex                      = s_pollFdCnt++;
+        m_ep                               = ep;
+        m_stallStart                       = 0;
+        m_rxDrops                          = 0;
+        m_txMsgs                           = 0;
+        m_rxMsgs                           = 0;
+        g_gsimSockArr[m_pollFdIndex]       = this;
+        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
+        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
+        s_pollFdArr[m_pollFdIndex].revents = 0;
+
+        Config *pCfg = Config::getInstance();
+        setBufSize(SO_RCVBUF, SO_RCVBUFFORCE, pCfg->getSockRcvBuf());
+        setBufSize(SO_SNDBUF, SO_SNDBUFFORCE, pCfg->getSockSndBuf());
+
+        if (SOCK_TYPE_GTPC == sockType && s_timestamps)
+        {
+            enableTimestamps();
+        }
+
+        S32 busyPoll = GSIM_BUSY_POLL_USEC;
+        if (pCfg->getBusyPoll() && (SOCK_TYPE_GTPC == sockType ||
+                SOCK_TYPE_GTPU == sockType) &&
+            setsockopt(m_fd, SOL_SOCKET, SO_BUSY_POLL, &busyPoll,
+                sizeof(busyPoll)) < 0)
+        {
+            LOG_ERROR("SO_BUSY_POLL not set, [%s]", strerror(errno));
+        }
+    }
+    else
+    {
+        throw ERR_INV_SOCKET_TYPE;
+    }
+}
+
+/**
+ * @brief
+ *    Sets the socket buffer size. The FORCE option is tried first, it is
+ *    not limited by rmem_max/wmem_max but needs CAP_NET_ADMIN
+ *
+ * @param opt
+ *    SO_RCVBUF or SO_SNDBUF
+ * @param forceOpt
+ *    SO_RCVBUFFORCE or SO_SNDBUFFORCE
+ * @param size
+ *    bytes
+ */
+VOID GSimSocket::setBufSize(S32 opt, S32 forceOpt, U32 size)
+{
+    if (setsockopt(m_fd, SOL_SOCKET, forceOpt, &size, sizeof(size)) < 0 &&
+        setsockopt(m_fd, SOL_SOCKET, opt, &size, sizeof(size)) < 0)
+    {
+        LOG_ERROR("setsockopt() Failed, [%s]", strerror(errno));
+        return;
+    }
+
+    /* the kernel doubles the requested size for its bookkeeping */
+    U32       actual = 0;
+    socklen_t optLen = sizeof(actual);
+    if (getsockopt(m_fd, SOL_SOCKET, opt, &actual, &optLen) == 0 &&
+        actual / 2 < size)
+    {
+        LOG_ERROR("Socket %s buffer is %u bytes instead of %u, raise "
+            "net.core.%s", (SO_RCVBUF == opt) ? "receive" : "send",
+            actual / 2, size, (SO_RCVBUF == opt) ? "rmem_max" : "wmem_max");
+    }
+}
+
+/**
+ * @brief
+ *    Enables software receive timestamps, taken by the kernel when the
+ *    datagram is received from the device. SO_TIMESTAMPNS is used on the
+ *    kernels without SO_TIMESTAMPING. Without either the receive time is
+ *    taken when the message is read
+ */
+VOID GSimSocket::enableTimestamps()
+{
+    U32 flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+            sizeof(flags)) == 0)
+    {
+        return;
+    }
+
+    S32 on = 1;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) < 0)
+    {
+        LOG_ERROR("Socket timestamps not supported, [%s]", strerror(errno));
+    }
+}
+
+/**
+ * @brief
+ *    Samples the kernel memory of the socket. The queued bytes are read
+ *    with SO_MEMINFO instead of SIOCINQ, which gives only the length of
+ *    the first datagram on a UDP socket
+ *
+ * @param pRxFill
+ *    receive buffer in use, percent
+ * @param pTxFill
+ *    send buffer in use, percent
+ * @param pRxDrops
+ *    datagrams dropped by the kernel since the last sample
+ *
+ * @return
+ */
+RETVAL GSimSocket::sampleMemInfo(U32 *pRxFill, U32 *pTxFill,
+    Counter *pRxDrops)
+{
+    U32       memInfo[SK_MEMINFO_VARS];
+    socklen_t optLen = sizeof(memInfo);
+
+    MEMSET(memInfo, 0, sizeof(memInfo));
+    if (getsockopt(m_fd, SOL_SOCKET, SO_MEMINFO, memInfo, &optLen) < 0 ||
+        optLen <= SK_MEMINFO_DROPS * sizeof(U32))
+    {
+        return RFAILED;
+    }
+
+    *pRxFill = (0 == memInfo[SK_MEMINFO_RCVBUF]) ? 0 :
+        (U64)memInfo[SK_MEMINFO_RMEM_ALLOC] * 100 / memInfo[SK_MEMINFO_RCVBUF];
+    *pTxFill = (0 == memInfo[SK_MEMINFO_SNDBUF]) ? 0 :
+        (U64)memInfo[SK_MEMINFO_WMEM_ALLOC] * 100 / memInfo[SK_MEMINFO_SNDBUF];
+
+    /* the kernel counter is cumulative for the life of the socket */
+    *pRxDrops = memInfo[SK_MEMINFO_DROPS] - m_rxDrops;
+    m_rxDrops = memInfo[SK_MEMINFO_DROPS];
+
+    return ROK;
+}
+
+S32 GSimSocket::fd()
+{
+    return m_fd;
+}
+
+IpAddrTypeEn GSimSocket::ipAddrType()
+{
+    return m_ep.ipAddr.ipAddrType;
+}
+
+SockType_t GSimSocket::type()
+{
+    return m_type;
+}
+
+TransConnId GSimSocket::connId()
+{
+    return m_pollFdIndex;
+}
+
+GSimSocket::~GSimSocket()
+{
+    LOG_DEBUG("Deallocating socket, Sock FD [%d]", m_fd);
+
+    s_pollFdCnt--;
+    s_pollFdArr[m_pollFdIndex].fd = 0;
+    g_gsimSockArr[m_pollFdIndex]  = NULL;
+
+    while (!m_txQueue.empty())
+    {
+        delete m_txQueue.front().pData;
+        m_txQueue.pop_front();
+        s_txParked--;
+        Stats::decStats(GSIM_STAT_TX_QUEUE_DEPTH);
+    }
+
+    if (SOCK_TYPE_GTPU_RING != m_type)
+    {
+        close(m_fd);
+    }
+}
+
+RETVAL GSimSocket::bindSocket()
+{
+    S16                 ret = ROK;
+    struct sockaddr_in  addr;
+    struct sockaddr_in6 addr6;
+
+    if (IP_ADDR_TYPE_V4 == m_ep.ipAddr.ipAddrType)
+    {
+        addr.sin_addr.s_addr = htonl(m_ep.ipAddr.u.ipv4Addr.addr);
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(m_ep.port);
+        MEMSET(addr.sin_zero, '\0', sizeof(addr.sin_zero));
+    }
+    else
+    {
+        MEMSET(&addr6, 0, sizeof(addr6));
+        MEMCPY(addr6.sin6_addr.s6_addr, m_ep.ipAddr.u.ipv6Addr.addr,
+            m_ep.ipAddr.u.ipv6Addr.len);
+        addr6.sin6_family = AF_INET6;
+        addr6.sin6_port   = htons(m_ep.port);
+    }
+
+    if (IP_ADDR_TYPE_V4 == m_ep.ipAddr.ipAddrType)
+    {
+        ret = bind(m_fd, (struct sockaddr *)&addr, sizeof(addr));
+    }
+    else
+    {
+        ret = bind(m_fd, (struct sockaddr *)&addr6, sizeof(addr6));
+    }
+
+    if (ret < 0)
+    {
+        LOG_FATAL("Socket Binding Failed, [%s]", strerror(errno));
+        return ERR_SYS_SOCKET_BIND;
+    }
+
+    /* the ephemeral port, for the statistics of the endpoint */
+    if (0 == m_ep.port)
+    {
+        struct sockaddr_storage local;
+        socklen_t               localLen = sizeof(local);
+        if (0 == getsockname(m_fd, (struct sockaddr *)&local, &localLen))
+        {
+            m_ep.port = (AF_INET == local.ss_family) ?
+                ntohs(((struct sockaddr_in *)&local)->sin_port) :
+                ntohs(((struct sockaddr_in6 *)&local)->sin6_port);
+        }
+    }
+
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Creates the socket for listening on Keyboard events from the user
+ */
+PUBLIC RETVAL setupStdinSock()
+{
+    LOG_ENTERFN();
+
+    S16 ret = ROK;
+
+    try
+    {
+        GSimSocket *pKbSock = new GSimSocket(SOCK_TYPE_STDIN);
+        (VOID) pKbSock;
+    }
+    catch (ErrCodeEn &e)
+    {
+        ret = ERR_SOCK_ALLOC;
+    }
+
+    LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Sends a batch of messages to the same destination with sendmmsg(),
+ *    GSIM_MAX_SEND_BATCH messages per system call. Sending stops at the
+ *    first failure, e.g. when the socket send buffer is full
+ *
+ * @param connId
+ * @param pDst
+ * @param pMsgs
+ * @param cnt
+ *
+ * @return
+ *    number of messages sent
+ */
+PUBLIC U32 sendMsgBatch(
+    TransConnId connId, IPEndPoint *pDst, SendVec_t *pMsgs, U32 cnt)
+{
+    static struct mmsghdr s_mmsgs[GSIM_MAX_SEND_BATCH];
+    static struct iovec   s_iovs[GSIM_MAX_SEND_BATCH][2];
+    static U8             s_ctrl[GSIM_MAX_SEND_BATCH][CMSG_SPACE(sizeof(U16))];
+
+    struct sockaddr_storage destAddr;
+    socklen_t               destLen = 0;
+    U32                     numSent = 0;
+
+    GSimSocket *pSock = g_gsimSockArr[connId];
+    if (NULL == pSock)
+    {
+        return 0;
+    }
+
+    destLen = epToSockAddr(pDst, &destAddr);
+
+    while (numSent < cnt)
+    {
+        U32 batch = cnt - numSent;
+        if (batch > GSIM_MAX_SEND_BATCH)
+        {
+            batch = GSIM_MAX_SEND_BATCH;
+        }
+
+        for (U32 i = 0; i < batch; i++)
+        {
+            SendVec_t *pMsg = &pMsgs[numSent + i];
+
+            s_iovs[i][0].iov_base = (VOID *)pMsg->pHdr;
+            s_iovs[i][0].iov_len  = pMsg->hdrLen;
+            s_iovs[i][1].iov_base = (VOID *)pMsg->pData;
+            s_iovs[i][1].iov_len  = pMsg->dataLen;
+
+            MEMSET(&s_mmsgs[i], 0, sizeof(struct mmsghdr));
+            s_mmsgs[i].msg_hdr.msg_name    = &destAddr;
+            s_mmsgs[i].msg_hdr.msg_namelen = destLen;
+            s_mmsgs[i].msg_hdr.msg_iov     = s_iovs[i];
+            s_mmsgs[i].msg_hdr.msg_iovlen  = (0 != pMsg->dataLen) ? 2 : 1;
+
+            if (0 != pMsg->segLen)
+            {
+                U16 segLen = pMsg->segLen;
+                s_mmsgs[i].msg_hdr.msg_control    = s_ctrl[i];
+                s_mmsgs[i].msg_hdr.msg_controllen = sizeof(s_ctrl[i]);
+
+                struct cmsghdr *pCmsg = CMSG_FIRSTHDR(&s_mmsgs[i].msg_hdr);
+                pCmsg->cmsg_level = SOL_UDP;
+                pCmsg->cmsg_type  = UDP_SEGMENT;
+                pCmsg->cmsg_len   = CMSG_LEN(sizeof(U16));
+                MEMCPY(CMSG_DATA(pCmsg), &segLen, sizeof(U16));
+            }
+        }
+
+        S32 ret = sendmmsg(pSock->fd(), s_mmsgs, batch, MSG_DONTWAIT);
+        if (ret <= 0)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                LOG_ERROR("Socket sendmmsg() failed, [%s]", strerror(errno));
+
+                /* segmentation offload rejected by the kernel or the
+                 * device, the sender falls back to plain messages
+                 */
+                if (0 != pMsgs[numSent].segLen)
+                {
+                    GSIM_UNSET_MASK(s_gtpuOffload, GSIM_GTPU_OFFLOAD_GSO);
+                }
+            }
+            break;
+        }
+
+        numSent += ret;
+        if ((U32)ret < batch)
+        {
+            break;
+        }
+    }
+
+    return numSent;
+}
+
+PUBLIC RETVAL sendMsg(TransConnId connId, IPEndPoint *pDst, Buffer *data)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret = ROK;
+
+    GSimSocket *pSock = g_gsimSockArr[connId];
+    if (NULL != pSock)
+    {
+        pSock->countTx();
+    }
+
+    if (NULL != pSock && TRANSPORT_TYPE_POLL != s_transportType)
+    {
+        ret = queueMsg(pSock, pDst, data, data->pVal, data->len);
+    }
+    else if (NULL != pSock)
+    {
+        ret = sendOrPark(pSock, pDst, data, data->pVal, data->len);
+    }
+    else
+    {
+        delete data;
+    }
+
+    LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Sends the message without taking the ownership of the buffer
+ *
+ * @param connId
+ * @param pDst
+ * @param pBuf
+ * @param len
+ *
+ * @return
+ */
+PUBLIC RETVAL sendMsg(
+    TransConnId connId, IPEndPoint *pDst, const U8 *pBuf, U32 len)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret = ROK;
+
+    GSimSocket *pSock = g_gsimSockArr[connId];
+    if (NULL != pSock)
+    {
+        pSock->countTx();
+    }
+
+    if (NULL != pSock && TRANSPORT_TYPE_POLL != s_transportType)
+    {
+        ret = queueMsg(pSock, pDst, NULL, pBuf, len);
+    }
+    else if (NULL != pSock)
+    {
+        ret = sendOrPark(pSock, pDst, NULL, pBuf, len);
+    }
+
+    LOG_EXITFN(ret);
+}
+
+PRIVATE VOID sockAddrToEp(struct sockaddr_storage *pAddr, IPEndPoint *pEp)
 {
-    if (SOCK_TYPE_STDIN == sockType)
+    if (AF_INET == pAddr->ss_family)
     {
-        m_fd                               = fileno(stdin);
-        m_type                             = sockType;
-        m_pollFdIndex                      = s_pollFdCnt++;
-        g_gsimSockArr[m_pollFdIndex]       = this;
-        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
-        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
-        s_pollFdArr[m_pollFdIndex].revents = 0;
+        struct sockaddr_in *pFrom = (struct sockaddr_in *)pAddr;
+        pEp->ipAddr.ipAddrType      = IP_ADDR_TYPE_V4;
+        pEp->ipAddr.u.ipv4Addr.addr = ntohl(pFrom->sin_addr.s_addr);
+        pEp->port                   = ntohs(pFrom->sin_port);
     }
     else
     {
-        throw ERR_INV_SOCKET_TYPE;
+        struct sockaddr_in6 *pFrom = (struct sockaddr_in6 *)pAddr;
+        pEp->ipAddr.ipAddrType     = IP_ADDR_TYPE_V6;
+        pEp->ipAddr.u.ipv6Addr.len = IPV6_ADDR_MAX_LEN;
+        MEMCPY(pEp->ipAddr.u.ipv6Addr.addr, pFrom->sin6_addr.s6_addr,
+            IPV6_ADDR_MAX_LEN);
+        pEp->port = ntohs(pFrom->sin6_port);
     }
 }
 
-GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep)
+PRIVATE socklen_t epToSockAddr(IPEndPoint *pEp, struct sockaddr_storage *pAddr)
 {
-    if (SOCK_TYPE_STDIN != sockType)
+    MEMSET(pAddr, 0, sizeof(struct sockaddr_storage));
+    if (IP_ADDR_TYPE_V4 == pEp->ipAddr.ipAddrType)
     {
-        if (IP_ADDR_TYPE_V4 == ep.ipAddr.ipAddrType)
+        struct sockaddr_in *pTo = (struct sockaddr_in *)pAddr;
+        pTo->sin_addr.s_addr    = htonl(pEp->ipAddr.u.ipv4Addr.addr);
+        pTo->sin_family         = AF_INET;
+        pTo->sin_port           = htons(pEp->port);
+        return sizeof(struct sockaddr_in);
+    }
+
+    struct sockaddr_in6 *pTo = (struct sockaddr_in6 *)pAddr;
+    MEMCPY(pTo->sin6_addr.s6_addr, pEp->ipAddr.u.ipv6Addr.addr,
+        IPV6_ADDR_MAX_LEN);
+    pTo->sin6_family = AF_INET6;
+    pTo->sin6_port   = htons(pEp->port);
+    return sizeof(struct sockaddr_in6);
+}
+
+/**
+ * @brief
+ *    Adds a message to the send batch of mmsg or uring transport. The
+ *    batch is sent once per scheduler loop by socketPoll(), or when it
+ *    has GSIM_MAX_SEND_BATCH messages. A message for which there is no
+ *    send slot is sent right away, and a message for a socket with parked
+ *    messages is parked behind them
+ *
+ * @param pSock
+ * @param pDst
+ * @param data
+ *    owned by the batch if not NULL, otherwise pBuf is copied
+ * @param pBuf
+ * @param len
+ *
+ * @return
+ */
+PRIVATE RETVAL queueMsg(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data,
+    const U8 *pBuf, U32 len)
+{
+    LOG_ENTERFN();
+
+    SendSlot_t          *pSlot = NULL;
+    struct io_uring_sqe *pSqe  = NULL;
+
+    if (0 == pSock->txQueueLen() && (NULL != data || len <= GSIM_UDP_READ_LEN))
+    {
+        if (TRANSPORT_TYPE_MMSG == s_transportType)
         {
-            m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+            if (GSIM_MAX_SEND_BATCH == s_sendQCnt)
+            {
+                flushSendQueue();
+            }
+            pSlot = &s_pSendSlots[s_sendQCnt++];
         }
-        else
+        else if (!s_uringFreeSlots.empty())
         {
-            m_fd = socket(AF_INET6, SOCK_DGRAM, 0);
-        }
+            pSqe = s_pUring->getSqe();
+            if (NULL == pSqe)
+            {
+                s_pUring->submit(0, 0);
+                pSqe = s_pUring->getSqe();
+            }
 
-        if (m_fd < 0)
-        {
-            LOG_FATAL("socket system call, [%s]", strerror(errno));
-            throw ERR_SYS_SOCKET_CREATE;
+            if (NULL != pSqe)
+            {
+                pSlot = &s_pSendSlots[s_uringFreeSlots.back()];
+                s_uringFreeSlots.pop_back();
+            }
         }
+    }
 
-        if (fcntl(m_fd, F_SETFL, O_NONBLOCK) < 0)
+    if (NULL == pSlot)
+    {
+        LOG_EXITFN(sendOrPark(pSock, pDst, data, pBuf, len));
+    }
+
+    pSlot->pSock = pSock;
+    pSlot->dst   = *pDst;
+    pSlot->pData = data;
+    if (NULL != data)
+    {
+        pSlot->iov.iov_base = data->pVal;
+    }
+    else
+    {
+        MEMCPY(pSlot->buf, pBuf, len);
+        pSlot->iov.iov_base = pSlot->buf;
+    }
+    pSlot->iov.iov_len = len;
+
+    MEMSET(&pSlot->msg, 0, sizeof(struct msghdr));
+    pSlot->msg.msg_name    = &pSlot->addr;
+    pSlot->msg.msg_namelen = epToSockAddr(pDst, &pSlot->addr);
+    pSlot->msg.msg_iov     = &pSlot->iov;
+    pSlot->msg.msg_iovlen  = 1;
+
+    if (NULL != pSqe)
+    {
+        pSqe->opcode    = IORING_OP_SENDMSG;
+        pSqe->fd        = pSlot->pSock->fd();
+        pSqe->addr      = (U64)(unsigned long)&pSlot->msg;
+        pSqe->len       = 1;
+        pSqe->user_data = GSIM_URING_UDATA(GSIM_URING_OP_SEND,
+            pSlot - s_pSendSlots);
+
+        /* a large burst of requests brings a burst of responses larger
+         * than the socket receive buffer, the receive completions are
+         * run only between the submissions
+         */
+        if (s_pUring->pending() >= GSIM_MAX_SEND_BATCH)
         {
-            LOG_FATAL("socket system call, [%s]", strerror(errno));
-            throw ERR_SYS_SOCK_CNTRL;
+            s_pUring->submit(0, 0);
         }
+    }
 
-        m_type                             = sockType;
-        m_pollFdIndex                      = s_pollFdCnt++;
-        m_ep                               = ep;
-        g_gsimSockArr[m_pollFdIndex]       = this;
-        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
-        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
-        s_pollFdArr[m_pollFdIndex].revents = 0;
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Sends the mmsg batch, one sendmmsg() for the consecutive messages of
+ *    a socket. When the socket send buffer is full the rest of the
+ *    messages of the socket are parked on the socket
+ */
+PRIVATE VOID flushSendQueue()
+{
+    static struct mmsghdr s_mmsgs[GSIM_MAX_SEND_BATCH];
 
-        U32 sockRecvBuf = GSIM_MAX_SOCKET_RECV_BUF;
-        if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &sockRecvBuf,
-                sizeof(sockRecvBuf)) < 0)
+    U32 first = 0;
+    while (first < s_sendQCnt)
+    {
+        GSimSocket *pSock = s_pSendSlots[first].pSock;
+        S32        fd     = pSock->fd();
+        U32        last   = first;
+        while (last < s_sendQCnt && pSock == s_pSendSlots[last].pSock)
         {
-            LOG_ERROR("setsockopt() Failed, [%s]", strerror(errno));
+            s_mmsgs[last].msg_hdr = s_pSendSlots[last].msg;
+            s_mmsgs[last].msg_len = 0;
+            last++;
         }
 
-        U32 sockSendBuf = GSIM_MAX_SOCKET_SEND_BUF;
-        if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &sockSendBuf,
-                sizeof(sockSendBuf)) < 0)
+        while (first < last)
         {
-            LOG_ERROR("setsockopt() Failed, [%s]", strerror(errno));
+            S32 ret = sendmmsg(fd, &s_mmsgs[first], last - first,
+                MSG_DONTWAIT);
+            if (ret > 0)
+            {
+                first += ret;
+                continue;
+            }
+
+            if (EAGAIN == errno || EWOULDBLOCK == errno)
+            {
+                for (; first < last; first++)
+                {
+                    SendSlot_t *pSlot = &s_pSendSlots[first];
+                    Buffer     *pData = pSlot->pData;
+                    if (NULL == pData)
+                    {
+                        pData = new Buffer;
+                        BUFFER_CPY(pData, pSlot->buf, pSlot->iov.iov_len);
+                    }
+
+                    pSlot->pData = NULL;
+                    pSock->parkMsg(&pSlot->dst, pData);
+                }
+            }
+            else
+            {
+                LOG_FATAL("Socket sendmmsg() failed, [%s]", strerror(errno));
+                first++;
+            }
         }
     }
-    else
+
+    for (U32 i = 0; i < s_sendQCnt; i++)
     {
-        throw ERR_INV_SOCKET_TYPE;
+        delete s_pSendSlots[i].pData;
+        s_pSendSlots[i].pData = NULL;
     }
-}
 
-S32 GSimSocket::fd()
-{
-    return m_fd;
+    s_sendQCnt = 0;
 }
 
-IpAddrTypeEn GSimSocket::ipAddrType()
+/**
+ * @brief
+ *    Sets up io_uring transport. The GTP-C sockets are read with multishot
+ *    recvmsg into the provided buffers, other sockets are watched with
+ *    multishot poll and read by their handlers
+ *
+ * @return
+ */
+PRIVATE RETVAL initUring()
 {
-    return m_ep.ipAddr.ipAddrType;
-}
+    LOG_ENTERFN();
 
-SockType_t GSimSocket::type()
-{
-    return m_type;
+    s_pUring   = new IoUring;
+    RETVAL ret = s_pUring->init(GSIM_URING_ENTRIES, GSIM_URING_CQ_ENTRIES);
+    if (ROK == ret)
+    {
+        ret = s_pUring->initBufRing(GSIM_URING_BUF_GROUP, GSIM_URING_BUF_CNT,
+            GSIM_URING_BUF_LEN);
+    }
+
+    if (ROK != ret)
+    {
+        delete s_pUring;
+        s_pUring = NULL;
+        LOG_EXITFN(ret);
+    }
+
+    s_pSendSlots = new SendSlot_t[GSIM_URING_SEND_SLOTS];
+    s_uringFreeSlots.reserve(GSIM_URING_SEND_SLOTS);
+    for (U32 i = GSIM_URING_SEND_SLOTS; i > 0; i--)
+    {
+        s_pSendSlots[i - 1].pData = NULL;
+        s_uringFreeSlots.push_back(i - 1);
+    }
+
+    /* the peer address comes before the message in the buffer */
+    MEMSET(&s_uringRecvHdr, 0, sizeof(s_uringRecvHdr));
+    s_uringRecvHdr.msg_namelen = sizeof(struct sockaddr_storage);
+    if (s_timestamps)
+    {
+        s_uringRecvHdr.msg_controllen = GSIM_RECV_CTRL_LEN;
+    }
+
+    for (U32 i = 0; i < GSIM_MAX_SOCK_CNT; i++)
+    {
+        s_uringArmed[i] = FALSE;
+    }
+
+    LOG_EXITFN(ROK);
 }
 
-GSimSocket::~GSimSocket()
+/**
+ * @brief
+ *    Event loop of io_uring transport. The sends queued since the last
+ *    call and the receives of new sockets are submitted, and the
+ *    completions are processed, with a single io_uring_enter(). The
+ *    messages parked on a full socket are retried on every call, as the
+ *    sockets are not polled for POLLOUT
+ *
+ * @param wait
+ *    milli seconds to wait for a completion, with 0 the completion queue
+ *    is read without entering the kernel unless there is something to
+ *    submit
+ *
+ * @return
+ *    number of completions processed
+ */
+PRIVATE U32 uringPoll(S32 wait)
 {
-    LOG_DEBUG("Deallocating socket, Sock FD [%d]", m_fd);
+    for (U32 i = 0; i < GSIM_MAX_SOCK_CNT; i++)
+    {
+        GSimSocket *pSock = g_gsimSockArr[i];
+        if (NULL == pSock)
+        {
+            continue;
+        }
 
-    s_pollFdCnt--;
-    s_pollFdArr[m_pollFdIndex].fd = 0;
-    g_gsimSockArr[m_pollFdIndex]  = NULL;
-    close(m_fd);
+        if (0 != pSock->txQueueLen())
+        {
+            pSock->drainTxQueue();
+        }
+
+        if (!s_uringArmed[i])
+        {
+            uringArm(pSock);
+        }
+    }
+
+    s_pUring->submit((0 != wait) ? 1 : 0, wait);
+
+    struct io_uring_cqe *pCqe = NULL;
+    U32                  cnt  = 0;
+    for (; cnt < GSIM_URING_CQ_ENTRIES &&
+         NULL != (pCqe = s_pUring->peekCqe()); cnt++)
+    {
+        U64 udata = pCqe->user_data;
+        S32 res   = pCqe->res;
+        U32 flags = pCqe->flags;
+
+        /* the completion is consumed before the handlers queue new sqes */
+        s_pUring->cqeSeen();
+
+        switch (GSIM_URING_UDATA_OP(udata))
+        {
+        case GSIM_URING_OP_RECV:
+        {
+            uringRecvDone(GSIM_URING_UDATA_INDX(udata), res, flags);
+            break;
+        }
+
+        case GSIM_URING_OP_SEND:
+        {
+            uringSendDone(GSIM_URING_UDATA_INDX(udata), res);
+            break;
+        }
+
+        case GSIM_URING_OP_POLL:
+        {
+            uringPollDone(GSIM_URING_UDATA_INDX(udata), res, flags, udata);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+        }
+
+        if (TRANSPORT_TYPE_URING != s_transportType)
+        {
+            break;
+        }
+    }
+
+    return cnt;
 }
 
-RETVAL GSimSocket::bindSocket()
+/**
+ * @brief
+ *    Starts the multishot receive of a GTP-C socket, or the multishot
+ *    poll of any other socket
+ *
+ * @param pSock
+ */
+PRIVATE VOID uringArm(GSimSocket *pSock)
 {
-    S16                 ret = ROK;
-    struct sockaddr_in  addr;
-    struct sockaddr_in6 addr6;
+    struct io_uring_sqe *pSqe = s_pUring->getSqe();
+    if (NULL == pSqe)
+    {
+        return;
+    }
 
-    if (IP_ADDR_TYPE_V4 == m_ep.ipAddr.ipAddrType)
+    pSqe->fd = pSock->fd();
+    if (SOCK_TYPE_GTPC == pSock->type())
     {
-        addr.sin_addr.s_addr = htonl(m_ep.ipAddr.u.ipv4Addr.addr);
-        addr.sin_family      = AF_INET;
-        addr.sin_port        = htons(m_ep.port);
-        MEMSET(addr.sin_zero, '\0', sizeof(addr.sin_zero));
+        pSqe->opcode    = IORING_OP_RECVMSG;
+        pSqe->addr      = (U64)(unsigned long)&s_uringRecvHdr;
+        pSqe->len       = 1;
+        pSqe->ioprio    = IORING_RECV_MULTISHOT;
+        pSqe->flags     = IOSQE_BUFFER_SELECT;
+        pSqe->buf_group = GSIM_URING_BUF_GROUP;
+        pSqe->user_data = GSIM_URING_UDATA(GSIM_URING_OP_RECV,
+            pSock->connId());
     }
     else
     {
-        MEMCPY(addr6.sin6_addr.s6_addr, m_ep.ipAddr.u.ipv6Addr.addr,
-            m_ep.ipAddr.u.ipv6Addr.len);
-        addr6.sin6_family = AF_INET6;
-        addr6.sin6_port   = htons(m_ep.port);
+        pSqe->opcode        = IORING_OP_POLL_ADD;
+        pSqe->len           = IORING_POLL_ADD_MULTI;
+        pSqe->poll32_events = POLLIN;
+        pSqe->user_data     = GSIM_URING_UDATA(GSIM_URING_OP_POLL,
+            pSock->connId());
     }
 
-    if (IP_ADDR_TYPE_V4 == m_ep.ipAddr.ipAddrType)
+    s_uringArmed[pSock->connId()] = TRUE;
+}
+
+/**
+ * @brief
+ *    Processes a multishot receive completion. The buffer holds the
+ *    recvmsg header, the peer address and the message, it is handed back
+ *    to the kernel once the message is processed
+ *
+ * @param indx
+ *    socket index
+ * @param res
+ * @param flags
+ */
+PRIVATE VOID uringRecvDone(U32 indx, S32 res, U32 flags)
+{
+    GSimSocket *pSock = g_gsimSockArr[indx];
+
+    if (GSIM_CHK_MASK(flags, IORING_CQE_F_BUFFER))
     {
-        ret = bind(m_fd, (struct sockaddr *)&addr, sizeof(addr));
+        U16 bid  = flags >> IORING_CQE_BUFFER_SHIFT;
+        U8 *pBuf = s_pUring->getBuf(bid);
+
+        struct io_uring_recvmsg_out *pOut =
+            (struct io_uring_recvmsg_out *)pBuf;
+        if (res <= 0 || NULL == pSock)
+        {
+            /* nothing to process */
+        }
+        else if (GSIM_CHK_MASK(pOut->flags, MSG_TRUNC))
+        {
+            LOG_ERROR("Truncated GTP-C message dropped");
+        }
+        else
+        {
+            IPEndPoint peerEp;
+            U8 *pName = pBuf + sizeof(struct io_uring_recvmsg_out);
+            U8 *pCtrl = pName + s_uringRecvHdr.msg_namelen;
+            sockAddrToEp((struct sockaddr_storage *)pName, &peerEp);
+
+            struct msghdr ctrlHdr;
+            MEMSET(&ctrlHdr, 0, sizeof(ctrlHdr));
+            ctrlHdr.msg_control    = pCtrl;
+            ctrlHdr.msg_controllen = pOut->controllen;
+
+            procGtpcBuf(pSock, &peerEp, pCtrl + s_uringRecvHdr.msg_controllen,
+                pOut->payloadlen, getRxTstamp(&ctrlHdr));
+        }
+
+        s_pUring->recycleBuf(bid);
     }
-    else
+
+    if (-EINVAL == res)
     {
-        ret = bind(m_fd, (struct sockaddr *)&addr6, sizeof(addr6));
+        /* multishot recvmsg is supported since kernel 6.0 */
+        LOG_ERROR("io_uring multishot receive not supported, using poll "
+            "transport");
+        s_transportType = TRANSPORT_TYPE_POLL;
+        return;
     }
-
-    if (ret < 0)
+    else if (res < 0 && -ENOBUFS != res)
     {
-        LOG_FATAL("Socket Binding Failed, [%s]", strerror(errno));
-        return ERR_SYS_SOCKET_BIND;
+        LOG_ERROR("io_uring receive failed, [%s]", strerror(-res));
     }
 
-    return ROK;
+    /* receive stopped, e.g. on running out of buffers, is restarted by
+     * the next uringPoll()
+     */
+    if (!GSIM_CHK_MASK(flags, IORING_CQE_F_MORE))
+    {
+        s_uringArmed[indx] = FALSE;
+    }
 }
 
 /**
  * @brief
- *    Creates the socket for listening on Keyboard events from the user
+ *    Processes a multishot poll completion, the socket is read by its
+ *    handler as with poll transport
+ *
+ * @param indx
+ *    socket index
+ * @param res
+ *    poll events
+ * @param flags
+ * @param udata
  */
-PUBLIC RETVAL setupStdinSock()
+PRIVATE VOID uringPollDone(U32 indx, S32 res, U32 flags, U64 udata)
 {
-    LOG_ENTERFN();
+    GSimSocket *pSock = g_gsimSockArr[indx];
 
-    S16 ret = ROK;
+    if (NULL == pSock)
+    {
+        /* socket deleted, e.g. stdin closed */
+        if (GSIM_CHK_MASK(flags, IORING_CQE_F_MORE))
+        {
+            struct io_uring_sqe *pSqe = s_pUring->getSqe();
+            if (NULL != pSqe)
+            {
+                pSqe->opcode = IORING_OP_POLL_REMOVE;
+                pSqe->addr   = udata;
+            }
+        }
 
-    try
+        s_uringArmed[indx] = FALSE;
+        return;
+    }
+
+    if (res > 0 && GSIM_CHK_MASK(res, POLLIN))
     {
-        GSimSocket *pKbSock = new GSimSocket(SOCK_TYPE_STDIN);
-        (VOID) pKbSock;
+        handleSockEvent(pSock);
     }
-    catch (ErrCodeEn &e)
+    else if (res > 0 && GSIM_CHK_MASK(res, POLLERR))
     {
-        ret = ERR_SOCK_ALLOC;
+        LOG_FATAL("Socket Error, FD [%d]", pSock->fd());
+        delete pSock;
+    }
+    else if (res < 0)
+    {
+        LOG_ERROR("io_uring poll failed, [%s]", strerror(-res));
     }
 
-    LOG_EXITFN(ret);
+    if (!GSIM_CHK_MASK(flags, IORING_CQE_F_MORE))
+    {
+        s_uringArmed[indx] = FALSE;
+    }
 }
 
-PUBLIC RETVAL sendMsg(TransConnId connId, IPEndPoint *pDst, Buffer *data)
+PRIVATE VOID uringSendDone(U32 indx, S32 res)
 {
-    LOG_ENTERFN();
-
-    RETVAL ret = ROK;
+    SendSlot_t *pSlot = &s_pSendSlots[indx];
 
-    GSimSocket *pSock = g_gsimSockArr[connId];
-    if (NULL != pSock)
+    if (-EAGAIN == res)
     {
-        if (pDst->ipAddr.ipAddrType == IP_ADDR_TYPE_V4)
-        {
-            ret = sendMsgV4(pSock, pDst, data);
-        }
-        else
+        Buffer *pData = pSlot->pData;
+        if (NULL == pData)
         {
-            ret = sendMsgV6(pSock, pDst, data);
+            pData = new Buffer;
+            BUFFER_CPY(pData, pSlot->buf, pSlot->iov.iov_len);
         }
+
+        pSlot->pData = NULL;
+        pSlot->pSock->parkMsg(&pSlot->dst, pData);
+    }
+    else if (res < 0)
+    {
+        LOG_FATAL("Socket sendmsg() failed, [%s]", strerror(-res));
     }
 
-    LOG_EXITFN(ret);
+    delete pSlot->pData;
+    pSlot->pData = NULL;
+    s_uringFreeSlots.push_back(indx);
 }
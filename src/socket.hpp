@@ -23,11 +23,34 @@
 
 #define GSIM_UDP_READ_LEN        2048
 #define GTP_HDR_PEEK_LEN         4
-#define GSIM_MAX_SOCK_CNT        3
-#define GSIM_MAX_POLL_FDS        32
+#define GSIM_MAX_POLL_FDS        1024 /* local endpoints and the rest */
+#define GSIM_MAX_SOCK_CNT        GSIM_MAX_POLL_FDS
+#define GSIM_MAX_SEND_BATCH      64   /* messages per sendmmsg() */
 #define GSIM_MAX_RECV_LOOPS      1000
-#define GSIM_MAX_SOCKET_RECV_BUF (1 << 20)
-#define GSIM_MAX_SOCKET_SEND_BUF (1 << 20)
+#define GSIM_MAX_RECV_BATCH      64   /* messages per recvmmsg() */
+#define GSIM_GTPU_PEEK_LEN       128  /* G-PDU headers read by the sink */
+#define GSIM_GRO_RECV_BATCH      8    /* coalesced messages per recvmmsg() */
+#define GSIM_GRO_BUF_LEN         65536
+#define GSIM_GRO_MAX_SEGS        64
+
+/* UDP offload options, missing in older headers */
+#ifndef SOL_UDP
+#define SOL_UDP                  17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT              103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO                  104
+#endif
+#define GSIM_MAX_TX_QUEUE_LEN    8192 /* messages parked per socket */
+#define GSIM_TX_QUEUE_HIGH_WATER 4096 /* session creation paused above */
+#define GSIM_TX_QUEUE_LOW_WATER  1024 /* and resumed below */
+#define GSIM_SOCK_SAMPLE_MS      100  /* socket memory sampling period */
+#define GSIM_BUSY_POLL_USEC      50   /* SO_BUSY_POLL in busy-poll mode */
+/* control messages of a receive, UDP GRO and SO_TIMESTAMPING */
+#define GSIM_RECV_CTRL_LEN       (CMSG_SPACE(sizeof(S32)) + \
+                                  CMSG_SPACE(3 * sizeof(struct timespec)))
 
 typedef enum
 {
@@ -36,29 +59,82 @@ typedef enum
    SOCK_TYPE_GTPC,
    SOCK_TYPE_GTPU,
    SOCK_TYPE_GTPU_CTRL,
+   SOCK_TYPE_GTPU_RING,
    SOCK_TYPE_MAX
 } SockType_t;
 
 typedef struct pollfd   GSimPollFd;
 
+class GSimSocket;
+
+/* message parked on a full socket until the socket is writable */
+typedef struct
+{
+   Buffer                  *pData;
+   IPEndPoint              dst;
+} TxMsg_t;
+
+typedef std::deque<TxMsg_t> TxQueue;
+
+/* Message waiting in the send batch of mmsg and uring transports. The
+ * buffer is owned by the slot if pData is set, otherwise the message is
+ * copied into buf
+ */
+typedef struct
+{
+   GSimSocket              *pSock;
+   IPEndPoint              dst;
+   struct sockaddr_storage addr;
+   struct msghdr           msg;
+   struct iovec            iov;
+   Buffer                  *pData;
+   U8                      buf[GSIM_UDP_READ_LEN];
+} SendSlot_t;
+
 class GSimSocket
 {
    public:
       GSimSocket(SockType_t);
       GSimSocket(SockType_t, IPEndPoint);
+      GSimSocket(SockType_t, S32 fd);
       ~GSimSocket();
 
       S32               fd();
       SockType_t        type();
+      TransConnId       connId();
       IpAddrTypeEn      ipAddrType();
       RETVAL            bindSocket();
       RETVAL            recvMsg(UdpData_t **msg);
+      RETVAL            recvMsg(U8 **ppBuf, U32 *pLen, IPEndPoint *pPeerEp);
+      U32               recvMsgBatch(RecvVec_t *pMsgs, U32 cnt,\
+                              IPEndPoint *pPeerEps = NULL);
+      RETVAL            recvMsg(U8 **ppBuf, U32 *pLen, IPEndPoint *pPeerEp,\
+                              Time_t *pTstamp);
+      RETVAL            parkMsg(IPEndPoint *pDst, Buffer *data);
+      VOID              drainTxQueue();
+      U32               txQueueLen() { return m_txQueue.size(); }
+      const IPEndPoint  *localEp() { return &m_ep; }
+      VOID              countTx() { m_txMsgs++; }
+      VOID              countRx() { m_rxMsgs++; }
+      Counter           txMsgs() { return m_txMsgs; }
+      Counter           rxMsgs() { return m_rxMsgs; }
+      RETVAL            sampleMemInfo(U32 *pRxFill, U32 *pTxFill,\
+                              Counter *pRxDrops);
 
    private:
       S32               m_fd;
       U32               m_pollFdIndex;
       SockType_t        m_type;
       IPEndPoint        m_ep;
+      TxQueue           m_txQueue;
+      Time_t            m_stallStart;   /* milli seconds, first message
+                                         * parked in the queue
+                                         */
+      Counter           m_rxDrops;      /* kernel drops at last sample */
+      Counter           m_txMsgs;       /* GTP-C messages sent */
+      Counter           m_rxMsgs;       /* GTP-C messages received */
+      VOID              setBufSize(S32 opt, S32 forceOpt, U32 size);
+      VOID              enableTimestamps();
       RETVAL            recvMsgV6(UdpData_t **msg);
       RETVAL            recvMsgV4(UdpData_t **msg);
 };
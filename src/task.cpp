@@ -99,6 +99,11 @@ TaskList* TaskMgr::getAllTasks()
    return &g_allTasks;
 }
 
+VOID TaskMgr::init()
+{
+   g_pausedTasks.init();
+}
+
 VOID TaskMgr::resumePausedTasks()
 {
    g_pausedTasks.resumePausedTasks();
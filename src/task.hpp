@@ -36,6 +36,7 @@ class TaskMgr
    public:
       static TaskList* getRunningTasks();
       static TaskList* getAllTasks();
+      static VOID init();
       static VOID resumePausedTasks();
       static VOID deleteAllTasks();
 };
@@ -60,6 +61,8 @@ class Task
 
       /* Wake this up a paused Task */
       VOID resumeTask();
+
+      inline TaskState_t state() { return m_taskState; }
    protected:
       TaskId_t        m_id;
 
@@ -0,0 +1,143 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <new>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_types.hpp"
+#include "teid_alloc.hpp"
+
+TeidAllocator::TeidAllocator(const S8 *name)
+{
+   m_name       = name;
+   m_pUser      = NULL;
+   m_shardBase  = 0;
+   m_indxMask   = 0xFFFFFFFF;
+   m_nextIndx   = 1;
+   m_freeHead   = 0;
+   m_freeTail   = 0;
+   m_quarantine = 0;
+   m_inUse      = 0;
+}
+
+/**
+ * @brief
+ *    Sets the TEID range of the allocator, the shard id is kept in the
+ *    least number of top bits that hold shardCnt shards. Index 0 is not
+ *    used, so TEID 0 is never allocated
+ *
+ * @param shard
+ * @param shardCnt
+ * @param quarantine
+ *    seconds a freed TEID is not reused
+ */
+VOID TeidAllocator::init(U32 shard, U32 shardCnt, U32 quarantine)
+{
+   U32 shardBits = 0;
+   while (((U64)1 << shardBits) < shardCnt)
+   {
+      shardBits++;
+   }
+
+   U32 indxBits = 32 - shardBits;
+   m_indxMask   = (U32)(((U64)1 << indxBits) - 1);
+   m_shardBase  = (GtpTeid_t)((U64)shard << indxBits);
+   m_quarantine = quarantine;
+
+   LOG_INFO("%s TEIDs [0x%08x - 0x%08x], quarantine [%u] seconds", m_name,
+         firstTeid(), lastTeid(), m_quarantine);
+}
+
+GtpTeid_t TeidAllocator::alloc(VOID *pObj, Time_t now)
+{
+   U32 indx = 0;
+
+   if (0 != m_freeHead &&
+       (U64)slot(m_freeHead)->freedAt + m_quarantine <= now / 1000)
+   {
+      indx = m_freeHead;
+      m_freeHead = slot(indx)->nextFree;
+      if (0 == m_freeHead)
+      {
+         m_freeTail = 0;
+      }
+   }
+   else if (m_nextIndx < m_indxMask)
+   {
+      indx = m_nextIndx;
+      if ((indx >> GSIM_TEID_CHUNK_BITS) >= m_chunks.size())
+      {
+         if (NULL == m_pUser)
+         {
+            m_pUser = memRegister(m_name);
+         }
+
+         VOID *pChunk = memAlloc(m_pUser,
+               (U64)sizeof(TeidSlot) * GSIM_TEID_CHUNK_SIZE);
+         if (NULL == pChunk)
+         {
+            LOG_ERROR("%s TEID table allocation failed", m_name);
+            return GSIM_INV_TEID;
+         }
+         m_chunks.push_back((TeidSlot *)pChunk);
+      }
+
+      m_nextIndx++;
+   }
+   else
+   {
+      LOG_ERROR("%s TEIDs exhausted, [%u] in use", m_name, m_inUse);
+      return GSIM_INV_TEID;
+   }
+
+   slot(indx)->pObj = pObj;
+   m_inUse++;
+
+   return m_shardBase | indx;
+}
+
+VOID TeidAllocator::free(GtpTeid_t teid, Time_t now)
+{
+   U32 indx = teid & m_indxMask;
+   if ((teid & ~m_indxMask) != m_shardBase || 0 == indx ||
+       indx >= m_nextIndx || NULL == slot(indx)->pObj)
+   {
+      LOG_ERROR("%s TEID [0x%08x] is not in use", m_name, teid);
+      return;
+   }
+
+   TeidSlot *pSlot = slot(indx);
+   pSlot->pObj     = NULL;
+   pSlot->nextFree = 0;
+   pSlot->freedAt  = (U32)(now / 1000);
+
+   if (0 == m_freeTail)
+   {
+      m_freeHead = indx;
+   }
+   else
+   {
+      slot(m_freeTail)->nextFree = indx;
+   }
+
+   m_freeTail = indx;
+   m_inUse--;
+}
@@ -0,0 +1,97 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TEID_ALLOC_HPP__
+#define __TEID_ALLOC_HPP__
+
+#define GSIM_INV_TEID               0
+#define GSIM_TEID_CHUNK_BITS        14  /* TEID slots of a chunk */
+#define GSIM_TEID_CHUNK_SIZE        (1U << GSIM_TEID_CHUNK_BITS)
+
+/* Allocates the TEIDs of one shard. A TEID is the shard id in the top bits
+ * and an index in the remaining bits, so simulator instances of distinct
+ * shards never use the same TEID, and the index of a TEID is a direct
+ * index into the slot table of the shard.
+ *
+ * Freed TEIDs are reused in the order they were freed, but only after the
+ * quarantine, so that the late messages of a deleted tunnel are not taken
+ * for the messages of a new tunnel. New indices are taken while the
+ * oldest freed TEID is in quarantine
+ */
+class TeidAllocator
+{
+   public:
+      TeidAllocator(const S8 *name);
+
+      /* shard of shardCnt shards, quarantine in seconds */
+      VOID        init(U32 shard, U32 shardCnt, U32 quarantine);
+
+      /* returns GSIM_INV_TEID if all the TEIDs of the shard are in use or
+       * in quarantine, now in milli seconds
+       */
+      GtpTeid_t   alloc(VOID *pObj, Time_t now);
+      VOID        free(GtpTeid_t teid, Time_t now);
+
+      /* object of a TEID of the shard, NULL for the TEIDs of other shards
+       * and for the TEIDs not in use
+       */
+      inline VOID *find(GtpTeid_t teid)
+      {
+         if ((teid & ~m_indxMask) != m_shardBase)
+         {
+            return NULL;
+         }
+
+         U32 indx = teid & m_indxMask;
+         if (0 == indx || indx >= m_nextIndx)
+         {
+            return NULL;
+         }
+
+         return slot(indx)->pObj;
+      }
+
+      U32         inUse() { return m_inUse; }
+      GtpTeid_t   firstTeid() { return m_shardBase | 1; }
+      GtpTeid_t   lastTeid() { return m_shardBase | (m_indxMask - 1); }
+
+   private:
+      typedef struct
+      {
+         VOID     *pObj;
+         U32      nextFree;   /* index of the next freed TEID */
+         U32      freedAt;    /* seconds */
+      } TeidSlot;
+
+      inline TeidSlot *slot(U32 indx)
+      {
+         return &m_chunks[indx >> GSIM_TEID_CHUNK_BITS]
+            [indx & (GSIM_TEID_CHUNK_SIZE - 1)];
+      }
+
+      const S8                *m_name;
+      MemUser_t               *m_pUser;
+      std::vector<TeidSlot *> m_chunks;
+      GtpTeid_t               m_shardBase;
+      U32                     m_indxMask;
+      U32                     m_nextIndx;   /* indices below are taken */
+      U32                     m_freeHead;   /* oldest freed, 0 if none */
+      U32                     m_freeTail;
+      U32                     m_quarantine;
+      U32                     m_inUse;
+};
+
+#endif
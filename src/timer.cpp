@@ -18,36 +18,176 @@
 #include <time.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <new>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
 
 #include "types.hpp"
 #include "logger.hpp"
+#include "macros.hpp"
+#include "error.hpp"
+#include "mem.hpp"
 #include "timer.hpp"
 
 static Time_t s_clockTick = 0;
+static Time_t s_startTime = 0;   /* micro-seconds */
+static U64    s_tscMult   = 0;   /* micro-seconds per tick << 32, 0 if
+                                  * the TSC clock is not used
+                                  */
+static U64    s_tscBase   = 0;
+static Time_t s_tscBaseUs = 0;   /* CLOCK_MONOTONIC at s_tscBase */
 
 /**
  * @brief
- *    returns time in milliseconds since epoch time
+ *    Calibrates the TSC against CLOCK_MONOTONIC. Once calibrated the
+ *    time is read from the TSC, in the same time base as the monotonic
+ *    clock, so the time taken before and after stays comparable. Only
+ *    an invariant TSC, which ticks at a constant rate in all the power
+ *    states, is used
+ *
+ * @return
+ *    RFAILED if the CPU does not have an invariant TSC
  */
-Time_t getMilliSeconds()
+RETVAL initTscClock()
 {
+#if defined(__x86_64__)
+    U32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) ||
+        !GSIM_CHK_MASK(edx, 1 << 8))
+    {
+        return RFAILED;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    Time_t startUs  = (Time_t)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000LL;
+    U64    startTsc = __rdtsc();
+
+    usleep(GSIM_TSC_CALIB_MS * 1000);
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    Time_t endUs  = (Time_t)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000LL;
+    U64    endTsc = __rdtsc();
+
+    if (endTsc <= startTsc || endUs <= startUs)
+    {
+        return RFAILED;
+    }
+
+    s_tscMult   = (U64)(((unsigned __int128)(endUs - startUs) << 32) /
+        (endTsc - startTsc));
+    s_tscBase   = endTsc;
+    s_tscBaseUs = endUs;
+
+    LOG_INFO("TSC clock, %llu MHz", (unsigned long long)
+        ((endTsc - startTsc) / (endUs - startUs)));
+    return ROK;
+#else
+    return RFAILED;
+#endif
+}
+
+BOOL isTscClock()
+{
+    return (0 != s_tscMult);
+}
+
+/**
+ * @brief
+ *    reads the monotonic clock in micro-seconds, from the TSC if it is
+ *    calibrated
+ *
+ * @param clockId
+ *    clock to be read otherwise
+ */
+static inline Time_t readClock(clockid_t clockId)
+{
+#if defined(__x86_64__)
+    if (0 != s_tscMult)
+    {
+        return s_tscBaseUs + (Time_t)(((unsigned __int128)
+            (__rdtsc() - s_tscBase) * s_tscMult) >> 32);
+    }
+#endif
+
     struct timespec sysTime;
-    static Time_t   startTime = 0;
+    clock_gettime(clockId, &sysTime);
+    return (Time_t)sysTime.tv_sec * 1000000LL + sysTime.tv_nsec / 1000LL;
+}
 
-    clock_gettime(CLOCK_MONOTONIC_COARSE, &sysTime);
-    Time_t usec = (Time_t)sysTime.tv_sec * 1000000LL + sysTime.tv_nsec / 1000LL;
-    Time_t msec = usec / 1000;
+/**
+ * @brief
+ *    returns time in milliseconds since epoch time
+ */
+Time_t getMilliSeconds()
+{
+    Time_t usec = readClock(CLOCK_MONOTONIC_COARSE);
 
-    if (startTime == 0)
+    if (s_startTime == 0)
     {
-        startTime = msec - 1;
+        s_startTime = usec - 1000;
     }
 
-    msec        = msec - startTime;
+    Time_t msec = (usec - s_startTime) / 1000;
     s_clockTick = msec;
     return msec;
 }
 
+/**
+ * @brief
+ *    returns time in micro-seconds, from the same start time as
+ *    getMilliSeconds(). Used for latency measurement, the coarse clock
+ *    used by the scheduler is not precise enough for it
+ */
+Time_t getMicroSeconds()
+{
+    Time_t usec = readClock(CLOCK_MONOTONIC);
+
+    if (s_startTime == 0)
+    {
+        s_startTime = usec - 1000;
+    }
+
+    return usec - s_startTime;
+}
+
+/**
+ * @brief
+ *    returns real time in micro-seconds since epoch time. Used for one-way
+ *    latency of G-PDUs, the sender and receiver clocks must be synchronised
+ */
+Time_t getWallMicroSeconds()
+{
+    struct timespec sysTime;
+
+    clock_gettime(CLOCK_REALTIME, &sysTime);
+    return (Time_t)sysTime.tv_sec * 1000000LL + sysTime.tv_nsec / 1000LL;
+}
+
+/**
+ * @brief
+ *    converts a real time, e.g. a kernel socket timestamp, into the time
+ *    base of getMicroSeconds(). The offset between the clocks is taken at
+ *    every call, so a step of the real time clock does not skew it
+ *
+ * @param wallUsec
+ *    micro-seconds since epoch time
+ */
+Time_t wallToMicroSeconds(Time_t wallUsec)
+{
+    Time_t now     = getMicroSeconds();
+    Time_t wallNow = getWallMicroSeconds();
+
+    if (wallUsec >= wallNow)
+    {
+        return now;
+    }
+
+    return (wallNow - wallUsec < now) ? now - (wallNow - wallUsec) : 0;
+}
+
 VOID getTimeStr(S8 *pStr)
 {
     LOG_ENTERFN();
@@ -208,8 +348,35 @@ VOID TimeWheel::removeTask(Task *task)
 
 TimeWheel::TimeWheel()
 {
-    count     = 0;
-    wheelBase = s_clockTick;
+    count      = 0;
+    wheelBase  = s_clockTick;
+    wheelOne   = NULL;
+    wheelTwo   = NULL;
+    wheelThree = NULL;
+}
+
+/**
+ * @brief Allocates the slots of the wheels from the memory arena, must be
+ *        called before any task is paused
+ */
+VOID TimeWheel::init()
+{
+    U32      numSlots = TW_ONE_SLOTS + TW_TWO_SLOTS + TW_THREE_SLOTS;
+    TaskList *pSlots  = (TaskList *)memAlloc(memRegister("time-wheel"),
+        numSlots * sizeof(TaskList));
+    if (NULL == pSlots)
+    {
+        throw ERR_MEMORY_ALLOC;
+    }
+
+    for (U32 i = 0; i < numSlots; i++)
+    {
+        new (&pSlots[i]) TaskList;
+    }
+
+    wheelOne   = pSlots;
+    wheelTwo   = wheelOne + TW_ONE_SLOTS;
+    wheelThree = wheelTwo + TW_TWO_SLOTS;
 }
 
 Counter TimeWheel::size()
@@ -45,6 +45,7 @@ class TimeWheel
    public:
       TimeWheel();
 
+      void init();
       void addTask(Task* t);
       void removeTask(Task* t);
       void wakeupTask();
@@ -56,17 +57,24 @@ class TimeWheel
       Counter  count;
 
       /* wheel one has 1 ^ 12 millisecond slots */
-      TaskList wheelOne[TW_ONE_SLOTS];
+      TaskList *wheelOne;
 
       /* wheel two has 1 ^ 12 to 1 ^ 22 milli-second slots */
-      TaskList wheelTwo[TW_TWO_SLOTS];
+      TaskList *wheelTwo;
 
       /* wheel two has 1 ^ 22 to 1 ^ 32 milli-second slots */
-      TaskList wheelThree[TW_THREE_SLOTS];
+      TaskList *wheelThree;
 
       TaskList *getPausedTaskList(Time_t time);
 };
 
+#define GSIM_TSC_CALIB_MS        50
+
+RETVAL initTscClock();
+BOOL   isTscClock();
 Time_t getMilliSeconds();
+Time_t getMicroSeconds();
+Time_t getWallMicroSeconds();
+Time_t wallToMicroSeconds(Time_t wallUsec);
 VOID getTimeStr(S8 *pStr);
 #endif
@@ -17,14 +17,21 @@
 #include <list>
 #include <map>
 #include <vector>
+#include <unordered_map>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 #include "types.hpp"
 #include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "timer.hpp"
 #include "task.hpp"
 #include "gtp_types.hpp"
+#include "transport.hpp"
 #include "sim_cfg.hpp"
 #include "gtp_macro.hpp"
 #include "gtp_if.hpp"
@@ -34,20 +41,43 @@
 #include "procedure.hpp"
 #include "gtp_stats.hpp"
 #include "tunnel.hpp"
-#include "session.hpp"
 #include "gtp_peer.hpp"
+#include "session.hpp"
 #include "display.hpp"
+#include "dead_call.hpp"
 #include "traffic.hpp"
 
+#define GSIM_IMSI_ROW_LEN          16  /* digits of an IMSI row, TBCD */
+
 EXTERN BOOL g_serverMode;
 
+TrafficTask *TrafficTask::m_pTrafficTask = NULL;
+
 TrafficTask::TrafficTask()
 {
    m_ratePeriod = Config::getInstance()->getSessionRatePeriod();
    m_rate = Config::getInstance()->getCallRate();
    m_maxSessions = Config::getInstance()->getNumSessions();
-   string imsi = Config::getInstance()->getImsi();
-   m_imsiGen.init(imsi);
+   m_concurrency = Config::getInstance()->getConcurrency();
+   m_numStarted = 0;
+   m_wakeTime = 0;
+   m_stallWake = 0;
+   Config *pCfg = Config::getInstance();
+   m_imsiGen.init(pCfg->getImsi(), m_maxSessions, pCfg->getImsiStride(),
+         pCfg->getImsiPartIndx(), pCfg->getImsiPartCnt(),
+         pCfg->getImsiRandomOrder());
+
+   /* all the slots are free at start, 0 intended start time means the
+    * session is intended to start right now
+    */
+   m_freeSlots.reserve(m_concurrency);
+   m_freeSlots.assign(m_concurrency, 0);
+   m_pTrafficTask = this;
+}
+
+TrafficTask::~TrafficTask()
+{
+   m_pTrafficTask = NULL;
 }
 
 RETVAL TrafficTask::run(VOID *arg)
@@ -57,26 +87,32 @@ RETVAL TrafficTask::run(VOID *arg)
    BOOL     abortTraffiTask = FALSE;
    LOG_DEBUG("Running TrafficTask, Session Rate [%d]", m_rate);
 
+   /* rate may be changed from keyboard or by the rate search */
+   m_rate = Config::getInstance()->getCallRate();
+
    Time_t currTime = getMilliSeconds();
-   m_lastRunTime = currTime;
-   Counter numSession = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED);
-   for (U32 i = 0; i < m_rate; i++)
+   if (isTxCongested())
    {
-      GtpImsiKey imsiKey;
-      MEMSET(&imsiKey, 0, sizeof(GtpImsiKey));
-      m_imsiGen.allocNew(&imsiKey);
+      /* no new session until the parked messages drain, m_wakeTime is
+       * kept so the stall is accounted in the corrected latency
+       */
+      m_stallWake = currTime + GSIM_TX_STALL_POLL_MS;
+      Display::displayStats();
+      pause();
+      LOG_EXITFN(ROK);
+   }
 
-      UeSession::createUeSession(imsiKey);
-      numSession++;
-      if ((0 != m_maxSessions) && (numSession >= m_maxSessions))
-      {
-         LOG_DEBUG("Max Sessions = [%d] Created, Stopping Traffic",\
-               m_maxSessions);
-         abortTraffiTask = TRUE;
-         break;
-      }
+   m_stallWake = 0;
+   if (0 != m_concurrency)
+   {
+      abortTraffiTask = runClosedLoop();
+   }
+   else
+   {
+      abortTraffiTask = runOpenLoop(currTime);
    }
 
+   m_lastRunTime = currTime;
    Display::displayStats();
 
    if (abortTraffiTask)
@@ -92,6 +128,120 @@ RETVAL TrafficTask::run(VOID *arg)
    LOG_EXITFN(ROK);
 }
 
+/**
+ * @brief
+ *    starts m_rate sessions. All the sessions of a rate period are
+ *    intended to start at the scheduled run time of the task, so any delay
+ *    in running the task is accounted in the corrected latency
+ *
+ * @return
+ *    TRUE if maximum sessions are started
+ */
+BOOL TrafficTask::runOpenLoop(Time_t currTime)
+{
+   LOG_ENTERFN();
+
+   Time_t intendedStart = getMicroSeconds();
+   if (0 != m_wakeTime && m_wakeTime < currTime)
+   {
+      intendedStart -= (currTime - m_wakeTime) * 1000;
+   }
+
+   for (U32 i = 0; i < m_rate; i++)
+   {
+      if (startSession(intendedStart))
+      {
+         LOG_EXITFN(TRUE);
+      }
+   }
+
+   LOG_EXITFN(FALSE);
+}
+
+/**
+ * @brief
+ *    starts a session for every free slot, the session is intended to
+ *    start when the previous session in the slot ended
+ *
+ * @return
+ *    TRUE if maximum sessions are started
+ */
+BOOL TrafficTask::runClosedLoop()
+{
+   LOG_ENTERFN();
+
+   Time_t currTime = getMicroSeconds();
+
+   while (!m_freeSlots.empty())
+   {
+      Time_t intendedStart = m_freeSlots.back();
+      m_freeSlots.pop_back();
+
+      if (startSession(0 == intendedStart ? currTime : intendedStart))
+      {
+         LOG_EXITFN(TRUE);
+      }
+   }
+
+   LOG_EXITFN(FALSE);
+}
+
+/**
+ * @brief
+ *    creates a new UE session
+ *
+ * @param intendedStart
+ *    time in micro-seconds the session was intended to start
+ *
+ * @return
+ *    TRUE if maximum sessions are started
+ */
+BOOL TrafficTask::startSession(Time_t intendedStart)
+{
+   GtpImsiKey imsiKey;
+   m_imsiGen.allocNew(&imsiKey);
+
+   UeSession *pUeSsn = UeSession::createUeSession(imsiKey);
+   pUeSsn->setIntendedStart(intendedStart);
+   pUeSsn->setPeer(selectRemotePeer(imsiKey.val, imsiKey.len));
+   pUeSsn->setSender(getSenderConnId(m_numStarted % numSenders()));
+
+   m_numStarted++;
+   if ((0 != m_maxSessions) && (m_numStarted >= m_maxSessions))
+   {
+      LOG_DEBUG("Max Sessions = [%d] Created, Stopping Traffic",\
+            m_maxSessions);
+      return TRUE;
+   }
+
+   return FALSE;
+}
+
+/**
+ * @brief
+ *    called when a session started by the traffic task is over, either
+ *    completed or failed. In closed-loop mode the slot is freed and the
+ *    traffic task is woken up to start the next session
+ *
+ * @param endTime
+ *    time in micro-seconds
+ */
+VOID TrafficTask::sessionEnded(Time_t endTime)
+{
+   TrafficTask *pTask = m_pTrafficTask;
+
+   if (NULL == pTask || 0 == pTask->m_concurrency)
+   {
+      return;
+   }
+
+   pTask->m_freeSlots.push_back(endTime);
+   if (TASK_STATE_PAUSED == pTask->state())
+   {
+      pTask->resumeTask();
+   }
+}
+
 PUBLIC VOID procGtpcMsg(UdpData_t *data)
 {
    LOG_ENTERFN();
@@ -114,20 +264,45 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
       ueSsn = UeSession::getUeSession(imsiKey);
       if (NULL == ueSsn)
       {
+         /* retransmission of the last request of a completed session */
+         if (DeadCallTable::getInstance()->procRetransMsg(data, 0))
+         {
+            delete data;
+            LOG_EXITVOID();
+         }
+
          addPeerData(data->peerEp); 
          ueSsn = UeSession::createUeSession(imsiKey);
       }
    }
    else
    {
+      /* response to a request sent, matched by the sequence number as
+       * the TEID of a rejection may be 0
+       */
+      if (GTP_MSG_CAT_RSP == gtpGetMsgCategory(msgType))
+      {
+         GtpSeqNumber_t seqNumber = 0;
+         GTP_MSG_GET_SEQN(gtpMsgBuf, seqNumber);
+         ueSsn = findPeerTxn(&data->peerEp, seqNumber);
+      }
+
       GtpTeid_t teid = 0;
       GTP_MSG_DEC_TEID(gtpMsgBuf, teid);
-      if (0 != teid)
+      if (NULL != ueSsn)
+      {
+         ueSsn->resumeTask();
+      }
+      else if (0 != teid)
       {
          ueSsn = UeSession::getUeSession(teid);
          if (NULL == ueSsn)
          {
-            LOG_ERROR("GTPC Message received with unknown TEID [%d]", teid);
+            if (!DeadCallTable::getInstance()->procRetransMsg(data, teid))
+            {
+               LOG_ERROR("GTPC Message received with unknown TEID [%d]", teid);
+               Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+            }
             delete data;
          }
          else
@@ -137,7 +312,11 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
       }
       else
       {
-         LOG_ERROR("Unhandled Incoming GTP Message");
+         if (!DeadCallTable::getInstance()->procRetransMsg(data, 0))
+         {
+            LOG_ERROR("Unhandled Incoming GTP Message");
+            Stats::incStats(GSIM_STAT_UNEXCEPTED_MSG_RECD);
+         }
          delete data;
       }
    }
@@ -153,27 +332,235 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
    LOG_EXITVOID();
 }
 
+#if defined(__x86_64__)
+/**
+ * @brief
+ *    SSSE3 version of packTbcd(), a row of 16 digits is packed in one go,
+ *    multiplying the odd digits by 16 and adding the pairs of digits gives
+ *    the TBCD bytes in 16 bit lanes, which are then narrowed to bytes
+ */
+__attribute__((target("ssse3")))
+static VOID packTbcdSsse3(U8 (*pDigits)[GSIM_IMSI_ROW_LEN], U32 cnt,
+      GtpImsiKey *pKeys)
+{
+   const __m128i weights = _mm_set1_epi16(0x1001);
+   const __m128i zero    = _mm_setzero_si128();
+
+   for (U32 i = 0; i < cnt; i++)
+   {
+      __m128i row   = _mm_loadu_si128((const __m128i *)pDigits[i]);
+      __m128i pairs = _mm_maddubs_epi16(row, weights);
+      _mm_storel_epi64((__m128i *)pKeys[i].val,
+            _mm_packus_epi16(pairs, zero));
+   }
+}
+#endif
+
+/**
+ * @brief
+ *    packs rows of digits into TBCD, two digits per byte with the first
+ *    digit in the low nibble
+ */
+static VOID packTbcd(U8 (*pDigits)[GSIM_IMSI_ROW_LEN], U32 cnt,
+      GtpImsiKey *pKeys)
+{
+#if defined(__x86_64__)
+   static const BOOL ssse3 = __builtin_cpu_supports("ssse3");
+   if (ssse3)
+   {
+      packTbcdSsse3(pDigits, cnt, pKeys);
+      return;
+   }
+#endif
+
+   for (U32 i = 0; i < cnt; i++)
+   {
+      for (U32 j = 0; j < GTP_IMSI_MAX_BUF_LEN; j++)
+      {
+         pKeys[i].val[j] = pDigits[i][2 * j] | (pDigits[i][2 * j + 1] << 4);
+      }
+   }
+}
+
 GtpImsiGenerator::GtpImsiGenerator()
 {
-   MEMSET((VOID *)m_imsiStr, 0, GTP_IMSI_MAX_DIGITS);
+   m_modulus   = 1;
+   m_first     = 0;
+   m_next      = 0;
+   m_stride    = 1;
+   m_rangeSize = 1;
+   m_rangeIndx = 0;
+   m_permMask  = 0;
+   m_permShift = 1;
+   m_random    = FALSE;
+   m_len       = 0;
+   m_batchIndx = GSIM_IMSI_BATCH;
+   MEMSET((VOID *)m_batch, 0, sizeof(m_batch));
 }
 
-VOID GtpImsiGenerator::init(string imsi)
+/**
+ * @brief
+ *    initializes the generator, the first IMSI is imsi for the range 0.
+ *    The IMSI space is split into partCnt ranges of rangeSize IMSIs,
+ *    rangeSize 0 splits the whole space
+ *
+ * @param imsi
+ *    IMSI digits
+ * @param rangeSize
+ *    number of IMSIs of a range, usually the number of sessions
+ * @param stride
+ *    difference of consecutive IMSIs
+ * @param partIndx
+ *    range used by this instance, from 0 to partCnt - 1
+ * @param partCnt
+ *    number of ranges
+ * @param random
+ *    TRUE to use the IMSIs of the range in a random order
+ */
+VOID GtpImsiGenerator::init(string imsi, Counter rangeSize, U32 stride,
+      U32 partIndx, U32 partCnt, BOOL random)
 {
+   U64 base = 0;
+
    m_len = imsi.size();
-   if (m_len <= GTP_IMSI_MAX_DIGITS)
+   if (0 == m_len || m_len > GTP_IMSI_MAX_DIGITS)
    {
-      MEMCPY(m_imsiStr, imsi.c_str(), m_len);
+      LOG_ERROR("Invalid IMSI string length [%d]", m_len);
+      throw ERR_INV_CMD_LINE_PARAM;
    }
-   else
+
+   m_modulus = 1;
+   for (U32 i = 0; i < m_len; i++)
    {
-      LOG_ERROR("Invalid IMSI string length [%d]", m_len);
+      m_modulus *= 10;
+      base = base * 10 + GSIM_CHAR_TO_DIGIT(imsi[i]);
+   }
+
+   m_stride = stride % m_modulus;
+   m_rangeSize = rangeSize;
+   if (0 == m_rangeSize)
+   {
+      m_rangeSize = m_modulus / ((U64)stride * partCnt);
+   }
+   if (0 == m_rangeSize)
+   {
+      m_rangeSize = 1;
+   }
+
+   if ((unsigned __int128)m_rangeSize * stride * partCnt > m_modulus)
+   {
+      LOG_ERROR("IMSI ranges of [%u] instances, [%llu] IMSIs with stride "
+            "[%u], exceed the [%u] digit IMSIs", partCnt,
+            (unsigned long long)m_rangeSize, stride, m_len);
+      throw ERR_INV_CMD_LINE_PARAM;
+   }
+
+   m_first = (U64)((base + (unsigned __int128)m_stride * partIndx *
+            m_rangeSize) % m_modulus);
+   m_next      = m_first;
+   m_rangeIndx = 0;
+   m_random    = random;
+
+   U32 bits = 0;
+   while (bits < 64 && (1ULL << bits) < m_rangeSize)
+   {
+      bits++;
    }
+   m_permMask  = (bits < 64) ? ((1ULL << bits) - 1) : ~0ULL;
+   m_permShift = bits / 2 + 1;
+
+   fill();
+}
+
+/**
+ * @brief
+ *    maps the position in the range to the IMSI index of the random
+ *    order. The index is mixed with invertible steps over the next power
+ *    of 2, repeating until the result falls in the range, which gives a
+ *    permutation of the range
+ */
+U64 GtpImsiGenerator::permute(U64 indx)
+{
+   do
+   {
+      indx = (indx * 0x9E3779B97F4A7C15ULL + 0x632BE59BD9B4E019ULL) &
+         m_permMask;
+      indx ^= indx >> m_permShift;
+      indx = (indx * 0xBF58476D1CE4E5B9ULL) & m_permMask;
+      indx ^= indx >> m_permShift;
+   } while (indx >= m_rangeSize);
+
+   return indx;
 }
 
 /**
  * @brief
- *    allocates a new imsi incremented by one
+ *    generates and encodes the next GSIM_IMSI_BATCH IMSIs. The digits of
+ *    an IMSI are laid out in a row in the IMSI order, followed by the
+ *    0xf filler for an odd number of digits, the rows are then packed
+ *    into TBCD together
+ */
+VOID GtpImsiGenerator::fill()
+{
+   LOG_ENTERFN();
+
+   U8 digits[GSIM_IMSI_BATCH][GSIM_IMSI_ROW_LEN];
+   MEMSET(digits, 0, sizeof(digits));
+
+   for (U32 i = 0; i < GSIM_IMSI_BATCH; i++)
+   {
+      U64 imsi = 0;
+      if (m_random)
+      {
+         imsi = (U64)((m_first + (unsigned __int128)m_stride *
+                  permute(m_rangeIndx)) % m_modulus);
+      }
+      else
+      {
+         imsi = m_next;
+         m_next += m_stride;
+         if (m_next >= m_modulus)
+         {
+            m_next -= m_modulus;
+         }
+      }
+
+      if (++m_rangeIndx == m_rangeSize)
+      {
+         m_rangeIndx = 0;
+         m_next      = m_first;
+      }
+
+      /* the low and high 8 digits are converted in 32 bits */
+      U32 part[2] = {(U32)(imsi % 100000000), (U32)(imsi / 100000000)};
+      S32 d       = m_len - 1;
+      for (U32 p = 0; p < 2 && d >= 0; p++)
+      {
+         for (U32 k = 0; k < 8 && d >= 0; k++, d--)
+         {
+            digits[i][d] = part[p] % 10;
+            part[p] /= 10;
+         }
+      }
+
+      if (GSIM_IS_ODD(m_len))
+      {
+         digits[i][m_len] = 0xf;
+      }
+
+      m_batch[i].len = GSIM_CEIL_DIVISION(m_len, 2);
+   }
+
+   packTbcd(digits, GSIM_IMSI_BATCH, m_batch);
+   m_batchIndx = 0;
+
+   LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    allocates the next imsi from the batch, encoding the next batch when
+ *    the batch is used up
  *
  * @return 
  *    imsi
@@ -182,8 +569,12 @@ VOID GtpImsiGenerator::allocNew(GtpImsiKey *pImsi)
 {
    LOG_ENTERFN();
 
-   numericStrIncriment(m_imsiStr, m_len); 
-   pImsi->len = encodeImsi(m_imsiStr, m_len, pImsi->val);
+   if (GSIM_IMSI_BATCH == m_batchIndx)
+   {
+      fill();
+   }
+
+   *pImsi = m_batch[m_batchIndx++];
    
    LOG_EXITVOID();
 }
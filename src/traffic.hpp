@@ -17,34 +17,79 @@
 #ifndef __TRAFFIC_TASK__
 #define __TRAFFIC_TASK__
 
+/* poll period of the traffic task while the transmit queues drain */
+#define GSIM_TX_STALL_POLL_MS       1
+
+#define GSIM_IMSI_BATCH             64  /* IMSIs encoded at a time */
+
+/* generates the IMSIs of the UE sessions. The IMSIs are kept as integers,
+ * stepping by a stride through the range of this simulator instance, in
+ * sequence or in a random order which visits each IMSI of the range once.
+ * They are encoded into TBCD a batch at a time, allocNew() takes the next
+ * IMSI of the batch
+ */
 class GtpImsiGenerator
 {
    public:
       GtpImsiGenerator();
       VOID allocNew(GtpImsiKey*);
-      VOID init(string imsi);
+      VOID init(string imsi, Counter rangeSize, U32 stride, U32 partIndx,
+                U32 partCnt, BOOL random);
 
    private:
-      S8    m_imsiStr[GTP_IMSI_MAX_DIGITS];
-      U32   m_len;
+      VOID        fill();
+      U64         permute(U64 indx);
+
+      U64         m_modulus;    /* 10^m_len, the IMSIs wrap around */
+      U64         m_first;      /* first IMSI of the range */
+      U64         m_next;       /* next IMSI, sequential order */
+      U64         m_stride;
+      U64         m_rangeSize;
+      U64         m_rangeIndx;  /* position in the range */
+      U64         m_permMask;   /* random order, 2^n - 1 >= m_rangeSize */
+      U32         m_permShift;
+      BOOL        m_random;
+      U32         m_len;
+      U32         m_batchIndx;
+      GtpImsiKey  m_batch[GSIM_IMSI_BATCH];
 };
 
-/* generates the traffic, if the scenario of Initiating type */
+/* generates the traffic, if the scenario of Initiating type. In open-loop
+ * mode m_rate sessions are started every rate period, in closed-loop mode
+ * (concurrency) a new session is started whenever a session ends, keeping
+ * a fixed number of sessions in flight
+ */
 class TrafficTask: public Task
 {
    public:
       TrafficTask();
-      ~TrafficTask() {}
+      ~TrafficTask();
       RETVAL run(VOID *arg = NULL);  
-      inline Time_t wake() {return m_wakeTime;}
+      inline Time_t wake() {return (0 != m_stallWake) ? m_stallWake :\
+                                                         m_wakeTime;}
+
+      static VOID       sessionEnded(Time_t endTime);
 
    private:
+      static TrafficTask *m_pTrafficTask;
+
+      BOOL              runOpenLoop(Time_t currTime);
+      BOOL              runClosedLoop();
+      BOOL              startSession(Time_t intendedStart);
+
       U32               m_rate;
       Time_t            m_ratePeriod;   
       Time_t            m_lastRunTime;
       Counter           m_maxSessions;
+      Counter           m_numStarted;
       GtpImsiGenerator  m_imsiGen;
       Time_t            m_wakeTime;
+      Time_t            m_stallWake;    /* 0 if not stalled on tx queue */
+      U32               m_concurrency;
+      std::vector<Time_t> m_freeSlots; /* end time of the sessions which
+                                        * freed a slot, it is the intended
+                                        * start time of the next session
+                                        */
 };
 
 /* task for sending periodic echo request messages to the peer */
@@ -17,6 +17,20 @@
 #ifndef _TRANSPORT_HPP_
 #define _TRANSPORT_HPP_
 
+/* offloads supported on the GTP-U socket */
+#define GSIM_GTPU_OFFLOAD_GSO    0x01
+#define GSIM_GTPU_OFFLOAD_GRO    0x02
+
+class PacketRing;
+
+/* GTP-C messages of a local endpoint the initiated sessions are sent from */
+typedef struct
+{
+   IPEndPoint           ep;
+   Counter              txMsgs;
+   Counter              rxMsgs;
+} LocalEpStats_t;
+
 EXTERN RETVAL initTransport();
 
 EXTERN RETVAL setupStdinSock();
@@ -28,6 +42,36 @@ IPEndPoint           *pDst,
 Buffer               *pBuf
 );
 
-EXTERN VOID socketPoll(S32 wait);
+EXTERN RETVAL sendMsg
+(
+TransConnId          connId,
+IPEndPoint           *pDst,
+const U8             *pBuf,
+U32                  len
+);
+
+EXTERN U32 sendMsgBatch
+(
+TransConnId          connId,
+IPEndPoint           *pDst,
+SendVec_t            *pMsgs,
+U32                  cnt
+);
+
+EXTERN U32 numSenders();
+
+EXTERN TransConnId getSenderConnId(U32 indx);
+
+EXTERN VOID getSenderStats(U32 indx, LocalEpStats_t *pStats);
+
+EXTERN TransConnId getGtpuConnId();
+
+EXTERN U32 getGtpuOffload();
+
+EXTERN PacketRing* getGtpuRing();
+
+EXTERN U32 socketPoll(S32 wait);
+
+EXTERN BOOL isTxCongested();
 
 #endif
@@ -15,31 +15,54 @@
  */
 
 #include <list>
-#include <map>
+#include <vector>
+#include <new>
 
 #include "types.hpp"
 #include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "mem.hpp"
 #include "gtp_types.hpp"
 #include "sim_cfg.hpp"
+#include "timer.hpp"
+#include "teid_alloc.hpp"
 #include "tunnel.hpp"
 
-static TunMap        s_gtpcTunMap;
-static U32           s_cTeid = 0;
-static U32           s_uTeid = 0;
+static TeidAllocator s_cTeids("gtpc-teid");
+static TeidAllocator s_uTeids("gtpu-teid");
+static BOOL          s_teidsInit = FALSE;
+static MemPool       s_cTunPool("gtpc-tun", sizeof(GtpcTun));
+static MemPool       s_uTunPool("gtpu-tun", sizeof(GtpuTun));
 
-PRIVATE U32          generateUTeid();
-PRIVATE U32          generateCTeid();
+PRIVATE VOID         initTeids();
+PRIVATE GtpTeid_t    allocTeid(TeidAllocator *pTeids, VOID *pTun);
 
-PRIVATE U32 generateCTeid()
+PRIVATE VOID initTeids()
 {
-   return ++s_cTeid;
+   Config *pCfg = Config::getInstance();
+
+   s_cTeids.init(pCfg->getTeidShard(), pCfg->getTeidShardCnt(),
+         pCfg->getTeidQuarantine());
+   s_uTeids.init(pCfg->getTeidShard(), pCfg->getTeidShardCnt(),
+         pCfg->getTeidQuarantine());
+   s_teidsInit = TRUE;
 }
 
-PRIVATE U32 generateUTeid()
+PRIVATE GtpTeid_t allocTeid(TeidAllocator *pTeids, VOID *pTun)
 {
-   return ++s_uTeid;
+   if (!s_teidsInit)
+   {
+      initTeids();
+   }
+
+   GtpTeid_t teid = pTeids->alloc(pTun, getMilliSeconds());
+   if (GSIM_INV_TEID == teid)
+   {
+      throw std::bad_alloc();
+   }
+
+   return teid;
 }
 
 PUBLIC VOID deleteCTun(GtpcTun *pTun)
@@ -50,33 +73,62 @@ PUBLIC VOID deleteCTun(GtpcTun *pTun)
    if (pTun->m_refCount == 0)
    {
       LOG_DEBUG("Deleting GTP-C Tunnel, TEID [%d]", pTun->m_locTeid);
-      s_gtpcTunMap.erase(pTun->m_locTeid);
+      s_cTeids.free(pTun->m_locTeid, getMilliSeconds());
       delete pTun;
    }
 
    LOG_EXITVOID();
 }
 
+VOID *GtpcTun::operator new(size_t len)
+{
+   VOID *p = s_cTunPool.alloc();
+   if (NULL == p)
+   {
+      throw std::bad_alloc();
+   }
+
+   return p;
+}
+
+VOID GtpcTun::operator delete(VOID *p)
+{
+   s_cTunPool.free(p);
+}
+
+VOID *GtpuTun::operator new(size_t len)
+{
+   VOID *p = s_uTunPool.alloc();
+   if (NULL == p)
+   {
+      throw std::bad_alloc();
+   }
+
+   return p;
+}
+
+VOID GtpuTun::operator delete(VOID *p)
+{
+   s_uTunPool.free(p);
+}
+
 GtpcTun::GtpcTun()
 {
-   m_locTeid = generateCTeid();
+   m_locTeid = allocTeid(&s_cTeids, this);
    m_remTeid = 0;
    m_refCount = 1;
    m_localEp.port = Config::getInstance()->getLocalGtpcPort();
    m_localEp.ipAddr = *(Config::getInstance()->getLocalIpAddr());
 
-   s_gtpcTunMap.insert(TunMapPair(m_locTeid, this));
    LOG_DEBUG("Creating GTP-C Tunnel, TEID [%d]", m_locTeid);
 }
 
 PUBLIC GtpcTun* findCTun(GtpTeid_t teid)
 {
-   GtpcTun     *pTun = NULL;
+   GtpcTun     *pTun = (GtpcTun *)s_cTeids.find(teid);
 
-   TunMapItr itr = s_gtpcTunMap.find(teid);
-   if (itr != s_gtpcTunMap.end())
+   if (NULL != pTun)
    {
-      pTun = itr->second;
       LOG_TRACE("Found GTP-C Tunnel, TEID [%d]", teid);
    }
   
@@ -85,9 +137,15 @@ PUBLIC GtpcTun* findCTun(GtpTeid_t teid)
 
 GtpuTun::GtpuTun()
 {
-   m_locTeid = generateUTeid();
+   m_locTeid = allocTeid(&s_uTeids, this);
    m_remTeid = 0;
+   m_genIndx = GSIM_GTPU_INV_INDX;
    LOG_TRACE("GTP-U Tunnel Constructor, TEID [%d]", m_locTeid);
 }
 
+GtpuTun::~GtpuTun()
+{
+   s_uTeids.free(m_locTeid, getMilliSeconds());
+}
+
 
@@ -25,6 +25,9 @@ class GtpcTun
    public:
       GtpcTun();
 
+      static VOID *operator new(size_t len);
+      static VOID operator delete(VOID *p);
+
       GtpTeid_t   m_locTeid;
       GtpTeid_t   m_remTeid;
 
@@ -41,22 +44,29 @@ class GtpcTun
                                */
 };
 
+#define GSIM_GTPU_INV_INDX    0xFFFFFFFF
+
 class GtpuTun
 {
    private:
       GtpTeid_t   m_locTeid;
       GtpTeid_t   m_remTeid;
+      U32         m_genIndx;   /* index in GTP-U generator bearer table */
 
    public:
       GtpuTun();
+      ~GtpuTun();
+
+      static VOID *operator new(size_t len);
+      static VOID operator delete(VOID *p);
+
       GtpTeid_t   localTeid() {return m_locTeid;}
       GtpTeid_t   remoteTeid() {return m_remTeid;}
+      VOID        setRemoteTeid(GtpTeid_t teid) {m_remTeid = teid;}
+      U32         genIndx() {return m_genIndx;}
+      VOID        setGenIndx(U32 indx) {m_genIndx = indx;}
 };
 
-typedef std::map<GtpTeid_t, GtpcTun*>  TunMap;
-typedef std::pair<GtpTeid_t,GtpcTun*>  TunMapPair;
-typedef TunMap::iterator               TunMapItr;
-
 EXTERN VOID       deleteCTun(GtpcTun *pTun);
 EXTERN GtpcTun*   findCTun(GtpTeid_t teid);
 PUBLIC GtpcTun*   createCTun(GtpcPdn *pPdn);
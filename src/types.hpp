@@ -135,6 +135,38 @@ struct UdpData_t
    Buffer         buf;
    TransConnId    connId;
    IPEndPoint     peerEp; 
+   Time_t         tstamp;     /* micro-seconds, time the message was
+                               * received or sent, 0 if not known
+                               */
+
+   UdpData_t() {tstamp = 0;}
+};
+
+/* message of a batched send, the header is followed by the data. Neither
+ * is copied, so the data may be shared by all the messages of a batch.
+ * With segLen set the message is a train of UDP datagrams of segLen bytes
+ * segmented by the kernel (GSO), the last one may be shorter
+ */
+struct SendVec_t
+{
+   U8             *pHdr;
+   U32            hdrLen;
+   U8             *pData;
+   U32            dataLen;
+   U32            segLen;
+};
+
+/* message of a batched receive, only bufLen bytes of the message are
+ * read into the buffer, len is the actual length of the message. segLen
+ * is set if the kernel coalesced datagrams of segLen bytes (GRO)
+ */
+struct RecvVec_t
+{
+   U8             *pBuf;
+   U32            bufLen;
+   U32            len;
+   U32            segLen;
+   Time_t         tstamp;     /* kernel receive time, 0 if not known */
 };
 
 #define BUFFER_CPY(_buf, _src, _sz)                         \
@@ -0,0 +1,383 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "types.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "error.hpp"
+#include "mem.hpp"
+#include "uring.hpp"
+
+/* the system call numbers are the same on all architectures */
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup      425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter      426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register   427
+#endif
+
+IoUring::IoUring()
+{
+    m_fd         = -1;
+    m_pSqRing    = NULL;
+    m_sqRingLen  = 0;
+    m_pSqHead    = NULL;
+    m_pSqTail    = NULL;
+    m_sqMask     = 0;
+    m_sqEntries  = 0;
+    m_sqeTail    = 0;
+    m_sqeHead    = 0;
+    m_pSqes      = NULL;
+    m_sqesLen    = 0;
+    m_pCqRing    = NULL;
+    m_cqRingLen  = 0;
+    m_pCqHead    = NULL;
+    m_pCqTail    = NULL;
+    m_cqMask     = 0;
+    m_pCqes      = NULL;
+    m_pBufRing   = NULL;
+    m_bufRingLen = 0;
+    m_pBufs      = NULL;
+    m_bufCnt     = 0;
+    m_bufLen     = 0;
+    m_bufTail    = 0;
+}
+
+IoUring::~IoUring()
+{
+    if (NULL != m_pBufRing)
+    {
+        munmap(m_pBufRing, m_bufRingLen);
+    }
+
+    if (NULL != m_pSqes)
+    {
+        munmap(m_pSqes, m_sqesLen);
+    }
+
+    if (NULL != m_pCqRing && m_pCqRing != m_pSqRing)
+    {
+        munmap(m_pCqRing, m_cqRingLen);
+    }
+
+    if (NULL != m_pSqRing)
+    {
+        munmap(m_pSqRing, m_sqRingLen);
+    }
+
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+/**
+ * @brief
+ *    Creates the ring and maps the submission and completion queues. The
+ *    completion wait with a timeout (kernel 5.11) is required
+ *
+ * @param entries
+ *    submission queue entries, power of 2
+ * @param cqEntries
+ *    completion queue entries, power of 2
+ *
+ * @return
+ */
+RETVAL IoUring::init(U32 entries, U32 cqEntries)
+{
+    LOG_ENTERFN();
+
+    struct io_uring_params params;
+    MEMSET(&params, 0, sizeof(params));
+    params.flags      = IORING_SETUP_CQSIZE;
+    params.cq_entries = cqEntries;
+
+    m_fd = (S32)syscall(__NR_io_uring_setup, entries, &params);
+    if (m_fd < 0)
+    {
+        LOG_ERROR("io_uring_setup() failed, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCKET_CREATE);
+    }
+
+    if (!GSIM_CHK_MASK(params.features, IORING_FEAT_EXT_ARG))
+    {
+        LOG_ERROR("io_uring timed wait not supported by the kernel");
+        LOG_EXITFN(ERR_SYS_SOCKET_CREATE);
+    }
+
+    m_sqRingLen = params.sq_off.array + params.sq_entries * sizeof(U32);
+    m_cqRingLen = params.cq_off.cqes +
+        params.cq_entries * sizeof(struct io_uring_cqe);
+
+    /* both the queues are in one mapping since kernel 5.4 */
+    if (GSIM_CHK_MASK(params.features, IORING_FEAT_SINGLE_MMAP))
+    {
+        if (m_cqRingLen > m_sqRingLen)
+        {
+            m_sqRingLen = m_cqRingLen;
+        }
+        m_cqRingLen = m_sqRingLen;
+    }
+
+    m_pSqRing = (U8 *)mmap(NULL, m_sqRingLen, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == m_pSqRing)
+    {
+        m_pSqRing = NULL;
+        LOG_ERROR("mmap of submission queue, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    if (GSIM_CHK_MASK(params.features, IORING_FEAT_SINGLE_MMAP))
+    {
+        m_pCqRing = m_pSqRing;
+    }
+    else
+    {
+        m_pCqRing = (U8 *)mmap(NULL, m_cqRingLen, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == m_pCqRing)
+        {
+            m_pCqRing = NULL;
+            LOG_ERROR("mmap of completion queue, [%s]", strerror(errno));
+            LOG_EXITFN(ERR_MEMORY_ALLOC);
+        }
+    }
+
+    m_sqesLen = params.sq_entries * sizeof(struct io_uring_sqe);
+    m_pSqes   = (struct io_uring_sqe *)mmap(NULL, m_sqesLen,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+        IORING_OFF_SQES);
+    if (MAP_FAILED == m_pSqes)
+    {
+        m_pSqes = NULL;
+        LOG_ERROR("mmap of submission queue entries, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    m_pSqHead   = (U32 *)(m_pSqRing + params.sq_off.head);
+    m_pSqTail   = (U32 *)(m_pSqRing + params.sq_off.tail);
+    m_sqMask    = *(U32 *)(m_pSqRing + params.sq_off.ring_mask);
+    m_sqEntries = params.sq_entries;
+    m_pCqHead   = (U32 *)(m_pCqRing + params.cq_off.head);
+    m_pCqTail   = (U32 *)(m_pCqRing + params.cq_off.tail);
+    m_cqMask    = *(U32 *)(m_pCqRing + params.cq_off.ring_mask);
+    m_pCqes     = (struct io_uring_cqe *)(m_pCqRing + params.cq_off.cqes);
+
+    /* entry i of the submission queue is always sqe i */
+    U32 *pSqArray = (U32 *)(m_pSqRing + params.sq_off.array);
+    for (U32 i = 0; i < m_sqEntries; i++)
+    {
+        pSqArray[i] = i;
+    }
+
+    m_sqeTail = *m_pSqTail;
+    m_sqeHead = m_sqeTail;
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Registers a ring of receive buffers (kernel 5.19), all the buffers
+ *    are handed to the kernel
+ *
+ * @param bgid
+ *    buffer group, given in the receive sqe
+ * @param bufCnt
+ *    power of 2, not more than 32768
+ * @param bufLen
+ *
+ * @return
+ */
+RETVAL IoUring::initBufRing(U16 bgid, U32 bufCnt, U32 bufLen)
+{
+    LOG_ENTERFN();
+
+    m_bufRingLen = bufCnt * sizeof(struct io_uring_buf);
+    m_pBufRing   = (struct io_uring_buf *)mmap(NULL, m_bufRingLen,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == m_pBufRing)
+    {
+        m_pBufRing = NULL;
+        LOG_ERROR("mmap of buffer ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    /* receive buffers are kept in the memory arena until exit */
+    m_pBufs = (U8 *)memAlloc(memRegister("uring-rx-bufs"),
+        (U64)bufCnt * bufLen);
+    if (NULL == m_pBufs)
+    {
+        LOG_ERROR("Memory allocation failure, receive buffers");
+        LOG_EXITFN(ERR_MEMORY_ALLOC);
+    }
+
+    m_bufCnt = bufCnt;
+    m_bufLen = bufLen;
+
+    struct io_uring_buf_reg reg;
+    MEMSET(&reg, 0, sizeof(reg));
+    reg.ring_addr    = (U64)(unsigned long)m_pBufRing;
+    reg.ring_entries = bufCnt;
+    reg.bgid         = bgid;
+
+    if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING,
+            &reg, 1) < 0)
+    {
+        LOG_ERROR("Registering buffer ring, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_CNTRL);
+    }
+
+    for (U32 i = 0; i < bufCnt; i++)
+    {
+        recycleBuf((U16)i);
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Returns a cleared submission queue entry, it is submitted with the
+ *    next submit()
+ *
+ * @return
+ *    NULL if the submission queue is full
+ */
+struct io_uring_sqe *IoUring::getSqe()
+{
+    U32 head = __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+    if (m_sqeTail - head >= m_sqEntries)
+    {
+        return NULL;
+    }
+
+    struct io_uring_sqe *pSqe = &m_pSqes[m_sqeTail & m_sqMask];
+    MEMSET(pSqe, 0, sizeof(struct io_uring_sqe));
+    m_sqeTail++;
+
+    return pSqe;
+}
+
+/**
+ * @brief
+ *    Submits the filled entries and waits for the completions with a
+ *    single system call
+ *
+ * @param waitNr
+ *    completions to wait for, 0 to return immediately
+ * @param waitMs
+ *    maximum wait
+ *
+ * @return
+ *    number of entries submitted, or -1
+ */
+S32 IoUring::submit(U32 waitNr, S32 waitMs)
+{
+    U32 toSubmit = m_sqeTail - m_sqeHead;
+    U32 flags    = 0;
+
+    __atomic_store_n(m_pSqTail, m_sqeTail, __ATOMIC_RELEASE);
+
+    struct __kernel_timespec       ts;
+    struct io_uring_getevents_arg  arg;
+    MEMSET(&arg, 0, sizeof(arg));
+    if (0 != waitNr)
+    {
+        ts.tv_sec  = waitMs / 1000;
+        ts.tv_nsec = (waitMs % 1000) * 1000000LL;
+        arg.ts     = (U64)(unsigned long)&ts;
+        flags      = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    }
+    else if (0 == toSubmit)
+    {
+        return 0;
+    }
+
+    S32 ret = (S32)syscall(__NR_io_uring_enter, m_fd, toSubmit, waitNr,
+        flags, &arg, sizeof(arg));
+    if (ret > 0)
+    {
+        m_sqeHead += ret;
+    }
+    else if (ret < 0 && ETIME != errno && EINTR != errno)
+    {
+        LOG_ERROR("io_uring_enter() failed, [%s]", strerror(errno));
+    }
+
+    return ret;
+}
+
+/**
+ * @brief
+ *    Returns the oldest completion, it stays in the completion queue
+ *    until cqeSeen()
+ *
+ * @return
+ *    NULL if there is no completion
+ */
+struct io_uring_cqe *IoUring::peekCqe()
+{
+    U32 head = *m_pCqHead;
+    if (head == __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+
+    return &m_pCqes[head & m_cqMask];
+}
+
+VOID IoUring::cqeSeen()
+{
+    __atomic_store_n(m_pCqHead, *m_pCqHead + 1, __ATOMIC_RELEASE);
+}
+
+U8 *IoUring::getBuf(U16 bid)
+{
+    return m_pBufs + (size_t)bid * m_bufLen;
+}
+
+/**
+ * @brief
+ *    Hands a receive buffer back to the kernel
+ *
+ * @param bid
+ */
+VOID IoUring::recycleBuf(U16 bid)
+{
+    struct io_uring_buf *pBuf = &m_pBufRing[m_bufTail & (m_bufCnt - 1)];
+
+    pBuf->addr = (U64)(unsigned long)getBuf(bid);
+    pBuf->len  = m_bufLen;
+    pBuf->bid  = bid;
+    m_bufTail++;
+
+    /* the ring tail is the reserved field of the first entry */
+    __atomic_store_n(&m_pBufRing[0].resv, m_bufTail, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,96 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __URING_HPP__
+#define __URING_HPP__
+
+#define GSIM_URING_ENTRIES          1024  /* submission queue entries */
+#define GSIM_URING_CQ_ENTRIES       8192  /* multishot gives many cqes */
+#define GSIM_URING_BUF_GROUP        1
+#define GSIM_URING_BUF_CNT          1024  /* provided receive buffers */
+#define GSIM_URING_BUF_LEN          4096
+#define GSIM_URING_SEND_SLOTS       1024  /* sends in flight */
+
+/* operation of a completion, in the upper half of the user data. The
+ * lower half is the socket index or the send slot index
+ */
+#define GSIM_URING_OP_RECV          1
+#define GSIM_URING_OP_SEND          2
+#define GSIM_URING_OP_POLL          3
+
+#define GSIM_URING_UDATA(_op, _indx)   (((U64)(_op) << 32) | (U32)(_indx))
+#define GSIM_URING_UDATA_OP(_udata)    ((U32)((_udata) >> 32))
+#define GSIM_URING_UDATA_INDX(_udata)  ((U32)(_udata))
+
+/* Minimal io_uring on the raw system calls. The submission queue entries
+ * are filled by the caller and submitted together with a single
+ * io_uring_enter(), which also waits for the completions. Receive buffers
+ * are provided to the kernel through a buffer ring, so a multishot
+ * receive picks a buffer for every datagram
+ */
+class IoUring
+{
+   public:
+      IoUring();
+      ~IoUring();
+
+      RETVAL            init(U32 entries, U32 cqEntries);
+      RETVAL            initBufRing(U16 bgid, U32 bufCnt, U32 bufLen);
+
+      struct io_uring_sqe* getSqe();
+      S32               submit(U32 waitNr, S32 waitMs);
+      U32               pending() { return m_sqeTail - m_sqeHead; }
+      struct io_uring_cqe* peekCqe();
+      VOID              cqeSeen();
+
+      U8*               getBuf(U16 bid);
+      VOID              recycleBuf(U16 bid);
+      U32               bufLen() { return m_bufLen; }
+
+   private:
+      S32               m_fd;
+
+      U8                *m_pSqRing;
+      size_t            m_sqRingLen;
+      U32               *m_pSqHead;
+      U32               *m_pSqTail;
+      U32               m_sqMask;
+      U32               m_sqEntries;
+      U32               m_sqeTail;      /* next sqe to fill */
+      U32               m_sqeHead;      /* next sqe to submit */
+      struct io_uring_sqe *m_pSqes;
+      size_t            m_sqesLen;
+
+      U8                *m_pCqRing;
+      size_t            m_cqRingLen;
+      U32               *m_pCqHead;
+      U32               *m_pCqTail;
+      U32               m_cqMask;
+      struct io_uring_cqe *m_pCqes;
+
+      /* entries of struct io_uring_buf_ring, its flexible array is not
+       * at offset 0 when compiled as C++
+       */
+      struct io_uring_buf *m_pBufRing;
+      size_t            m_bufRingLen;
+      U8                *m_pBufs;
+      U32               m_bufCnt;
+      U32               m_bufLen;
+      U16               m_bufTail;
+};
+
+#endif
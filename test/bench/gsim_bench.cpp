@@ -0,0 +1,505 @@
+#include <arpa/inet.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <list>
+#include <vector>
+using std::vector;
+#include <map>
+#include <deque>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include "benchmark/benchmark.h"
+
+#include "pugixml.hpp"
+using namespace pugi;
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_macro.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+#include "transport.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "sim_cfg.hpp"
+#include "procedure.hpp"
+#include "scenario.hpp"
+#include "socket.hpp"
+#include "xml_parser.hpp"
+#include "tunnel.hpp"
+#include "gtp_peer.hpp"
+#include "session.hpp"
+#include "traffic.hpp"
+
+#define GSIM_BENCH_NUM_SCN       5
+#define GSIM_BENCH_MIN_ENTRIES   1000
+#define GSIM_BENCH_IMSI          "001010123456789"
+
+static const S8 *s_scnFiles[GSIM_BENCH_NUM_SCN] =
+{
+   "mme_s11.xml",
+   "sgw_s11.xml",
+   "sgw_s5.xml",
+   "pgw_s5.xml",
+   "ggsn_s8.xml"
+};
+
+typedef struct
+{
+   GtpIeType_t    type;
+   GtpInstance_t  instance;
+} BenchIe;
+
+/* messages of each shipped scenario, and their encoded buffers */
+static std::vector<GtpMsg *>  s_scnMsgs[GSIM_BENCH_NUM_SCN];
+static std::vector<Buffer *>  s_scnBufs[GSIM_BENCH_NUM_SCN];
+static std::vector<BenchIe>   s_scnIes;
+
+class BenchTask: public Task
+{
+   public:
+      BenchTask() { m_wake = 0; }
+
+      RETVAL run(VOID *arg = NULL) { return ROK; }
+      Time_t wake() { return m_wake; }
+      VOID   sleep(Time_t wake) { m_wake = wake; pause(); }
+
+   private:
+      Time_t m_wake;
+};
+
+static VOID loadScenarios()
+{
+   GtpMsgHdr msgHdr;
+   msgHdr.teid = 0x1000;
+   msgHdr.seqN = 1;
+   GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_TEID_PRES);
+   GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_SEQ_PRES);
+
+   for (U32 scn = 0; scn < GSIM_BENCH_NUM_SCN; scn++)
+   {
+      std::string file = std::string(GSIM_BENCH_SCN_DIR) + "/" + \
+         s_scnFiles[scn];
+      JobSequence jobSeq;
+      parseXmlScenario(file.c_str(), &jobSeq);
+
+      for (U32 i = 0; i < jobSeq.size(); i++)
+      {
+         GtpMsg *pMsg = jobSeq[i]->getGtpMsg();
+         if (NULL == pMsg)
+         {
+            continue;
+         }
+
+         pMsg->setMsgHdr(&msgHdr);
+
+         U8  buf[GTP_MSG_BUF_LEN];
+         U32 len = 0;
+         pMsg->encode(buf, &len);
+
+         Buffer *pBuf = new Buffer;
+         BUFFER_CPY(pBuf, buf, len);
+         s_scnMsgs[scn].push_back(pMsg);
+         s_scnBufs[scn].push_back(pBuf);
+
+         /* top level IEs, for the IE creation benchmark */
+         U8 *pIe  = pBuf->pVal + GTP_MSG_HDR_LEN;
+         U8 *pEnd = pBuf->pVal + pBuf->len;
+         while (pIe < pEnd)
+         {
+            BenchIe     ie;
+            GtpLength_t ieLen = 0;
+            GTP_GET_IE_TYPE(pIe, ie.type);
+            GTP_GET_IE_INSTANCE(pIe, ie.instance);
+            GTP_DEC_IE_LEN(pIe, ieLen);
+            s_scnIes.push_back(ie);
+            pIe += GTP_IE_HDR_LEN + ieLen;
+         }
+      }
+   }
+}
+
+static VOID BM_GtpMsgEncode(benchmark::State &state)
+{
+   std::vector<GtpMsg *> &msgs = s_scnMsgs[state.range(0)];
+   U8  buf[GTP_MSG_BUF_LEN];
+   U32 len = 0;
+
+   for (auto _ : state)
+   {
+      for (U32 i = 0; i < msgs.size(); i++)
+      {
+         msgs[i]->encode(buf, &len);
+         benchmark::DoNotOptimize(buf);
+      }
+   }
+
+   state.SetItemsProcessed(state.iterations() * msgs.size());
+   state.SetLabel(s_scnFiles[state.range(0)]);
+}
+BENCHMARK(BM_GtpMsgEncode)->DenseRange(0, GSIM_BENCH_NUM_SCN - 1);
+
+static VOID BM_GtpMsgDecode(benchmark::State &state)
+{
+   std::vector<Buffer *> &bufs = s_scnBufs[state.range(0)];
+
+   for (auto _ : state)
+   {
+      for (U32 i = 0; i < bufs.size(); i++)
+      {
+         GtpMsg msg(bufs[i]);
+         msg.decode();
+         benchmark::DoNotOptimize(msg.category());
+      }
+   }
+
+   state.SetItemsProcessed(state.iterations() * bufs.size());
+   state.SetLabel(s_scnFiles[state.range(0)]);
+}
+BENCHMARK(BM_GtpMsgDecode)->DenseRange(0, GSIM_BENCH_NUM_SCN - 1);
+
+static VOID BM_CreateGtpIe(benchmark::State &state)
+{
+   for (auto _ : state)
+   {
+      for (U32 i = 0; i < s_scnIes.size(); i++)
+      {
+         GtpIe *pIe = GtpIe::createGtpIe(s_scnIes[i].type,
+               s_scnIes[i].instance);
+         benchmark::DoNotOptimize(pIe);
+         delete pIe;
+      }
+   }
+
+   state.SetItemsProcessed(state.iterations() * s_scnIes.size());
+}
+BENCHMARK(BM_CreateGtpIe);
+
+/* The tables are resized to the entry count of each run, the entries
+ * are kept across the runs of the same size
+ */
+static std::vector<GtpcTun *>    s_tuns;
+static std::vector<UeSession *>  s_sessions;
+static S8                        s_imsiStr[] = GSIM_BENCH_IMSI;
+
+static VOID resizeTuns(U32 n)
+{
+   while (s_tuns.size() < n)
+   {
+      s_tuns.push_back(new GtpcTun());
+   }
+
+   while (s_tuns.size() > n)
+   {
+      deleteCTun(s_tuns.back());
+      s_tuns.pop_back();
+   }
+}
+
+static VOID resizeSessions(U32 n)
+{
+   while (s_sessions.size() < n)
+   {
+      GtpImsiKey imsiKey;
+      MEMSET(&imsiKey, 0, sizeof(imsiKey));
+      numericStrIncriment(s_imsiStr, STRLEN(s_imsiStr));
+      imsiKey.len = encodeImsi(s_imsiStr, STRLEN(s_imsiStr), imsiKey.val);
+      s_sessions.push_back(UeSession::createUeSession(imsiKey));
+   }
+
+   while (s_sessions.size() > n)
+   {
+      s_sessions.back()->abort();
+      s_sessions.pop_back();
+   }
+}
+
+static VOID BM_FindCTun(benchmark::State &state)
+{
+   U32 n = state.range(0);
+   resizeTuns(n);
+
+   /* random order, as the TEIDs of received messages */
+   std::vector<GtpTeid_t> keys(n);
+   for (U32 i = 0; i < n; i++)
+   {
+      keys[i] = s_tuns[i]->m_locTeid;
+   }
+   std::shuffle(keys.begin(), keys.end(), std::mt19937(n));
+
+   U32 i = 0;
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(findCTun(keys[i]));
+      i = (i + 1 == n) ? 0 : i + 1;
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindCTun)->RangeMultiplier(10)->Range(GSIM_BENCH_MIN_ENTRIES,
+      GSIM_BENCH_MAX_ENTRIES);
+
+static VOID BM_GetUeSession(benchmark::State &state)
+{
+   U32 n = state.range(0);
+   resizeSessions(n);
+
+   std::vector<GtpImsiKey> keys(n);
+   for (U32 i = 0; i < n; i++)
+   {
+      keys[i] = *s_sessions[i]->imsiKey();
+   }
+   std::shuffle(keys.begin(), keys.end(), std::mt19937(n));
+
+   U32 i = 0;
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(UeSession::getUeSession(keys[i]));
+      i = (i + 1 == n) ? 0 : i + 1;
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetUeSession)->RangeMultiplier(10)->Range(GSIM_BENCH_MIN_ENTRIES,
+      GSIM_BENCH_MAX_ENTRIES);
+
+/* memory of the arena and of the heap in use */
+static U64 memFootprint()
+{
+   U64 bytes = mallinfo2().uordblks;
+   for (U32 i = 0; i < memNumUsers(); i++)
+   {
+      MemUser_t *pUser = memGetUser(i);
+      for (U32 page = 0; page < MEM_PAGE_MAX; page++)
+      {
+         bytes += pUser->bytes[page];
+      }
+   }
+
+   return bytes;
+}
+
+/* memory taken by a session with a PDN, the sessions are added above the
+ * most sessions created so far so the pools do not have free objects to
+ * hand out
+ */
+static VOID BM_UeSessionFootprint(benchmark::State &state)
+{
+   static U32 s_sessionsHigh = 0;
+
+   U32 n = state.range(0);
+   resizeSessions(s_sessionsHigh);
+
+   U64 bytes = 0;
+   for (auto _ : state)
+   {
+      U64 before = memFootprint();
+      U32 first  = s_sessions.size();
+      resizeSessions(first + n);
+      for (U32 i = first; i < s_sessions.size(); i++)
+      {
+         s_sessions[i]->createPdn();
+      }
+      bytes = memFootprint() - before;
+   }
+
+   s_sessionsHigh = s_sessions.size();
+   state.counters["bytes_per_session"] = (double)bytes / n;
+   state.counters["sizeof_session"]    = sizeof(UeSession);
+   state.counters["sizeof_ctx"]        = sizeof(UeSessionCtx);
+}
+BENCHMARK(BM_UeSessionFootprint)->Arg(1 << 17)->Iterations(1);
+
+/* pause and resume of a task with the given number of tasks paused in
+ * the wheel, spread over a minute
+ */
+static VOID BM_TimeWheelAddRemove(benchmark::State &state)
+{
+   U32    n   = state.range(0);
+   Time_t now = getMilliSeconds();
+   std::vector<BenchTask *> tasks(n);
+
+   for (U32 i = 0; i < n; i++)
+   {
+      tasks[i] = new BenchTask;
+      tasks[i]->sleep(now + 1 + (i % 60000));
+   }
+
+   BenchTask *pTask = new BenchTask;
+   U32 i = 0;
+   for (auto _ : state)
+   {
+      pTask->sleep(now + 1 + (i++ % 60000));
+      pTask->resumeTask();
+   }
+
+   state.SetItemsProcessed(state.iterations());
+
+   pTask->abort();
+   for (U32 j = 0; j < n; j++)
+   {
+      tasks[j]->abort();
+   }
+}
+BENCHMARK(BM_TimeWheelAddRemove)->RangeMultiplier(10)->Range(
+      GSIM_BENCH_MIN_ENTRIES, 1000000);
+
+/* tasks expiring in the same millisecond, moved to the run queue */
+static VOID BM_TimeWheelResume(benchmark::State &state)
+{
+   U32 n = state.range(0);
+   std::vector<BenchTask *> tasks(n);
+
+   for (U32 i = 0; i < n; i++)
+   {
+      tasks[i] = new BenchTask;
+   }
+
+   for (auto _ : state)
+   {
+      state.PauseTiming();
+      Time_t wake = getMilliSeconds() + 1;
+      for (U32 i = 0; i < n; i++)
+      {
+         tasks[i]->sleep(wake);
+      }
+
+      while (getMilliSeconds() <= wake)
+      {
+         usleep(100);
+      }
+      state.ResumeTiming();
+
+      TaskMgr::resumePausedTasks();
+   }
+
+   state.SetItemsProcessed(state.iterations() * n);
+
+   for (U32 i = 0; i < n; i++)
+   {
+      tasks[i]->abort();
+   }
+}
+BENCHMARK(BM_TimeWheelResume)->RangeMultiplier(10)->Range(
+      GSIM_BENCH_MIN_ENTRIES, 100000);
+
+static VOID BM_EncodeImsi(benchmark::State &state)
+{
+   S8  imsiStr[] = GSIM_BENCH_IMSI;
+   U8  buf[GTP_IMSI_MAX_BUF_LEN];
+
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(encodeImsi(imsiStr, STRLEN(imsiStr), buf));
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeImsi);
+
+static VOID BM_NumericStrIncriment(benchmark::State &state)
+{
+   S8  imsiStr[] = GSIM_BENCH_IMSI;
+
+   for (auto _ : state)
+   {
+      numericStrIncriment(imsiStr, STRLEN(imsiStr));
+      benchmark::ClobberMemory();
+   }
+
+   state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NumericStrIncriment);
+
+/* IMSI of a new session, arg 0 in sequence and 1 in random order */
+static VOID BM_ImsiGenerator(benchmark::State &state)
+{
+   GtpImsiGenerator  imsiGen;
+   GtpImsiKey        imsiKey;
+
+   imsiGen.init(GSIM_BENCH_IMSI, 0, 1, 0, 1, (BOOL)state.range(0));
+   for (auto _ : state)
+   {
+      imsiGen.allocNew(&imsiKey);
+      benchmark::DoNotOptimize(imsiKey);
+   }
+
+   state.SetItemsProcessed(state.iterations());
+   state.SetLabel(state.range(0) ? "random" : "seq");
+}
+BENCHMARK(BM_ImsiGenerator)->Arg(0)->Arg(1);
+
+/* a create session request sent to the socket itself and received, as
+ * done for every GTP-C message by the poll transport
+ */
+static VOID BM_SendRecv(benchmark::State &state)
+{
+   IPEndPoint ep;
+   MEMSET(&ep, 0, sizeof(ep));
+   ep.ipAddr.ipAddrType      = IP_ADDR_TYPE_V4;
+   ep.ipAddr.u.ipv4Addr.addr = INADDR_LOOPBACK;
+
+   GSimSocket *pSock = new GSimSocket(SOCK_TYPE_GTPC, ep);
+   if (ROK != pSock->bindSocket())
+   {
+      state.SkipWithError("bind failed");
+      delete pSock;
+      return;
+   }
+
+   struct sockaddr_in addr;
+   socklen_t          addrLen = sizeof(addr);
+   getsockname(pSock->fd(), (struct sockaddr *)&addr, &addrLen);
+   ep.port = ntohs(addr.sin_port);
+
+   Buffer *pMsg = s_scnBufs[0][0];
+   for (auto _ : state)
+   {
+      UdpData_t *pData = NULL;
+      sendMsg(pSock->connId(), &ep, pMsg->pVal, pMsg->len);
+      if (ROK == pSock->recvMsg(&pData))
+      {
+         delete pData;
+      }
+   }
+
+   state.SetItemsProcessed(state.iterations());
+   state.SetBytesProcessed(state.iterations() * pMsg->len);
+}
+BENCHMARK(BM_SendRecv);
+
+int main(int argc, char **argv)
+{
+   Logger::m_logLevel = LOG_LVL_START;
+
+   initMemArena(Config::getInstance()->getHugePageSize());
+   TaskMgr::init();
+   getMilliSeconds();
+   TaskMgr::resumePausedTasks();
+
+   try
+   {
+      loadScenarios();
+      Scenario::getInstance()->init((std::string(GSIM_BENCH_SCN_DIR) + \
+               "/" + s_scnFiles[0]).c_str());
+   }
+   catch (ErrCodeEn &e)
+   {
+      fprintf(stderr, "Scenario parsing failed [%d]\n", e);
+      return 1;
+   }
+
+   benchmark::Initialize(&argc, argv);
+   benchmark::RunSpecifiedBenchmarks();
+   benchmark::Shutdown();
+
+   return 0;
+}
@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+#  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Loopback load benchmark of gsim against itself.
+
+For each interface the responding side (SGW on S11, PGW on S5) and the
+initiating side (MME on S11, SGW on S5) are started on 127.0.0.1 with the
+shipped scenarios. Each point of rate and session count is run until all
+sessions are completed or aborted, then both sides are stopped. The last
+statistics block of each side's display file and the CPU time of each
+process are collected into a JSON report. The achieved rate is the number
+of sessions completed per second, from the start of the initiating side
+until the last session completed, so it includes the latency of the last
+sessions.
+
+With --baseline the report is compared with a stored report, a point whose
+achieved rate, p99 latency or CPU per session is worse than the tolerance,
+or which has more errors than the baseline, is a regression and the exit
+status is 1.
+
+    loadbench.py --gsim build/gsim --out report.json
+    loadbench.py --gsim build/gsim --baseline report.json --points 2000:20000
+"""
+
+import argparse
+import json
+import os
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+SCN_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                       "..", "..", "scenario")
+
+# responding side first, it must be listening before the first request
+INTERFACES = {
+    "s11": [
+        {"role": "sgw", "node": "sgw", "iftype": "s11sgw",
+         "scenario": "sgw_s11.xml", "port": 42123},
+        {"role": "mme", "node": "mme", "iftype": "s11mme",
+         "scenario": "mme_s11.xml", "port": 42124},
+    ],
+    "s5": [
+        {"role": "pgw", "node": "pgw", "iftype": "s5s8pgw",
+         "scenario": "pgw_s5.xml", "port": 42125},
+        {"role": "sgw", "node": "sgw", "iftype": "s5s8sgw",
+         "scenario": "sgw_s5.xml", "port": 42126},
+    ],
+}
+
+DFLT_POINTS = "500:5000,2000:20000"
+DISP_TIMER_MS = 100
+START_WAIT_S = 0.5
+
+# error counters, any increase over the baseline is a regression
+ERROR_KEYS = ["aborted", "timeouts", "retrans", "unexpected", "kernel_rx_drops",
+              "tx_queue_drops"]
+
+
+def parse_block(path):
+    """
+    Parses the last complete statistics block of a display file. A block
+    starts with the Run-Time line, lines are "Name: Key:Value Key:Value".
+    """
+    try:
+        with open(path) as f:
+            lines = f.read().splitlines()
+    except OSError:
+        return None
+
+    starts = [i for i, l in enumerate(lines) if l.startswith("Run-Time:")]
+    if not starts:
+        return None
+
+    stats = {"sent": 0, "recv": 0, "retrans": 0, "timeouts": 0,
+             "unexpected": 0, "latency_us": {}}
+    for line in lines[starts[-1]:]:
+        fields = dict(re.findall(r"([\w-]+):(\S+)", line))
+        name = line.split(":", 1)[0]
+
+        if line.startswith("Run-Time:"):
+            stats["run_time_s"] = int(fields["Run-Time"])
+        elif line.startswith("Sessions:"):
+            stats["created"] = int(fields["Sessions"])
+            stats["completed"] = int(fields["Completed"])
+            stats["aborted"] = int(fields["Aborted"])
+        elif line.startswith("Sim-Drops:"):
+            stats["kernel_rx_drops"] = int(fields["Kernel-Rx"])
+            stats["tx_queue_drops"] = int(fields["Tx-Queue"])
+            stats["rx_buf_peak_pct"] = int(fields["Rx-Buf-Peak-Pct"])
+        elif line.startswith("Sched-Idle-Pct:"):
+            stats["sched_idle_pct"] = int(fields["Sched-Idle-Pct"])
+        elif name.endswith("-us") and "P99" in fields:
+            stats["latency_us"][name[:-3].lower()] = {
+                k.lower(): int(v) for k, v in fields.items()
+                if k in ("Count", "Min", "P50", "P90", "P99", "P999", "Max")}
+        elif "Sent" in fields:
+            stats["sent"] += int(fields["Sent"])
+            stats["retrans"] += int(fields["Retrans"])
+            stats["timeouts"] += int(fields["Timeout"])
+        elif "Recv" in fields:
+            stats["recv"] += int(fields["Recv"])
+            stats["unexpected"] += int(fields["Unexpected"])
+
+    return stats
+
+
+def start_side(args, side, peer, workdir, rate=None, num=None):
+    out = os.path.join(workdir, "%s.out" % side["role"])
+    cmd = [args.gsim,
+           "--node", side["node"], "--iftype", side["iftype"],
+           "--scenario", os.path.join(args.scenario_dir, side["scenario"]),
+           "--local-ip", "127.0.0.1", "--local-port", str(side["port"]),
+           "--disp-target", "2", "--disp-target-file", out,
+           "--disp-timer", str(DISP_TIMER_MS),
+           "--log-file", os.path.join(workdir, "%s.gsim.log" % side["role"])]
+    if rate is not None:
+        cmd += ["--remote-ip", "127.0.0.1", "--remote-port", str(peer["port"]),
+                "--session-rate", str(rate), "--num-sessions", str(num)]
+    cmd += args.gsim_args
+
+    log = open(os.path.join(workdir, "%s.log" % side["role"]), "w")
+    proc = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT,
+                            stdin=subprocess.DEVNULL)
+    return proc, out
+
+
+def reap_side(proc, wait):
+    """
+    Reaps a side with wait4(), not with Popen, so that the CPU time of the
+    process is known. Returns False if the side is still running.
+    """
+    if proc.returncode is None:
+        pid, status, ru = os.wait4(proc.pid, 0 if wait else os.WNOHANG)
+        if 0 == pid:
+            return False
+        proc.returncode = status
+        proc.cpu = ru.ru_utime + ru.ru_stime
+    return True
+
+
+def stop_side(proc):
+    """ stops a side and returns its user and system CPU seconds """
+    if not reap_side(proc, False):
+        proc.send_signal(signal.SIGTERM)
+        reap_side(proc, True)
+    return proc.cpu
+
+
+def run_point(args, ifname, rate, num):
+    rsp, init = INTERFACES[ifname]
+    workdir = tempfile.mkdtemp(prefix="gsim-loadbench-")
+
+    rspProc, rspOut = start_side(args, rsp, init, workdir)
+    time.sleep(START_WAIT_S)
+    start = time.monotonic()
+    initProc, initOut = start_side(args, init, rsp, workdir, rate, num)
+
+    # the sessions are paced over num/rate seconds, the remaining time
+    # covers the retransmission timeouts of the last sessions
+    deadline = start + float(num) / rate + args.grace
+    stats = None
+    exited = False
+    while time.monotonic() < deadline:
+        time.sleep(DISP_TIMER_MS / 1000.0)
+        if reap_side(initProc, False) or reap_side(rspProc, False):
+            print("gsim exited early, see logs in %s" % workdir,
+                  file=sys.stderr)
+            exited = True
+            break
+        stats = parse_block(initOut)
+        if stats and stats.get("completed", 0) + stats.get("aborted", 0) >= num:
+            break
+    elapsed = time.monotonic() - start
+
+    # one more display period, so both files have the final counters
+    time.sleep(2 * DISP_TIMER_MS / 1000.0)
+    initCpu = stop_side(initProc)
+    rspCpu = stop_side(rspProc)
+
+    initStats = parse_block(initOut) or {}
+    rspStats = parse_block(rspOut) or {}
+    completed = initStats.get("completed", 0)
+    errors = {k: initStats.get(k, 0) + rspStats.get(k, 0) for k in ERROR_KEYS}
+    errors["incomplete"] = num - completed - initStats.get("aborted", 0)
+
+    latency = initStats.get("latency_us", {}).get("latency-observed", {})
+
+    point = {
+        "interface": ifname, "rate": rate, "num_sessions": num,
+        "elapsed_s": round(elapsed, 3),
+        "achieved_rate": round(completed / elapsed, 1),
+        "completed": completed,
+        "cpu_s": {init["role"]: round(initCpu, 3),
+                  rsp["role"]: round(rspCpu, 3)},
+        "cpu_us_per_session": round((initCpu + rspCpu) * 1e6 / completed, 1)
+                              if completed else None,
+        "p99_us": latency.get("p99"),
+        "errors": errors,
+        "gsim_exited": exited,
+        "sides": {init["role"]: initStats, rsp["role"]: rspStats},
+        "workdir": workdir,
+    }
+    return point
+
+
+def point_key(p):
+    return "%s/%d/%d" % (p["interface"], p["rate"], p["num_sessions"])
+
+
+def compare(report, baseline, tolerance):
+    """ returns the regressions of report against baseline """
+    base = {point_key(p): p for p in baseline["points"]}
+    tol = tolerance / 100.0
+    regressions = []
+
+    for p in report["points"]:
+        b = base.get(point_key(p))
+        if b is None:
+            continue
+
+        def worse(name, cur, ref, higher_is_better):
+            if cur is None or ref is None or ref == 0:
+                return
+            if higher_is_better and cur < ref * (1 - tol):
+                regressions.append("%s %s %s -> %s" % (point_key(p), name,
+                                                       ref, cur))
+            elif not higher_is_better and cur > ref * (1 + tol):
+                regressions.append("%s %s %s -> %s" % (point_key(p), name,
+                                                       ref, cur))
+
+        worse("achieved_rate", p["achieved_rate"], b["achieved_rate"], True)
+        worse("p99_us", p["p99_us"], b["p99_us"], False)
+        worse("cpu_us_per_session", p["cpu_us_per_session"],
+              b["cpu_us_per_session"], False)
+        for k in p["errors"]:
+            if p["errors"].get(k, 0) > b["errors"].get(k, 0):
+                regressions.append("%s %s %d -> %d" % (
+                    point_key(p), k, b["errors"].get(k, 0), p["errors"][k]))
+
+    return regressions
+
+
+def parse_points(s):
+    points = []
+    for item in s.split(","):
+        rate, num = item.split(":")
+        points.append((int(rate), int(num)))
+    return points
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Loopback load benchmark of gsim",
+        formatter_class=argparse.RawDescriptionHelpFormatter, epilog=__doc__)
+    parser.add_argument("--gsim", required=True, help="gsim binary")
+    parser.add_argument("--scenario-dir", default=os.path.normpath(SCN_DIR))
+    parser.add_argument("--interfaces", default="s11,s5",
+                        help="comma separated, of %s" % ",".join(INTERFACES))
+    parser.add_argument("--points", default=DFLT_POINTS,
+                        help="comma separated rate:num-sessions, default %s"
+                        % DFLT_POINTS)
+    parser.add_argument("--grace", type=float, default=10.0,
+                        help="seconds a point may run beyond num/rate")
+    parser.add_argument("--out", default="loadbench.json",
+                        help="JSON report file")
+    parser.add_argument("--baseline", help="stored report to compare with")
+    parser.add_argument("--tolerance", type=float, default=10.0,
+                        help="percent a metric may be worse than baseline")
+    parser.add_argument("gsim_args", nargs="*",
+                        help="extra gsim options for both sides, after --")
+    args = parser.parse_args()
+
+    report = {"gsim": os.path.abspath(args.gsim),
+              "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+              "gsim_args": args.gsim_args, "points": []}
+
+    for ifname in args.interfaces.split(","):
+        for rate, num in parse_points(args.points):
+            p = run_point(args, ifname, rate, num)
+            report["points"].append(p)
+            print("%-4s rate %6d sessions %8d: achieved %8.1f/s, p99 %s us, "
+                  "cpu %s us/session, errors %s" % (
+                      ifname, rate, num, p["achieved_rate"], p["p99_us"],
+                      p["cpu_us_per_session"],
+                      sum(p["errors"].values())))
+
+    with open(args.out, "w") as f:
+        json.dump(report, f, indent=2)
+    print("report written to %s" % args.out)
+
+    if any(p["gsim_exited"] for p in report["points"]):
+        return 1
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(report, baseline, args.tolerance)
+        for r in regressions:
+            print("REGRESSION %s" % r)
+        if regressions:
+            return 1
+        print("no regressions against %s" % args.baseline)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
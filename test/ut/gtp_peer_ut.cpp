@@ -0,0 +1,222 @@
+#include <limits.h>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "gtest/gtest.h"
+using std::vector;
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_types.hpp"
+#include "gtp_macro.hpp"
+#include "sim_cfg.hpp"
+#include "gtp_peer.hpp"
+
+class GtpPeerTest : public ::testing::Test
+{
+   protected:
+      virtual void SetUp()
+      {
+         /* the logger is not initialized */
+         Logger::m_logLevel = LOG_LVL_START;
+
+         MEMSET(&m_ep, 0, sizeof(m_ep));
+         m_ep.ipAddr.ipAddrType      = IP_ADDR_TYPE_V4;
+         m_ep.ipAddr.u.ipv4Addr.addr = 0x7F000001;
+         m_ep.port                   = 2123;
+      }
+
+      virtual void TearDown()
+      {
+         deletePeerTable();
+      }
+
+      IPEndPoint m_ep;
+};
+
+TEST(GtpSeqNumberTest, SerialArithmetic)
+{
+   EXPECT_TRUE(GTP_SEQN_LT(1, 2));
+   EXPECT_FALSE(GTP_SEQN_LT(2, 1));
+   EXPECT_FALSE(GTP_SEQN_LT(5, 5));
+   EXPECT_TRUE(GTP_SEQN_GT(2, 1));
+
+   /* across the wrap around of the 23 bit request space */
+   EXPECT_TRUE(GTP_SEQN_LT(0x7FFFFF, 0));
+   EXPECT_TRUE(GTP_SEQN_LT(0x7FFFF0, 0x10));
+   EXPECT_TRUE(GTP_SEQN_GT(0x10, 0x7FFFF0));
+
+   /* half the space apart */
+   EXPECT_TRUE(GTP_SEQN_LT(0, 0x3FFFFF));
+   EXPECT_FALSE(GTP_SEQN_LT(0, 0x400000));
+   EXPECT_TRUE(GTP_SEQN_LT(0x400001, 0));
+
+   /* the command MSB is not part of the comparison */
+   EXPECT_TRUE(GTP_SEQN_LT(0x7FFFFF, 0x800000));
+   EXPECT_FALSE(GTP_SEQN_LT(0x800005, 5));
+   EXPECT_TRUE(GTP_SEQN_GT(0x800006, 5));
+}
+
+TEST(GtpSeqNumberTest, Msb)
+{
+   GtpSeqNumber_t seqNumber = 0x123;
+   GTP_SET_SEQN_MSB(seqNumber);
+   EXPECT_EQ(0x800123U, seqNumber);
+}
+
+TEST_F(GtpPeerTest, GenerateSeqNum)
+{
+   PeerData *peer = addPeerData(m_ep);
+   EXPECT_EQ(peer, findPeer(&m_ep));
+   EXPECT_EQ(1U, generateSeqNum(peer, GTP_MSG_CAT_REQ));
+   EXPECT_EQ(0x800002U, generateSeqNum(peer, GTP_MSG_CAT_CMD));
+
+   /* requests wrap around in 23 bits */
+   peer->seqNumber = 0x7FFFFE;
+   EXPECT_EQ(0x7FFFFFU, generateSeqNum(peer, GTP_MSG_CAT_REQ));
+   EXPECT_EQ(0U, generateSeqNum(peer, GTP_MSG_CAT_REQ));
+   EXPECT_EQ(0x800001U, generateSeqNum(peer, GTP_MSG_CAT_CMD));
+}
+
+TEST_F(GtpPeerTest, Find)
+{
+   /* the same address with other ports and address types */
+   IPEndPoint ep = m_ep;
+   ep.port = 2124;
+   PeerData *peer = addPeerData(m_ep);
+   EXPECT_EQ(NULL, findPeer(&ep));
+   PeerData *other = addPeerData(ep);
+   EXPECT_NE(peer, other);
+   EXPECT_EQ(other, findPeer(&ep));
+   EXPECT_EQ(peer, addPeerData(m_ep));
+   EXPECT_STREQ("127.0.0.1:2123", peer->name);
+
+   ep = m_ep;
+   ep.ipAddr.ipAddrType = IP_ADDR_TYPE_V6;
+   MEMSET(ep.ipAddr.u.ipv6Addr.addr, 0, IPV6_ADDR_MAX_LEN);
+   ep.ipAddr.u.ipv6Addr.addr[15] = 1;
+   EXPECT_EQ(NULL, findPeer(&ep));
+   EXPECT_STREQ("[::1]:2123", addPeerData(ep)->name);
+   EXPECT_EQ(peer, findPeer(&m_ep));
+
+   /* many peers, the table grows */
+   for (U32 i = 0; i < 10000; i++)
+   {
+      ep = m_ep;
+      ep.ipAddr.u.ipv4Addr.addr = 0x0A000000 + i;
+      addPeerData(ep);
+   }
+
+   for (U32 i = 0; i < 10000; i++)
+   {
+      ep = m_ep;
+      ep.ipAddr.u.ipv4Addr.addr = 0x0A000000 + i;
+      PeerData *found = findPeer(&ep);
+      ASSERT_NE((PeerData *)NULL, found);
+      EXPECT_EQ(ep.ipAddr.u.ipv4Addr.addr, found->peerEp.ipAddr.u.ipv4Addr.addr);
+   }
+
+   EXPECT_EQ(peer, findPeer(&m_ep));
+}
+
+TEST_F(GtpPeerTest, Select)
+{
+   U8 imsi[] = {0x21, 0x43, 0x65, 0x87, 0x09, 0x21, 0x43, 0xF5};
+
+   Config::getInstance()->setRemotePeers("10.0.0.1-10.0.0.3/2123,10.0.1.1");
+   initRemotePeers();
+   ASSERT_EQ(4U, numRemotePeers());
+   EXPECT_STREQ("10.0.0.2:2123", getRemotePeer(1)->name);
+   for (U32 i = 0; i < 8; i++)
+   {
+      EXPECT_EQ(getRemotePeer(i % 4), selectRemotePeer(imsi, sizeof(imsi)));
+   }
+   deletePeerTable();
+
+   /* weighted, spread between the others */
+   Config::getInstance()->setRemotePeers("10.0.0.1*3,10.0.0.2");
+   Config::getInstance()->setPeerSelect("weighted");
+   PeerData *pHeavy = getRemotePeer(0);
+   std::vector<PeerData *> sched;
+   for (U32 i = 0; i < 8; i++)
+   {
+      sched.push_back(selectRemotePeer(imsi, sizeof(imsi)));
+   }
+   EXPECT_EQ(6, std::count(sched.begin(), sched.end(), pHeavy));
+   EXPECT_EQ(3, std::count(sched.begin(), sched.begin() + 4, pHeavy));
+   deletePeerTable();
+
+   /* an IMSI is always sent to the same peer */
+   Config::getInstance()->setRemotePeers("10.0.0.1-10.0.0.100");
+   Config::getInstance()->setPeerSelect("imsi-hash");
+   PeerData *pPeer = selectRemotePeer(imsi, sizeof(imsi));
+   U32 counts[100] = {0};
+   for (U32 i = 0; i < 10000; i++)
+   {
+      EXPECT_EQ(pPeer, selectRemotePeer(imsi, sizeof(imsi)));
+      U32 other = i;
+      counts[selectRemotePeer((U8 *)&other, sizeof(other))->indx]++;
+   }
+   for (U32 i = 0; i < 100; i++)
+   {
+      EXPECT_GT(counts[i], 50U);
+   }
+
+   EXPECT_THROW(Config::getInstance()->setRemotePeers(""), GsimError);
+   EXPECT_THROW(Config::getInstance()->setRemotePeers("10.0.0.2-10.0.0.1"),
+         GsimError);
+   EXPECT_THROW(Config::getInstance()->setPeerSelect("random"), GsimError);
+   Config::getInstance()->setPeerSelect("rr");
+}
+
+TEST_F(GtpPeerTest, Txn)
+{
+   U32        ssns[2];
+   UeSession *pFirst  = (UeSession *)&ssns[0];
+   UeSession *pSecond = (UeSession *)&ssns[1];
+   PeerData  *pPeer  = addPeerData(m_ep);
+
+   addPeerTxn(pPeer, 0x7FFFFF, pFirst);
+   addPeerTxn(pPeer, 0, pSecond);
+   EXPECT_EQ(pFirst, findPeerTxn(&m_ep, 0x7FFFFF));
+   EXPECT_EQ(pSecond, findPeerTxn(&m_ep, 0));
+   EXPECT_EQ(NULL, findPeerTxn(&m_ep, 1));
+
+   IPEndPoint ep = m_ep;
+   ep.port = 2124;
+   EXPECT_EQ(NULL, findPeerTxn(&ep, 0));
+
+   /* only the session of the transaction deletes it */
+   delPeerTxn(pPeer, 0, pFirst);
+   EXPECT_EQ(pSecond, findPeerTxn(&m_ep, 0));
+   delPeerTxn(pPeer, 0, pSecond);
+   EXPECT_EQ(NULL, findPeerTxn(&m_ep, 0));
+
+   /* a transaction left over before the wrap around is replaced */
+   addPeerTxn(pPeer, 0x7FFFFF, pSecond);
+   EXPECT_EQ(pSecond, findPeerTxn(&m_ep, 0x7FFFFF));
+}
+
+TEST(LocalEndpointsTest, Parse)
+{
+   Logger::m_logLevel = LOG_LVL_START;
+   Config *pCfg = Config::getInstance();
+
+   pCfg->setLocalEndpoints("10.1.0.1-10.1.0.3,10.2.0.1/40000-40001,::1/2124");
+   const std::vector<IPEndPoint> &eps = pCfg->getLocalEndpoints();
+   ASSERT_EQ(6U, eps.size());
+   EXPECT_EQ(0x0A010002U, eps[1].ipAddr.u.ipv4Addr.addr);
+   EXPECT_EQ(0, eps[2].port);
+   EXPECT_EQ(0x0A020001U, eps[4].ipAddr.u.ipv4Addr.addr);
+   EXPECT_EQ(40001, eps[4].port);
+   EXPECT_EQ(IP_ADDR_TYPE_V6, eps[5].ipAddr.ipAddrType);
+   EXPECT_EQ(2124, eps[5].port);
+
+   EXPECT_THROW(pCfg->setLocalEndpoints("10.1.0.1/40001-40000"), GsimError);
+   EXPECT_THROW(pCfg->setLocalEndpoints("10.1.0.1-10.1.3.255/1-1000"),
+         GsimError);
+   EXPECT_THROW(pCfg->setLocalEndpoints("::1-::2"), GsimError);
+}
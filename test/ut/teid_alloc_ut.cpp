@@ -0,0 +1,138 @@
+#include <limits.h>
+#include <vector>
+#include <set>
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "mem.hpp"
+#include "gtp_types.hpp"
+#include "sim_cfg.hpp"
+#include "teid_alloc.hpp"
+
+#define TEID_UT_NOW           1000000  /* milli seconds */
+#define TEID_UT_QUARANTINE    10       /* seconds */
+
+class TeidAllocatorTest : public ::testing::Test
+{
+   protected:
+      virtual void SetUp()
+      {
+         /* the logger is not initialized */
+         Logger::m_logLevel = LOG_LVL_START;
+      }
+};
+
+TEST_F(TeidAllocatorTest, Unique)
+{
+   TeidAllocator teids("ut-teid-unique");
+   teids.init(0, 1, TEID_UT_QUARANTINE);
+
+   U32 obj = 0;
+   std::set<GtpTeid_t> allocated;
+   for (U32 i = 0; i < 100000; i++)
+   {
+      GtpTeid_t teid = teids.alloc(&obj, TEID_UT_NOW);
+      EXPECT_NE((GtpTeid_t)GSIM_INV_TEID, teid);
+      EXPECT_TRUE(allocated.insert(teid).second);
+   }
+
+   EXPECT_EQ(100000U, teids.inUse());
+}
+
+TEST_F(TeidAllocatorTest, Shard)
+{
+   TeidAllocator teids("ut-teid-shard");
+   teids.init(5, 8, TEID_UT_QUARANTINE);
+
+   EXPECT_EQ(0xA0000001U, teids.firstTeid());
+   EXPECT_EQ(0xBFFFFFFEU, teids.lastTeid());
+
+   U32 obj = 0;
+   GtpTeid_t teid = teids.alloc(&obj, TEID_UT_NOW);
+   EXPECT_EQ(5U, teid >> 29);
+   EXPECT_EQ(&obj, teids.find(teid));
+
+   /* the same index in other shards */
+   EXPECT_EQ(NULL, teids.find(teid & 0x1FFFFFFF));
+   EXPECT_EQ(NULL, teids.find((teid & 0x1FFFFFFF) | 0xC0000000));
+   EXPECT_EQ(NULL, teids.find(teid + 1));
+   EXPECT_EQ(NULL, teids.find(0xA0000000));
+}
+
+TEST_F(TeidAllocatorTest, Quarantine)
+{
+   TeidAllocator teids("ut-teid-quarantine");
+   teids.init(0, 1, TEID_UT_QUARANTINE);
+
+   U32 obj = 0;
+   GtpTeid_t first  = teids.alloc(&obj, TEID_UT_NOW);
+   GtpTeid_t second = teids.alloc(&obj, TEID_UT_NOW);
+   teids.free(first, TEID_UT_NOW);
+   teids.free(second, TEID_UT_NOW + 1000);
+   EXPECT_EQ(NULL, teids.find(first));
+   EXPECT_EQ(0U, teids.inUse());
+
+   /* in quarantine, a new TEID is taken */
+   GtpTeid_t teid = teids.alloc(&obj, TEID_UT_NOW +
+         (TEID_UT_QUARANTINE * 1000) - 1);
+   EXPECT_NE(first, teid);
+   EXPECT_NE(second, teid);
+
+   /* reused in the order freed, after the quarantine */
+   EXPECT_EQ(first, teids.alloc(&obj, TEID_UT_NOW +
+            (TEID_UT_QUARANTINE * 1000)));
+   EXPECT_NE(second, teids.alloc(&obj, TEID_UT_NOW +
+            (TEID_UT_QUARANTINE * 1000)));
+   EXPECT_EQ(second, teids.alloc(&obj, TEID_UT_NOW +
+            ((TEID_UT_QUARANTINE + 1) * 1000)));
+   EXPECT_EQ(&obj, teids.find(first));
+}
+
+TEST_F(TeidAllocatorTest, Exhausted)
+{
+   TeidAllocator teids("ut-teid-exhausted");
+   teids.init(0, 65536, TEID_UT_QUARANTINE);
+
+   U32 obj = 0;
+   std::vector<GtpTeid_t> allocated;
+   for (U32 i = 1; i < 0xFFFF; i++)
+   {
+      allocated.push_back(teids.alloc(&obj, TEID_UT_NOW));
+      EXPECT_EQ(i, allocated.back());
+   }
+
+   EXPECT_EQ((GtpTeid_t)GSIM_INV_TEID, teids.alloc(&obj, TEID_UT_NOW));
+
+   /* freed TEIDs in quarantine are not taken */
+   teids.free(allocated[100], TEID_UT_NOW);
+   EXPECT_EQ((GtpTeid_t)GSIM_INV_TEID, teids.alloc(&obj, TEID_UT_NOW));
+   EXPECT_EQ(allocated[100], teids.alloc(&obj, TEID_UT_NOW +
+            (TEID_UT_QUARANTINE * 1000)));
+
+   /* freeing a TEID not in use is ignored */
+   teids.free(0x10000, TEID_UT_NOW);
+   teids.free(GSIM_INV_TEID, TEID_UT_NOW);
+   teids.free(allocated[200], TEID_UT_NOW);
+   teids.free(allocated[200], TEID_UT_NOW);
+   EXPECT_EQ(0xFFFDU, teids.inUse());
+}
+
+TEST_F(TeidAllocatorTest, DefaultQuarantine)
+{
+   Config *pCfg = Config::getInstance();
+
+   /* (n3-requests + 1) * t3-timer, t3-timer in milli seconds */
+   EXPECT_EQ((DFLT_N3_REQUESTS + 1) * DFLT_T3_TIMER / 1000,
+         pCfg->getTeidQuarantine());
+
+   /* rounded up to seconds */
+   pCfg->setT3TimerSeconds(1500);
+   pCfg->setN3Requests(2);
+   EXPECT_EQ(5U, pCfg->getTeidQuarantine());
+
+   pCfg->setTeidQuarantine(TEID_UT_QUARANTINE);
+   EXPECT_EQ((U32)TEID_UT_QUARANTINE, pCfg->getTeidQuarantine());
+}